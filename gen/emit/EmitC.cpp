@@ -13,6 +13,9 @@
 // flags for emit_c_array_loops_end
 #define FLAG_EMIT_FREES   2
 
+// flags for emit_c_array_loops_start
+#define FLAG_EMIT_ARENA_ALLOCS 4
+
 static string dotsToUnderscores(const string& s)
 {
     string ret = s;
@@ -66,6 +69,14 @@ static string mapTypeName(const string& t)
     return dotsToUnderscores(t);
 }
 
+static int primitiveSize(const string& t)
+{
+    if (t == "int8_t" || t == "byte" || t == "boolean") return 1;
+    if (t == "int16_t") return 2;
+    if (t == "int32_t" || t == "float") return 4;
+    return 8;
+}
+
 struct Emit : public Emitter
 {
     ZCMGen& zcm;
@@ -74,6 +85,42 @@ struct Emit : public Emitter
     Emit(ZCMGen& zcm, ZCMStruct& lr, const string& fname):
         Emitter(fname), zcm(zcm), lr(lr) {}
 
+    // A "POD-layout" type only has non-string primitive members with constant
+    // dimensions, so it always encodes to the same number of bytes and each member
+    // can be converted in bulk without any per-field bounds checks.
+    bool isPodLayout()
+    {
+        if (lr.members.size() == 0)
+            return false;
+        for (auto& lm : lr.members)
+            if (!ZCMGen::isPrimitiveType(lm.type.fullname) || lm.type.fullname == "string" ||
+                !lm.isConstantSizeArray())
+                return false;
+        return true;
+    }
+
+    static int constantCount(ZCMMember& lm)
+    {
+        int count = 1;
+        for (auto& dim : lm.dimensions)
+            count *= atoi(dim.size.c_str());
+        return count;
+    }
+
+    // Encoded size of a POD-layout type, not including the hash
+    int podEncodedSize()
+    {
+        int size = 0;
+        for (auto& lm : lr.members)
+            size += constantCount(lm) * primitiveSize(lm.type.fullname);
+        return size;
+    }
+
+    string encodedSizeMacro()
+    {
+        return StringUtil::toUpper(dotsToUnderscores(lr.structname.fullname)) + "_ENCODED_SIZE";
+    }
+
     void emitAutoGeneratedWarning()
     {
         emit(0, "// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY");
@@ -206,6 +253,14 @@ struct EmitHeader : public Emit
         }
         emit(0, "};");
         emit(0, "");
+
+        if (isPodLayout()) {
+            emit(0, "/**");
+            emit(0, " * Every %s encodes to exactly this many bytes (including the hash)", tn.c_str());
+            emit(0, " */");
+            emit(0, "#define %s %d", encodedSizeMacro().c_str(), 8 + podEncodedSize());
+            emit(0, "");
+        }
     }
 
     void emitHeaderPrototypes()
@@ -265,6 +320,18 @@ struct EmitHeader : public Emit
             emit(0,"%s_subscription_t* %s_subscribe(zcm_t *zcm, const char *channel, %s_handler_t handler, void *userdata);",
                  tn_, tn_, tn_);
             emit(0, "");
+            if (zcm.gopt->getBool("c-arena")) {
+                emit(0, "/**");
+                emit(0, " * Same as %s_subscribe(), except that every message is decoded with", tn_);
+                emit(0, " * %s_decode_arena() into @p arena, and the arena is reset as soon as", tn_);
+                emit(0, " * @p handler returns. Messages whose strings and variable-length arrays");
+                emit(0, " * do not fit in the arena are dropped. Passing a NULL @p arena is the same");
+                emit(0, " * as calling %s_subscribe().", tn_);
+                emit(0, " */");
+                emit(0,"%s_subscription_t* %s_subscribe_arena(zcm_t *zcm, const char *channel, %s_handler_t handler, void *userdata, zcm_arena_t *arena);",
+                     tn_, tn_, tn_);
+                emit(0, "");
+            }
             emit(0, "/**");
             emit(0, " * Removes and destroys a subscription created by %s_subscribe()", tn_);
             emit(0, " */");
@@ -319,6 +386,24 @@ struct EmitHeader : public Emit
         emit(0, " */");
         emit(0,"int %s_decode_cleanup(%s *p);", tn_, tn_);
         emit(0, "");
+        if (zcm.gopt->getBool("c-arena")) {
+            emit(0, "/**");
+            emit(0, " * Decode a message of type %s from binary form, allocating all strings", tn_);
+            emit(0, " * and variable-length arrays from @p arena instead of the heap. The decoded");
+            emit(0, " * message must not be passed to %s_decode_cleanup(): it remains valid", tn_);
+            emit(0, " * until the arena is reset.");
+            emit(0, " *");
+            emit(0, " * @param buf The buffer containing the encoded message");
+            emit(0, " * @param offset The byte offset into @p buf where the encoded message starts.");
+            emit(0, " * @param maxlen The maximum number of bytes to read while decoding.");
+            emit(0, " * @param msg Output parameter where the decoded message is stored");
+            emit(0, " * @param arena The arena to allocate from");
+            emit(0, " * @return The number of bytes decoded, or <0 if an error occured");
+            emit(0, " *         (including running out of arena space).");
+            emit(0, " */");
+            emit(0,"int %s_decode_arena(const void *buf, int offset, int maxlen, %s *msg, zcm_arena_t *arena);", tn_, tn_);
+            emit(0, "");
+        }
         emit(0, "/**");
         emit(0, " * Check how many bytes are required to encode a message of type %s", tn_);
         emit(0, " */");
@@ -337,6 +422,8 @@ struct EmitHeader : public Emit
         emit(0,"int     __%s_encode_array(void *buf, int offset, int maxlen, const %s *p, int elements);", tn_, tn_);
         emit(0,"int     __%s_decode_array(const void *buf, int offset, int maxlen, %s *p, int elements);", tn_, tn_);
         emit(0,"int     __%s_decode_array_cleanup(%s *p, int elements);", tn_, tn_);
+        if (zcm.gopt->getBool("c-arena"))
+            emit(0,"int     __%s_decode_array_arena(const void *buf, int offset, int maxlen, %s *p, int elements, zcm_arena_t *arena);", tn_, tn_);
         emit(0,"int     __%s_encoded_array_size(const %s *p, int elements);", tn_, tn_);
         emit(0,"int     __%s_clone_array(const %s *p, %s *q, int elements);", tn_, tn_, tn_);
         emit(0,"");
@@ -414,27 +501,37 @@ struct EmitSource : public Emit
         for (uint i = 0; i < lm.dimensions.size() - 1; i++) {
             char var = 'a' + i;
 
-            if (flags & FLAG_EMIT_MALLOCS) {
+            if (flags & (FLAG_EMIT_MALLOCS | FLAG_EMIT_ARENA_ALLOCS)) {
                 string stars = string(lm.dimensions.size()-1-i, '*');
-                emit(2+i, "%s = (%s%s*) zcm_malloc(sizeof(%s%s) * %s);",
-                     makeAccessor(lm, n, i).c_str(),
-                     mapTypeName(lm.type.fullname).c_str(),
-                     stars.c_str(),
-                     mapTypeName(lm.type.fullname).c_str(),
-                     stars.c_str(),
-                     makeArraySize(lm, n, i).c_str());
+                emitCAlloc(2+i, makeAccessor(lm, n, i),
+                           mapTypeName(lm.type.fullname) + stars,
+                           makeArraySize(lm, n, i), flags);
             }
 
             emit(2+i, "{ int %c;", var);
             emit(2+i, "for (%c = 0; %c < %s; %c++) {", var, var, makeArraySize(lm, "p", i).c_str(), var);
         }
 
-        if (flags & FLAG_EMIT_MALLOCS) {
-            emit(2 + (int)lm.dimensions.size() - 1, "%s = (%s*) zcm_malloc(sizeof(%s) * %s);",
-                 makeAccessor(lm, n, lm.dimensions.size() - 1).c_str(),
-                 mapTypeName(lm.type.fullname).c_str(),
-                 mapTypeName(lm.type.fullname).c_str(),
-                 makeArraySize(lm, n, lm.dimensions.size() - 1).c_str());
+        if (flags & (FLAG_EMIT_MALLOCS | FLAG_EMIT_ARENA_ALLOCS)) {
+            emitCAlloc(2 + (int)lm.dimensions.size() - 1,
+                       makeAccessor(lm, n, lm.dimensions.size() - 1),
+                       mapTypeName(lm.type.fullname),
+                       makeArraySize(lm, n, lm.dimensions.size() - 1), flags);
+        }
+    }
+
+    // Allocates storage for 'count' elements of 'type'. Arena allocations can
+    // fail, in which case the enclosing decode function fails too.
+    void emitCAlloc(int indent, const string& accessor, const string& type,
+                    const string& count, int flags)
+    {
+        if (flags & FLAG_EMIT_ARENA_ALLOCS) {
+            emit(indent, "%s = (%s*) zcm_arena_alloc(arena, sizeof(%s) * %s);",
+                 accessor.c_str(), type.c_str(), type.c_str(), count.c_str());
+            emit(indent, "if (!%s && %s > 0) return -1;", accessor.c_str(), count.c_str());
+        } else {
+            emit(indent, "%s = (%s*) zcm_malloc(sizeof(%s) * %s);",
+                 accessor.c_str(), type.c_str(), type.c_str(), count.c_str());
         }
     }
 
@@ -460,6 +557,61 @@ struct EmitSource : public Emit
         }
     }
 
+    // Emits the body of the encode/decode array functions for a POD-layout type:
+    // one bounds check up front, then a bulk conversion of each member. When the
+    // wire byte order matches the host's and the struct has no padding, the whole
+    // array is a single memcpy.
+    void emitCPodArrayBody(bool encode)
+    {
+        bool le = zcm.gopt->getBool("little-endian-encoding");
+        const char* order = le ? "le" : "be";
+        string tn = dotsToUnderscores(lr.structname.fullname);
+        string size = "(" + encodedSizeMacro() + " - 8)";
+
+        emit(1, "%suint8_t *data = (%suint8_t*) buf + offset;",
+                encode ? "" : "const ", encode ? "" : "const ");
+        emit(1, "int pos = 0, element;");
+        emit(0, "");
+        emit(1, "if (maxlen < elements * %s) return -1;", size.c_str());
+        emit(0, "");
+        emit(0, "#ifdef __ZCM_%s_ENDIAN_HOST", le ? "LITTLE" : "BIG");
+        emit(1, "if (sizeof(%s) == %s) {", tn.c_str(), size.c_str());
+        if (encode)
+            emit(2, "memcpy(data, p, elements * %s);", size.c_str());
+        else
+            emit(2, "memcpy(p, data, elements * %s);", size.c_str());
+        emit(2, "return elements * %s;", size.c_str());
+        emit(1, "}");
+        emit(0, "#endif");
+        emit(0, "");
+        emit(1, "for (element = 0; element < elements; element++) {");
+        for (auto& lm : lr.members) {
+            int count = constantCount(lm);
+            if (count == 0)
+                continue;
+            int width = primitiveSize(lm.type.fullname);
+            string field = "&p[element]." + lm.membername;
+            for (size_t i = 0; i < lm.dimensions.size(); i++)
+                field += "[0]";
+            if (width == 1) {
+                if (encode)
+                    emit(2, "memcpy(data + pos, %s, %d);", field.c_str(), count);
+                else
+                    emit(2, "memcpy(%s, data + pos, %d);", field.c_str(), count);
+            } else {
+                if (encode)
+                    emit(2, "__zcm_encode_%s(data + pos, %s, %d, %d);",
+                            order, field.c_str(), count, width);
+                else
+                    emit(2, "__zcm_decode_%s(%s, data + pos, %d, %d);",
+                            order, field.c_str(), count, width);
+            }
+            emit(2, "pos += %d;", count * width);
+        }
+        emit(1, "}");
+        emit(1, "return pos;");
+    }
+
     void emitCEncodeArray()
     {
         string tmp_ = dotsToUnderscores(lr.structname.fullname);
@@ -467,6 +619,12 @@ struct EmitSource : public Emit
 
         emit(0,"int __%s_encode_array(void *buf, int offset, int maxlen, const %s *p, int elements)", tn_, tn_);
         emit(0,"{");
+        if (isPodLayout()) {
+            emitCPodArrayBody(true);
+            emit(0,"}");
+            emit(0,"");
+            return;
+        }
         emit(1,    "int pos = 0, element;");
         if (lr.members.size() > 0) {
             emit(1, "int thislen;");
@@ -523,6 +681,12 @@ struct EmitSource : public Emit
 
         emit(0,"int __%s_decode_array(const void *buf, int offset, int maxlen, %s *p, int elements)", tn_, tn_);
         emit(0,"{");
+        if (isPodLayout()) {
+            emitCPodArrayBody(false);
+            emit(0,"}");
+            emit(0,"");
+            return;
+        }
         emit(1,    "int pos = 0, thislen, element;");
         emit(0,"");
         emit(1,    "for (element = 0; element < elements; element++) {");
@@ -599,6 +763,77 @@ struct EmitSource : public Emit
         emit(0,"");
     }
 
+    // Same as emitCDecodeArray(), except that all variable-length storage is
+    // carved out of a zcm_arena_t so nothing has to be cleaned up afterwards
+    void emitCDecodeArrayArena()
+    {
+        string tmp_ = dotsToUnderscores(lr.structname.fullname);
+        char *tn_ = (char *)tmp_.c_str();
+        const char *le = zcm.gopt->getBool("little-endian-encoding") ? "little_endian_" : "";
+
+        emit(0,"int __%s_decode_array_arena(const void *buf, int offset, int maxlen, %s *p, int elements, zcm_arena_t *arena)", tn_, tn_);
+        emit(0,"{");
+        if (isPodLayout()) {
+            emit(1, "(void) arena;");
+            emit(1, "return __%s_decode_array(buf, offset, maxlen, p, elements);", tn_);
+            emit(0,"}");
+            emit(0,"");
+            return;
+        }
+        emit(1,    "int pos = 0, thislen, element;");
+        emit(0,"");
+        emit(1,    "for (element = 0; element < elements; element++) {");
+        emit(0,"");
+        for (auto& lm : lr.members) {
+            emitCArrayLoopsStart(lm, "p", lm.isConstantSizeArray() ? FLAG_NONE : FLAG_EMIT_ARENA_ALLOCS);
+
+            int indent = 2+std::max(0, (int)lm.dimensions.size() - 1);
+            string accessor = makeAccessor(lm, "p", (int)lm.dimensions.size() - 1);
+            string size = makeArraySize(lm, "p", (int)lm.dimensions.size() - 1);
+            if (lm.type.fullname == "string")
+                emit(indent, "thislen = __string_decode_%sarray_arena(buf, offset + pos, maxlen - pos, %s, %s, arena);",
+                     le, accessor.c_str(), size.c_str());
+            else if (ZCMGen::isPrimitiveType(lm.type.fullname))
+                emit(indent, "thislen = __%s_decode_%sarray(buf, offset + pos, maxlen - pos, %s, %s);",
+                     lm.type.fullname.c_str(), le, accessor.c_str(), size.c_str());
+            else
+                emit(indent, "thislen = __%s_decode_array_arena(buf, offset + pos, maxlen - pos, %s, %s, arena);",
+                     dotsToUnderscores(lm.type.fullname).c_str(), accessor.c_str(), size.c_str());
+            emit(indent, "if (thislen < 0) return thislen; else pos += thislen;");
+
+            emitCArrayLoopsEnd(lm, "p", FLAG_NONE);
+            emit(0,"");
+        }
+        emit(1,   "}");
+        emit(1, "return pos;");
+        emit(0,"}");
+        emit(0,"");
+    }
+
+    void emitCDecodeArena()
+    {
+        string tmp_ = dotsToUnderscores(lr.structname.fullname);
+        char *tn_ = (char *)tmp_.c_str();
+
+        emit(0,"int %s_decode_arena(const void *buf, int offset, int maxlen, %s *p, zcm_arena_t *arena)", tn_, tn_);
+        emit(0,"{");
+        emit(1,    "int pos = 0, thislen;");
+        emit(1,    "int64_t hash = __%s_get_hash();", tn_);
+        emit(0,"");
+        emit(1,    "int64_t this_hash;");
+        emit(1,    "thislen = __int64_t_decode_%sarray(buf, offset + pos, maxlen - pos, &this_hash, 1);",
+                   zcm.gopt->getBool("little-endian-encoding") ? "little_endian_" : "");
+        emit(1,    "if (thislen < 0) return thislen; else pos += thislen;");
+        emit(1,    "if (this_hash != hash) return -1;");
+        emit(0,"");
+        emit(1,    "thislen = __%s_decode_array_arena(buf, offset + pos, maxlen - pos, p, 1, arena);", tn_);
+        emit(1,    "if (thislen < 0) return thislen; else pos += thislen;");
+        emit(0,"");
+        emit(1, "return pos;");
+        emit(0,"}");
+        emit(0,"");
+    }
+
     void emitCDecodeCleanup()
     {
         string tmp_ = dotsToUnderscores(lr.structname.fullname);
@@ -618,6 +853,13 @@ struct EmitSource : public Emit
 
         emit(0,"int __%s_encoded_array_size(const %s *p, int elements)", tn_, tn_);
         emit(0,"{");
+        if (isPodLayout()) {
+            emit(1, "(void)p;");
+            emit(1, "return elements * (%s - 8);", encodedSizeMacro().c_str());
+            emit(0,"}");
+            emit(0,"");
+            return;
+        }
         emit(1,"int size = 0, element;");
         emit(1,    "for (element = 0; element < elements; element++) {");
         emit(0,"");
@@ -847,33 +1089,74 @@ struct EmitSource : public Emit
         string tmp_ = dotsToUnderscores(lr.structname.fullname);
         char *tn_ = (char *)tmp_.c_str();
 
+        bool arena = zcm.gopt->getBool("c-arena");
+
         emit(0, "struct _%s_subscription_t {", tn_);
         emit(0, "    %s_handler_t user_handler;", tn_);
         emit(0, "    void *userdata;");
         emit(0, "    zcm_sub_t *z_sub;");
+        if (arena)
+            emit(0, "    zcm_arena_t *arena;");
         emit(0, "};");
         emit(0, "static");
         emit(0, "void %s_handler_stub (const zcm_recv_buf_t *rbuf,", tn_);
         emit(0, "                            const char *channel, void *userdata)");
         emit(0, "{");
-        emit(0, "    int status;");
-        emit(0, "    %s p;", tn_);
-        emit(0, "    memset(&p, 0, sizeof(%s));", tn_);
-        emit(0, "    status = %s_decode (rbuf->data, 0, rbuf->data_size, &p);", tn_);
-        emit(0, "    if (status < 0) {");
-        emit(0, "        fprintf (stderr, \"error %%d decoding %s!!!\\n\", status);", tn_);
-        emit(0, "        return;");
-        emit(0, "    }");
-        emit(0, "");
-        emit(0, "    %s_subscription_t *h = (%s_subscription_t*) userdata;", tn_, tn_);
-        emit(0, "    h->user_handler (rbuf, channel, &p, h->userdata);");
-        emit(0, "");
-        emit(0, "    %s_decode_cleanup (&p);", tn_);
+        if (arena) {
+            // Messages are decoded into the subscription's arena (if it has one),
+            // which is reset in one go once the user's handler returns
+            emit(0, "    int status;");
+            emit(0, "    %s p;", tn_);
+            emit(0, "    %s_subscription_t *h = (%s_subscription_t*) userdata;", tn_, tn_);
+            emit(0, "    memset(&p, 0, sizeof(%s));", tn_);
+            emit(0, "    if (h->arena)");
+            emit(0, "        status = %s_decode_arena (rbuf->data, 0, rbuf->data_size, &p, h->arena);", tn_);
+            emit(0, "    else");
+            emit(0, "        status = %s_decode (rbuf->data, 0, rbuf->data_size, &p);", tn_);
+            emit(0, "    if (status < 0) {");
+            emit(0, "        fprintf (stderr, \"error %%d decoding %s!!!\\n\", status);", tn_);
+            emit(0, "        if (h->arena) zcm_arena_reset (h->arena);");
+            emit(0, "        return;");
+            emit(0, "    }");
+            emit(0, "");
+            emit(0, "    h->user_handler (rbuf, channel, &p, h->userdata);");
+            emit(0, "");
+            emit(0, "    if (h->arena) zcm_arena_reset (h->arena);");
+            emit(0, "    else %s_decode_cleanup (&p);", tn_);
+        } else {
+            emit(0, "    int status;");
+            emit(0, "    %s p;", tn_);
+            emit(0, "    memset(&p, 0, sizeof(%s));", tn_);
+            emit(0, "    status = %s_decode (rbuf->data, 0, rbuf->data_size, &p);", tn_);
+            emit(0, "    if (status < 0) {");
+            emit(0, "        fprintf (stderr, \"error %%d decoding %s!!!\\n\", status);", tn_);
+            emit(0, "        return;");
+            emit(0, "    }");
+            emit(0, "");
+            emit(0, "    %s_subscription_t *h = (%s_subscription_t*) userdata;", tn_, tn_);
+            emit(0, "    h->user_handler (rbuf, channel, &p, h->userdata);");
+            emit(0, "");
+            emit(0, "    %s_decode_cleanup (&p);", tn_);
+        }
         emit(0, "}");
         emit(0, "");
-        emit(0, "%s_subscription_t* %s_subscribe (zcm_t *zcm,", tn_, tn_);
-        emit(0, "                    const char *channel,");
-        emit(0, "                    %s_handler_t f, void *userdata)", tn_);
+        if (arena) {
+            emit(0, "%s_subscription_t* %s_subscribe (zcm_t *zcm,", tn_, tn_);
+            emit(0, "                    const char *channel,");
+            emit(0, "                    %s_handler_t f, void *userdata)", tn_);
+            emit(0, "{");
+            emit(0, "    return %s_subscribe_arena (zcm, channel, f, userdata, NULL);", tn_);
+            emit(0, "}");
+            emit(0, "");
+            emit(0, "%s_subscription_t* %s_subscribe_arena (zcm_t *zcm,", tn_, tn_);
+            emit(0, "                    const char *channel,");
+            emit(0, "                    %s_handler_t f, void *userdata,", tn_);
+            emit(0, "                    zcm_arena_t *arena)");
+        } else {
+            emit(0, "%s_subscription_t* %s_subscribe (zcm_t *zcm,", tn_, tn_);
+            emit(0, "                    const char *channel,");
+            emit(0, "                    %s_handler_t f, void *userdata)", tn_);
+        }
         emit(0, "{");
         // TODO: it would be nice if this didn't need to malloc, currently only typed subscriptions
         //       in C allocate memory that isn't automatically cleaned up on the destruction of the
@@ -888,6 +1171,8 @@ struct EmitSource : public Emit
         emit(0, "                       malloc(sizeof(%s_subscription_t));", tn_);
         emit(0, "    n->user_handler = f;");
         emit(0, "    n->userdata = userdata;");
+        if (arena)
+            emit(0, "    n->arena = arena;");
         emit(0, "    n->z_sub = zcm_subscribe (zcm, channel,");
         emit(0, "                              %s_handler_stub, n);", tn_);
         emit(0, "    if (n->z_sub == NULL) {");
@@ -960,6 +1245,11 @@ static int emitStructSource(ZCMGen& zcm, ZCMStruct& lr, const string& fname)
     E.emitCDecode();
     E.emitCDecodeCleanup();
 
+    if (zcm.gopt->getBool("c-arena")) {
+        E.emitCDecodeArrayArena();
+        E.emitCDecodeArena();
+    }
+
     E.emitCCloneArray();
     E.emitCCopy();
     E.emitCDestroy();
@@ -979,6 +1269,7 @@ void setupOptionsC(GetOpt& gopt)
     gopt.addString(0, "c-include",   "",       "Generated #include lines reference this folder");
     gopt.addBool(0, "c-no-pubsub",   0,     "Do not generate _publish and _subscribe functions");
     gopt.addBool(0, "c-typeinfo",   0,      "Generate typeinfo functions for each type");
+    gopt.addBool(0, "c-arena",      0,      "Generate _decode_arena functions that allocate from a zcm_arena_t");
 }
 
 int emitC(ZCMGen& zcm)
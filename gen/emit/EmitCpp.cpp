@@ -65,6 +65,8 @@ void setupOptionsCpp(GetOpt& gopt)
 {
     gopt.addString(0, "cpp-hpath",    ".",      "Location for .hpp files");
     gopt.addString(0, "cpp-include",   "",       "Generated #include lines reference this folder");
+    gopt.addBool(0,   "cpp-view",      0,        "Also generate a zero-copy <type>View class for each type");
+    gopt.addBool(0,   "cpp-lerp",      0,        "Generate a static lerp() for types with only numeric, fixed-size members");
 }
 
 struct Emit : public Emitter
@@ -121,6 +123,90 @@ struct Emit : public Emitter
             emit(0, "}\n");
     }
 
+    static int primitiveSize(const string& t)
+    {
+        if (t == "int8_t" || t == "byte" || t == "boolean") return 1;
+        if (t == "int16_t") return 2;
+        if (t == "int32_t" || t == "float") return 4;
+        return 8;
+    }
+
+    // Number of elements in a member whose dimensions are all constant
+    static int constantCount(ZCMMember& lm)
+    {
+        int count = 1;
+        for (auto& dim : lm.dimensions)
+            count *= atoi(dim.size.c_str());
+        return count;
+    }
+
+    // True if every member is a non-string primitive or a zcmtype with constant
+    // dimensions. Whether such a type has a fixed encoded size depends on its
+    // nested types, which is only known at compile time.
+    bool hasFixedLayout()
+    {
+        for (auto& lm : ls.members) {
+            if (lm.type.fullname == "string" || !lm.isConstantSizeArray())
+                return false;
+            if (lm.type.fullname == ls.structname.fullname)
+                return false;
+        }
+        return true;
+    }
+
+    // True if lerp() can be generated for a struct: every member must be a
+    // non-string primitive or a lerp-able zcmtype, with constant dimensions.
+    // Nested types must be generated in the same zcm-gen invocation.
+    bool isLerpable(ZCMStruct& s, size_t depth = 0)
+    {
+        if (depth > zcm.structs.size())
+            return false;
+        for (auto& lm : s.members) {
+            auto& mtn = lm.type.fullname;
+            if (mtn == "string" || mtn == s.structname.fullname)
+                return false;
+            if (!lm.isConstantSizeArray())
+                return false;
+            if (ZCMGen::isPrimitiveType(mtn))
+                continue;
+            ZCMStruct *nested = nullptr;
+            for (auto& other : zcm.structs)
+                if (other.structname.fullname == mtn)
+                    nested = &other;
+            if (!nested || !isLerpable(*nested, depth + 1))
+                return false;
+        }
+        return true;
+    }
+
+    bool emitsLerp()
+    {
+        return zcm.gopt->getBool("cpp-lerp") && isLerpable(ls);
+    }
+
+    string fixedEncodedSizeExpr()
+    {
+        if (!hasFixedLayout())
+            return "-1";
+
+        int primSize = 0;
+        string nestedCond, nestedSize;
+        for (auto& lm : ls.members) {
+            auto& mtn = lm.type.fullname;
+            int count = constantCount(lm);
+            if (ZCMGen::isPrimitiveType(mtn)) {
+                primSize += count * primitiveSize(mtn);
+            } else {
+                string n = "(int)" + dotsToDoubleColons(mtn) + "::_fixedEncodedSizeNoHash";
+                nestedCond += (nestedCond.size() > 0 ? " || " : "") + n + " < 0";
+                nestedSize += " + " + std::to_string(count) + " * " + n;
+            }
+        }
+        if (nestedCond.size() == 0)
+            return std::to_string(primSize);
+        return "(" + nestedCond + ") ? -1 : " + std::to_string(primSize) + nestedSize;
+    }
+
     void emitHeaderStart()
     {
         const char *tn = ls.structname.fullname.c_str();
@@ -131,6 +217,8 @@ struct Emit : public Emitter
         emitAutoGeneratedWarning();
 
         emit(0, "#include <zcm/zcm_coretypes.h>");
+        if (zcm.gopt->getBool("cpp-view"))
+            emit(0, "#include <zcm/zcm_view.hpp>");
         emit(0, "");
         emit(0, "#ifndef __%s_hpp__", tn_);
         emit(0, "#define __%s_hpp__", tn_);
@@ -270,12 +358,28 @@ struct Emit : public Emitter
         emit(2, " */");
         emit(2, "inline static const char* getTypeName();");
 
+        if (emitsLerp()) {
+            emit(0, "");
+            emit(2, "/**");
+            emit(2, " * Linearly interpolates between a (alpha = 0) and b (alpha = 1) into out,");
+            emit(2, " * which may alias a or b. Integers are rounded to the nearest value;");
+            emit(2, " * booleans and bytes are copied from whichever of a and b is nearer.");
+            emit(2, " */");
+            emit(2, "inline static void lerp(const %s& a, const %s& b, double alpha, %s& out);",
+                 sn, sn, sn);
+        }
+
         emit(0, "");
         emit(2, "// ZCM support functions. Users should not call these");
         emit(2, "inline int _encodeNoHash(void *buf, int offset, int maxlen) const;");
         emit(2, "inline int _getEncodedSizeNoHash() const;");
         emit(2, "inline int _decodeNoHash(const void *buf, int offset, int maxlen);");
         emit(2, "inline static uint64_t _computeHash(const __zcm_hash_ptr *p);");
+        emit(2, "// Caller guarantees that buf holds at least _getEncodedSizeNoHash() bytes");
+        emit(2, "inline int _encodeNoHashUnchecked(void *buf, int offset) const;");
+        emit(0, "");
+        emit(2, "// Encoded size of this type (without hash) if it never varies, -1 otherwise");
+        emit(2, "enum { _fixedEncodedSizeNoHash = %s };", fixedEncodedSizeExpr().c_str());
         emit(0, "};");
         emit(0, "");
     }
@@ -404,6 +508,86 @@ struct Emit : public Emitter
         emit(0, "");
     }
 
+    // Interpolates a single primitive element between A and B into O
+    void emitLerpPrimitive(int indent, const string& mtn,
+                           const string& O, const string& A, const string& B)
+    {
+        const char *o = O.c_str(), *a = A.c_str(), *b = B.c_str();
+        if (mtn == "double") {
+            emit(indent, "%s = %s + (%s - %s) * alpha;", o, a, b, a);
+        } else if (mtn == "float") {
+            emit(indent, "%s = %s + (%s - %s) * alphaf;", o, a, b, a);
+        } else if (mtn == "boolean" || mtn == "byte") {
+            emit(indent, "%s = alpha < 0.5 ? %s : %s;", o, a, b);
+        } else {
+            // Round half away from zero so that lerp(a, a) == a exactly
+            emit(indent, "{");
+            emit(indent + 1, "double d = (double)((int64_t)%s - (int64_t)%s) * alpha;", b, a);
+            emit(indent + 1, "%s = (%s)(%s + (int64_t)(d < 0 ? d - 0.5 : d + 0.5));",
+                 o, mtn.c_str(), a);
+            emit(indent, "}");
+        }
+    }
+
+    void emitLerp()
+    {
+        if (!emitsLerp())
+            return;
+
+        const char* sn = ls.structname.shortname.c_str();
+
+        bool hasFloat = false;
+        for (auto& lm : ls.members)
+            if (lm.type.fullname == "float")
+                hasFloat = true;
+
+        emit(0, "void %s::lerp(const %s& a, const %s& b, double alpha, %s& out)",
+             sn, sn, sn, sn);
+        emit(0, "{");
+        if (hasFloat)
+            emit(1, "const float alphaf = (float)alpha;");
+        for (auto& lm : ls.members) {
+            auto& mtn = lm.type.fullname;
+            const char *mn = lm.membername.c_str();
+            bool isPrim = ZCMGen::isPrimitiveType(mtn);
+
+            if (lm.dimensions.size() == 0) {
+                if (isPrim)
+                    emitLerpPrimitive(1, mtn, "out." + lm.membername,
+                                      "a." + lm.membername, "b." + lm.membername);
+                else
+                    emit(1, "%s::lerp(a.%s, b.%s, alpha, out.%s);",
+                         dotsToDoubleColons(mtn).c_str(), mn, mn, mn);
+                continue;
+            }
+
+            int count = constantCount(lm);
+            if (count == 0)
+                continue;
+
+            // Walk multidimensional arrays as one flat array so the loop vectorizes
+            string first = lm.membername;
+            for (size_t d = 0; d < lm.dimensions.size(); ++d)
+                first += "[0]";
+            string tn = mapTypeName(mtn);
+            const char *tn_ = tn.c_str();
+            const char *fst = first.c_str();
+
+            emit(1, "{");
+            emit(2,     "const %s *pa = &a.%s;", tn_, fst);
+            emit(2,     "const %s *pb = &b.%s;", tn_, fst);
+            emit(2,     "%s *po = &out.%s;", tn_, fst);
+            emit(2,     "for (int i = 0; i < %d; ++i)", count);
+            if (isPrim)
+                emitLerpPrimitive(3, mtn, "po[i]", "pa[i]", "pb[i]");
+            else
+                emit(3,     "%s::lerp(pa[i], pb[i], alpha, po[i]);", tn_);
+            emit(1, "}");
+        }
+        emit(0, "}");
+        emit(0, "");
+    }
+
     void _encodeRecursive(ZCMMember& lm, int depth, int extraIndent)
     {
         auto& mtn = lm.type.fullname;
@@ -465,6 +649,13 @@ struct Emit : public Emitter
         }
         emit(0, "int %s::_encodeNoHash(void *buf, int offset, int maxlen) const", sn);
         emit(0, "{");
+        if (hasFixedLayout()) {
+            emit(1, "if (_fixedEncodedSizeNoHash >= 0) {");
+            emit(2,     "if (maxlen < _fixedEncodedSizeNoHash) return -1;");
+            emit(2,     "return this->_encodeNoHashUnchecked(buf, offset);");
+            emit(1, "}");
+            emit(0, "");
+        }
         emit(1,     "int pos = 0, tlen;");
         emit(0, "");
         for (auto& lm : ls.members) {
@@ -512,6 +703,76 @@ struct Emit : public Emitter
         emit(0,"");
     }
 
+    void emitEncodeNohashUnchecked()
+    {
+        const char* sn = ls.structname.shortname.c_str();
+        if (ls.members.size() == 0) {
+            emit(0, "int %s::_encodeNoHashUnchecked(void *, int) const", sn);
+            emit(0, "{");
+            emit(1,     "return 0;");
+            emit(0, "}");
+            emit(0, "");
+            return;
+        }
+
+        emit(0, "int %s::_encodeNoHashUnchecked(void *buf, int offset) const", sn);
+        emit(0, "{");
+        if (!hasFixedLayout()) {
+            emit(1, "return this->_encodeNoHash(buf, offset, 0x7fffffff - offset);");
+            emit(0, "}");
+            emit(0, "");
+            return;
+        }
+
+        // Every member has a constant size: store them without any bounds checks
+        const char* order = zcm.gopt->getBool("little-endian-encoding") ? "le" : "be";
+        emit(1, "uint8_t *p = (uint8_t*) buf + offset;");
+        emit(1, "int pos = 0;");
+        emit(0, "");
+        for (auto& lm : ls.members) {
+            auto& mtn = lm.type.fullname;
+            auto *mn = lm.membername.c_str();
+            int ndim = (int)lm.dimensions.size();
+            int count = constantCount(lm);
+
+            if (ZCMGen::isPrimitiveType(mtn)) {
+                string first = "this->" + lm.membername;
+                if (ndim > 0) {
+                    first = "&" + first;
+                    for (int i = 0; i < ndim; i++)
+                        first += "[0]";
+                } else {
+                    first = "&" + first;
+                }
+                int size = primitiveSize(mtn);
+                if (count == 0)
+                    continue;
+                if (size == 1)
+                    emit(1, "memcpy(p + pos, %s, %d);", first.c_str(), count);
+                else
+                    emit(1, "__zcm_encode_%s(p + pos, %s, %d, %d);",
+                            order, first.c_str(), count, size);
+                emit(1, "pos += %d;", count * size);
+            } else {
+                for (int n = 0; n < ndim; n++) {
+                    auto& dim = lm.dimensions[n];
+                    emit(1+n, "for (int a%d = 0; a%d < %s; a%d++) {",
+                         n, n, dim.size.c_str(), n);
+                }
+                emitStart(1 + ndim, "pos += this->%s", mn);
+                for (int i = 0; i < ndim; i++)
+                    emitContinue("[a%d]", i);
+                emitEnd("._encodeNoHashUnchecked(p, pos);");
+                for (int n = ndim-1; n >= 0; n--)
+                    emit(1 + n, "}");
+            }
+        }
+        emit(0, "");
+        emit(1, "return pos;");
+        emit(0, "}");
+        emit(0, "");
+    }
+
     void emitEncodedSizeNohash()
     {
         const char *sn = ls.structname.shortname.c_str();
@@ -523,12 +784,37 @@ struct Emit : public Emitter
             emit(0,"");
             return;
         }
+        if (hasFixedLayout())
+            emit(1, "if (_fixedEncodedSizeNoHash >= 0) return _fixedEncodedSizeNoHash;");
         emit(1,     "int enc_size = 0;");
         for (auto& lm : ls.members) {
             auto& mtn = lm.type.fullname;
             auto *mn = lm.membername.c_str();
             int ndim = (int)lm.dimensions.size();
 
+            // Arrays of fixed size zcmtypes don't need to be walked element by element
+            if (!ZCMGen::isPrimitiveType(mtn) && ndim > 0) {
+                string fixedSize = dotsToDoubleColons(mtn) + "::_fixedEncodedSizeNoHash";
+                emitStart(1, "if (%s >= 0) enc_size += ", fixedSize.c_str());
+                for (auto& dim : lm.dimensions)
+                    emitContinue("%s%s * ", dimSizePrefix(dim.size).c_str(), dim.size.c_str());
+                emitEnd("%s;", fixedSize.c_str());
+                emit(1, "else {");
+                for(int n = 0; n < ndim; n++) {
+                    auto& dim = lm.dimensions[n];
+                    emit(2+n, "for (int a%d = 0; a%d < %s%s; a%d++) {",
+                         n, n, dimSizePrefix(dim.size).c_str(), dim.size.c_str(), n);
+                }
+                emitStart(ndim + 2, "enc_size += this->%s", mn);
+                for(int i = 0; i < ndim; i++)
+                    emitContinue("[a%d]", i);
+                emitEnd("._getEncodedSizeNoHash();");
+                for(int n = ndim-1; n >= 0; n--)
+                    emit(2 + n, "}");
+                emit(1, "}");
+                continue;
+            }
+
             if (ZCMGen::isPrimitiveType(mtn) && mtn != "string") {
                 emitStart(1, "enc_size += ");
                 for(int n = 0; n < ndim-1; n++) {
@@ -683,6 +969,291 @@ struct Emit : public Emitter
         emit(0, "");
     }
 
+    // Expression for one dimension of an array when read back through a view
+    static string viewDimAccessor(const string& dimSize)
+    {
+        if (isDimSizeFixed(dimSize))
+            return dimSize;
+        return "this->" + dimSize + "()";
+    }
+
+    // Expression for the total number of (flattened) elements of an array member
+    static string viewCount(ZCMMember& lm)
+    {
+        if (lm.dimensions.size() == 0)
+            return "1";
+        string ret;
+        for (auto& dim : lm.dimensions)
+            ret += (ret.size() > 0 ? " * " : "") + viewDimAccessor(dim.size);
+        return ret;
+    }
+
+    string arrayViewType(const string& mtn)
+    {
+        return "zcm::ArrayView<" + mapTypeName(mtn) +
+               (zcm.gopt->getBool("little-endian-encoding") ? ", true" : "") + ">";
+    }
+
+    void emitViewClass()
+    {
+        const char* sn = ls.structname.shortname.c_str();
+
+        emit(0, "/**");
+        emit(0, " * A zero-copy, read-only view of an encoded %s.", sn);
+        emit(0, " * decode() only walks the lengths of the message; every field is read");
+        emit(0, " * straight out of the encoded buffer when its accessor is called.");
+        emit(0, " * The buffer passed to decode() must outlive the view.");
+        emit(0, " */");
+        emit(0, "class %sView", sn);
+        emit(0, "{");
+        emit(1, "public:");
+        emit(2, "inline %sView() : _buf(NULL), _len(0) {}", sn);
+        emit(0, "");
+        emit(2, "/**");
+        emit(2, " * Validate an encoded message and point this view at it.");
+        emit(2, " *");
+        emit(2, " * @param buf The buffer containing the encoded message.");
+        emit(2, " * @param offset The byte offset into @p buf where the encoded message starts.");
+        emit(2, " * @param maxlen The maximum number of bytes to read while validating.");
+        emit(2, " * @return The number of bytes spanned by the message, or <0 if an error occured.");
+        emit(2, " */");
+        emit(2, "inline int decode(const void *buf, int offset, int maxlen);");
+        emit(0, "");
+        emit(2, "/**");
+        emit(2, " * Returns true if this view currently points at a valid message");
+        emit(2, " */");
+        emit(2, "inline bool good() const { return _buf != NULL; }");
+        emit(0, "");
+        emit(2, "/**");
+        emit(2, " * Decode the whole message into @p msg.");
+        emit(2, " */");
+        emit(2, "inline int copyTo(%s& msg) const { return msg._decodeNoHash(_buf, 0, _len); }", sn);
+        emit(0, "");
+        emit(2, "inline static int64_t getHash() { return %s::getHash(); }", sn);
+        emit(2, "inline static const char* getTypeName() { return %s::getTypeName(); }", sn);
+
+        if (ls.members.size() > 0) {
+            emit(0, "");
+            emit(2, "// Field accessors. Arrays of strings and zcmtypes take a flattened");
+            emit(2, "// (row-major) index; none are bounds checked. Elements of fixed size");
+            emit(2, "// are found directly, others by walking on from the last element read,");
+            emit(2, "// so iterating over an array is linear. That makes a view unsafe to");
+            emit(2, "// share between threads");
+            for (auto& lm : ls.members) {
+                auto& mtn = lm.type.fullname;
+                auto *mn = lm.membername.c_str();
+                string mappedTypename = mapTypeName(mtn);
+                int ndim = (int)lm.dimensions.size();
+
+                emitComment(2, lm.comment);
+                if (mtn == "string") {
+                    emit(2, "inline const char* %s(%s) const;", mn, ndim > 0 ? "int i" : "");
+                } else if (ZCMGen::isPrimitiveType(mtn)) {
+                    if (ndim == 0)
+                        emit(2, "inline %s %s() const;", mappedTypename.c_str(), mn);
+                    else
+                        emit(2, "inline %s %s() const;", arrayViewType(mtn).c_str(), mn);
+                } else {
+                    emit(2, "inline %sView %s(%s) const;",
+                            mappedTypename.c_str(), mn, ndim > 0 ? "int i" : "");
+                }
+            }
+        }
+
+        emit(0, "");
+        emit(2, "// ZCM support functions. Users should not call these");
+        emit(2, "inline int _decodeNoHash(const void *buf, int offset, int maxlen);");
+        emit(0, "");
+        emit(1, "private:");
+        emit(2, "const uint8_t *_buf;");
+        emit(2, "int _len;");
+        if (ls.members.size() > 0) {
+            emit(2, "int _offsets[%d];", (int)ls.members.size());
+            emit(2, "// Index and offset of the last element read from each array of");
+            emit(2, "// strings or zcmtypes");
+            emit(2, "mutable int _lastIdx[%d];", (int)ls.members.size());
+            emit(2, "mutable int _lastPos[%d];", (int)ls.members.size());
+        }
+        emit(0, "};");
+        emit(0, "");
+    }
+
+    void emitViewDecode()
+    {
+        const char* sn = ls.structname.shortname.c_str();
+        const char* le = zcm.gopt->getBool("little-endian-encoding") ? "little_endian_" : "";
+
+        emit(0, "int %sView::decode(const void *buf, int offset, int maxlen)", sn);
+        emit(0, "{");
+        emit(1,     "int pos = 0, thislen;");
+        emit(1,     "_buf = NULL;");
+        emit(0, "");
+        emit(1,     "int64_t msg_hash;");
+        emit(1,     "thislen = __int64_t_decode_%sarray(buf, offset + pos, maxlen - pos, &msg_hash, 1);", le);
+        emit(1,     "if (thislen < 0) return thislen; else pos += thislen;");
+        emit(1,     "if (msg_hash != getHash()) return -1;");
+        emit(0, "");
+        emit(1,     "thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);");
+        emit(1,     "if (thislen < 0) { _buf = NULL; return thislen; } else pos += thislen;");
+        emit(0, "");
+        emit(1,  "return pos;");
+        emit(0, "}");
+        emit(0, "");
+
+        if (ls.members.size() == 0) {
+            emit(0, "int %sView::_decodeNoHash(const void *buf, int offset, int)", sn);
+            emit(0, "{");
+            emit(1,     "_buf = (const uint8_t*)buf + offset;");
+            emit(1,     "_len = 0;");
+            emit(1,     "return 0;");
+            emit(0, "}");
+            emit(0, "");
+            return;
+        }
+
+        // Only lengths are read here: primitive arrays are skipped arithmetically,
+        // strings and nested types by their length prefixes.
+        emit(0, "int %sView::_decodeNoHash(const void *buf, int offset, int maxlen)", sn);
+        emit(0, "{");
+        emit(1,     "int pos = 0, tlen;");
+        emit(1,     "int64_t n;");
+        emit(1,     "(void)tlen; (void)n;");
+        emit(0, "");
+        emit(1,     "_buf = (const uint8_t*)buf + offset;");
+        emit(1,     "_len = maxlen;");
+        emit(0, "");
+        for (int m = 0; m < (int)ls.members.size(); m++) {
+            auto& lm = ls.members[m];
+            auto& mtn = lm.type.fullname;
+
+            emit(1, "_offsets[%d] = pos;", m);
+            if (lm.dimensions.size() > 0 &&
+                (mtn == "string" || !ZCMGen::isPrimitiveType(mtn))) {
+                emit(1, "_lastIdx[%d] = 0;", m);
+                emit(1, "_lastPos[%d] = pos;", m);
+            }
+            emit(1, "n = 1;");
+            for (auto& dim : lm.dimensions) {
+                emit(1, "n *= (int64_t)%s;", viewDimAccessor(dim.size).c_str());
+                emit(1, "if (n < 0 || n > maxlen) return -1;");
+            }
+
+            if (mtn == "string") {
+                emit(1, "for (int64_t i = 0; i < n; i++) {");
+                emit(2,     "int32_t len;");
+                emit(2,     "tlen = __int32_t_decode_%sarray(_buf, pos, maxlen - pos, &len, 1);", le);
+                emit(2,     "if (tlen < 0) return tlen; else pos += tlen;");
+                emit(2,     "if (len < 1 || len > maxlen - pos || _buf[pos + len - 1] != 0) return -1;");
+                emit(2,     "pos += len;");
+                emit(1, "}");
+            } else if (ZCMGen::isPrimitiveType(mtn)) {
+                string mappedTypename = mapTypeName(mtn);
+                emit(1, "if (n * (int64_t)sizeof(%s) > maxlen - pos) return -1;",
+                        mappedTypename.c_str());
+                emit(1, "pos += (int)n * (int)sizeof(%s);", mappedTypename.c_str());
+            } else {
+                string tn = mapTypeName(mtn);
+                string vn = tn + "View";
+                emit(1, "if (%s::_fixedEncodedSizeNoHash >= 0) {", tn.c_str());
+                emit(2,     "if (n * (int64_t)%s::_fixedEncodedSizeNoHash > maxlen - pos) return -1;",
+                            tn.c_str());
+                emit(2,     "pos += (int)n * (int)%s::_fixedEncodedSizeNoHash;", tn.c_str());
+                emit(1, "} else {");
+                emit(2,     "for (int64_t i = 0; i < n; i++) {");
+                emit(3,         "tlen = %s()._decodeNoHash(_buf, pos, maxlen - pos);", vn.c_str());
+                emit(3,         "if (tlen < 0) return tlen; else pos += tlen;");
+                emit(2,     "}");
+                emit(1, "}");
+            }
+            emit(0, "");
+        }
+        emit(1, "return pos;");
+        emit(0, "}");
+        emit(0, "");
+    }
+
+    void emitViewAccessors()
+    {
+        const char* sn = ls.structname.shortname.c_str();
+        const char* le = zcm.gopt->getBool("little-endian-encoding") ? "little_endian_" : "";
+
+        for (int m = 0; m < (int)ls.members.size(); m++) {
+            auto& lm = ls.members[m];
+            auto& mtn = lm.type.fullname;
+            auto *mn = lm.membername.c_str();
+            string mappedTypename = mapTypeName(mtn);
+            int ndim = (int)lm.dimensions.size();
+
+            if (mtn == "string") {
+                emit(0, "const char* %sView::%s(%s) const", sn, mn, ndim > 0 ? "int i" : "");
+                emit(0, "{");
+                emit(1,     "int pos = _offsets[%d];", m);
+                if (ndim > 0) {
+                    emit(1, "int a = 0;");
+                    emit(1, "if (i >= _lastIdx[%d]) { a = _lastIdx[%d]; pos = _lastPos[%d]; }",
+                            m, m, m);
+                    emit(1, "for (; a < i; a++) {");
+                    emit(2,     "int32_t len;");
+                    emit(2,     "__int32_t_decode_%sarray(_buf, pos, 4, &len, 1);", le);
+                    emit(2,     "pos += 4 + len;");
+                    emit(1, "}");
+                    emit(1, "_lastIdx[%d] = i;", m);
+                    emit(1, "_lastPos[%d] = pos;", m);
+                }
+                emit(1,     "return (const char*)_buf + pos + 4;");
+                emit(0, "}");
+            } else if (ZCMGen::isPrimitiveType(mtn)) {
+                if (ndim == 0) {
+                    emit(0, "%s %sView::%s() const", mappedTypename.c_str(), sn, mn);
+                    emit(0, "{");
+                    emit(1,     "%s v;", mappedTypename.c_str());
+                    emit(1,     "__%s_decode_%sarray(_buf, _offsets[%d], sizeof(v), &v, 1);",
+                                mtn.c_str(), le, m);
+                    emit(1,     "return v;");
+                    emit(0, "}");
+                } else {
+                    string avt = arrayViewType(mtn);
+                    emit(0, "%s %sView::%s() const", avt.c_str(), sn, mn);
+                    emit(0, "{");
+                    emit(1,     "return %s(_buf + _offsets[%d], (int)(%s));",
+                                avt.c_str(), m, viewCount(lm).c_str());
+                    emit(0, "}");
+                }
+            } else {
+                string vn = mappedTypename + "View";
+                emit(0, "%s %sView::%s(%s) const", vn.c_str(), sn, mn, ndim > 0 ? "int i" : "");
+                emit(0, "{");
+                emit(1,     "%s v;", vn.c_str());
+                emit(1,     "int pos = _offsets[%d];", m);
+                if (ndim > 0) {
+                    const char *tn = mappedTypename.c_str();
+                    emit(1, "if (%s::_fixedEncodedSizeNoHash >= 0) {", tn);
+                    emit(2,     "pos += i * (int)%s::_fixedEncodedSizeNoHash;", tn);
+                    emit(1, "} else {");
+                    emit(2,     "int a = 0;");
+                    emit(2,     "if (i >= _lastIdx[%d]) { a = _lastIdx[%d]; pos = _lastPos[%d]; }",
+                                m, m, m);
+                    emit(2,     "for (; a < i; a++)");
+                    emit(3,         "pos += v._decodeNoHash(_buf, pos, _len - pos);");
+                    emit(2,     "_lastIdx[%d] = i;", m);
+                    emit(2,     "_lastPos[%d] = pos;", m);
+                    emit(1, "}");
+                }
+                emit(1,     "v._decodeNoHash(_buf, pos, _len - pos);");
+                emit(1,     "return v;");
+                emit(0, "}");
+            }
+            emit(0, "");
+        }
+    }
+
+    void emitView()
+    {
+        emitViewClass();
+        emitViewDecode();
+        emitViewAccessors();
+    }
+
     void emitHeader()
     {
         emitHeaderStart();
@@ -692,9 +1263,13 @@ struct Emit : public Emitter
         emitGetHash();
         emitGetTypeName();
         emitEncodeNohash();
+        emitEncodeNohashUnchecked();
         emitDecodeNohash();
         emitEncodedSizeNohash();
         emitComputeHash();
+        emitLerp();
+        if (zcm.gopt->getBool("cpp-view"))
+            emitView();
         emitHeaderEnd();
     }
 };
@@ -56,12 +56,17 @@ TESTDIR=$BASEDIR/test/gen
 TMPDIR=/tmp/zcmtypes
 
 ## Note: this runs in a subshell
+## Extra zcm-gen flags for a test can be listed in a .flags file next to its .zcm
 gen_zcm() {(
     file=$1
+    flags=""
+    if [ -f "${file%.*}.flags" ]; then
+        flags=$(cat "${file%.*}.flags")
+    fi
     rm -fr $TMPDIR
     mkdir $TMPDIR
     cd $TMPDIR
-    $BASEDIR/build/gen/zcm-gen -c -x -j $file >/dev/null
+    $BASEDIR/build/gen/zcm-gen -c -x -j --jdefaultpkg zcmtypes $flags $file >/dev/null
 )}
 
 check_all_ext() {
@@ -21,9 +21,18 @@ run   coretest        ./build/test/zcm/coretest
 run   sub-unsub-c     ./build/test/zcm/sub_unsub_c
 run   sub-unsub-cpp   ./build/test/zcm/sub_unsub_cpp
 run   api-retcodes    ./build/test/zcm/api_retcodes
+run   stats-hist      ./build/test/zcm/stats_hist
 run   dispatch-loop   ./build/test/zcm/dispatch_loop
 run   forking         ./build/test/zcm/forking
 run   forking2        ./build/test/zcm/forking2
 run   flushing        ./build/test/zcm/flushing
 run   logging         ./build/test/zcm/logtest
 run   trackers        ./build/test/zcm/trackers
+run   shared-pool     ./build/test/zcm/shared_pool
+run   udpm-stamps     ./build/test/zcm/udpm_stamps
+run   forwarding      ./build/test/zcm/forwarding
+run   channel-filter  ./build/test/zcm/channel_filter
+run   view-roundtrip  ./build/test/zcm/view_roundtrip
+run   fixed-roundtrip ./build/test/zcm/fixed_roundtrip
+run   pod-roundtrip   ./build/test/zcm/pod_roundtrip
+run   arena-roundtrip ./build/test/zcm/arena_roundtrip
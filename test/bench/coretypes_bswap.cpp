@@ -0,0 +1,133 @@
+#include "zcm/zcm_coretypes.h"
+
+#include <time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+// Microbenchmark of the bulk primitive array encoders/decoders in zcm_coretypes.h,
+// built with ZCM_SIMD so the large arrays go through the SIMD kernels
+// Every (type, encoding, size) combination is checked against a portable reference
+// encoding before it is timed.
+
+#define MIN_ELEMENTS 1
+#define MAX_ELEMENTS 10000000
+// Roughly how many bytes to push through each kernel per measurement
+#define BYTES_PER_RUN (256 << 20)
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Reference encoding of a single element, independent of host byte order
+template <class T>
+static void refEncode(uint8_t* dst, T v, bool littleEndian)
+{
+    uint64_t u = 0;
+    memcpy(&u, &v, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        size_t shift = littleEndian ? i : sizeof(T) - 1 - i;
+        dst[i] = (u >> (8 * shift)) & 0xff;
+    }
+}
+
+template <class T>
+struct Kernels
+{
+    const char* name;
+    int (*encode)(void*, int, int, const T*, int);
+    int (*decode)(const void*, int, int, T*, int);
+    int (*encodeLE)(void*, int, int, const T*, int);
+    int (*decodeLE)(const void*, int, int, T*, int);
+};
+
+template <class T>
+static double timeIt(int n, const T* src, T* dst, uint8_t* buf, int len,
+                     int (*encode)(void*, int, int, const T*, int),
+                     int (*decode)(const void*, int, int, T*, int), bool doEncode)
+{
+    size_t iters = BYTES_PER_RUN / len;
+    if (iters < 3) iters = 3;
+    if (iters > 1000000) iters = 1000000;
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < iters; ++i) {
+        if (doEncode) encode(buf, 0, len, src, n);
+        else          decode(buf, 0, len, dst, n);
+        // Keep the compiler from hoisting the kernel out of the loop
+        __asm__ __volatile__("" : : "r"(buf), "r"(dst) : "memory");
+    }
+    return (double)(nowNs() - start) / iters;
+}
+
+template <class T>
+static bool bench(const Kernels<T>& k)
+{
+    vector<T> src(MAX_ELEMENTS), dst(MAX_ELEMENTS);
+    vector<uint8_t> buf(MAX_ELEMENTS * sizeof(T)), ref(MAX_ELEMENTS * sizeof(T));
+    for (size_t i = 0; i < src.size(); ++i) {
+        uint64_t bits = (uint64_t)rand() << 32 | (uint64_t)rand();
+        memcpy(&src[i], &bits, sizeof(T));
+    }
+
+    for (int le = 0; le < 2; ++le) {
+        auto encode = le ? k.encodeLE : k.encode;
+        auto decode = le ? k.decodeLE : k.decode;
+        for (int n = MIN_ELEMENTS; n <= MAX_ELEMENTS; n *= 10) {
+            int len = n * sizeof(T);
+
+            for (int i = 0; i < n; ++i)
+                refEncode(&ref[i * sizeof(T)], src[i], le);
+            if (encode(buf.data(), 0, len, src.data(), n) != len ||
+                memcmp(buf.data(), ref.data(), len) != 0) {
+                fprintf(stderr, "%s %s encode mismatch at n=%d\n",
+                        k.name, le ? "LE" : "BE", n);
+                return false;
+            }
+            if (decode(buf.data(), 0, len, dst.data(), n) != len ||
+                memcmp(dst.data(), src.data(), len) != 0) {
+                fprintf(stderr, "%s %s decode mismatch at n=%d\n",
+                        k.name, le ? "LE" : "BE", n);
+                return false;
+            }
+
+            double encNs = timeIt(n, src.data(), dst.data(), buf.data(), len, encode, decode, true);
+            double decNs = timeIt(n, src.data(), dst.data(), buf.data(), len, encode, decode, false);
+            printf("%-8s %s %9d  encode %10.1f ns (%6.2f GB/s)  decode %10.1f ns (%6.2f GB/s)\n",
+                   k.name, le ? "LE" : "BE", n, encNs, len / encNs, decNs, len / decNs);
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    bool ok = true;
+    ok &= bench(Kernels<int16_t>{"int16_t",
+                                 __int16_t_encode_array, __int16_t_decode_array,
+                                 __int16_t_encode_little_endian_array,
+                                 __int16_t_decode_little_endian_array});
+    ok &= bench(Kernels<int32_t>{"int32_t",
+                                 __int32_t_encode_array, __int32_t_decode_array,
+                                 __int32_t_encode_little_endian_array,
+                                 __int32_t_decode_little_endian_array});
+    ok &= bench(Kernels<int64_t>{"int64_t",
+                                 __int64_t_encode_array, __int64_t_decode_array,
+                                 __int64_t_encode_little_endian_array,
+                                 __int64_t_decode_little_endian_array});
+    ok &= bench(Kernels<float>{"float",
+                               __float_encode_array, __float_decode_array,
+                               __float_encode_little_endian_array,
+                               __float_decode_little_endian_array});
+    ok &= bench(Kernels<double>{"double",
+                                __double_encode_array, __double_decode_array,
+                                __double_encode_little_endian_array,
+                                __double_decode_little_endian_array});
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,427 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "arena1.h"
+
+static int __arena1_hash_computed;
+static uint64_t __arena1_hash;
+
+uint64_t __arena1_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __arena1_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__arena1_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0xf49b3a51e03f6f5eLL
+         + __int64_t_hash_recursive(&cp)
+         + __string_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __int16_t_hash_recursive(&cp)
+         + __string_hash_recursive(&cp)
+         + __arena_item_hash_recursive(&cp)
+         + __int8_t_hash_recursive(&cp)
+         + __float_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __arena1_get_hash(void)
+{
+    if (!__arena1_hash_computed) {
+        __arena1_hash = (int64_t)__arena1_hash_recursive(NULL);
+        __arena1_hash_computed = 1;
+    }
+
+    return __arena1_hash;
+}
+
+int __arena1_encode_array(void *buf, int offset, int maxlen, const arena1 *p, int elements)
+{
+    int pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].utime), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int16_t_encode_array(buf, offset + pos, maxlen - pos, p[element].data, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, p[element].tags, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __arena_item_encode_array(buf, offset + pos, maxlen - pos, p[element].items, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int8_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].rows), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        { int a;
+        for (a = 0; a < p[element].rows; a++) {
+            thislen = __float_encode_array(buf, offset + pos, maxlen - pos, p[element].grid[a], 2);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+    }
+    return pos;
+}
+
+int arena1_encode(void *buf, int offset, int maxlen, const arena1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __arena1_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __arena1_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __arena1_encoded_array_size(const arena1 *p, int elements)
+{
+    int size = 0, element;
+    for (element = 0; element < elements; element++) {
+
+        size += __int64_t_encoded_array_size(&(p[element].utime), 1);
+
+        size += __string_encoded_array_size(&(p[element].name), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].n), 1);
+
+        size += __int16_t_encoded_array_size(p[element].data, p[element].n);
+
+        size += __string_encoded_array_size(p[element].tags, p[element].n);
+
+        size += __arena_item_encoded_array_size(p[element].items, p[element].n);
+
+        size += __int8_t_encoded_array_size(&(p[element].rows), 1);
+
+        { int a;
+        for (a = 0; a < p[element].rows; a++) {
+            size += __float_encoded_array_size(p[element].grid[a], 2);
+        }
+        }
+
+    }
+    return size;
+}
+
+int arena1_encoded_size(const arena1 *p)
+{
+    return 8 + __arena1_encoded_array_size(p, 1);
+}
+
+int __arena1_decode_array(const void *buf, int offset, int maxlen, arena1 *p, int elements)
+{
+    int pos = 0, thislen, element;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].utime), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].data = (int16_t*) zcm_malloc(sizeof(int16_t) * p[element].n);
+        thislen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, p[element].data, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].tags = (char**) zcm_malloc(sizeof(char*) * p[element].n);
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, p[element].tags, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].items = (arena_item*) zcm_malloc(sizeof(arena_item) * p[element].n);
+        thislen = __arena_item_decode_array(buf, offset + pos, maxlen - pos, p[element].items, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int8_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].rows), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].grid = (float**) zcm_malloc(sizeof(float*) * p[element].rows);
+        { int a;
+        for (a = 0; a < p[element].rows; a++) {
+            p[element].grid[a] = (float*) zcm_malloc(sizeof(float) * 2);
+            thislen = __float_decode_array(buf, offset + pos, maxlen - pos, p[element].grid[a], 2);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+    }
+    return pos;
+}
+
+int __arena1_decode_array_cleanup(arena1 *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int64_t_decode_array_cleanup(&(p[element].utime), 1);
+
+        __string_decode_array_cleanup(&(p[element].name), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].n), 1);
+
+        __int16_t_decode_array_cleanup(p[element].data, p[element].n);
+        if (p[element].data) free(p[element].data);
+
+        __string_decode_array_cleanup(p[element].tags, p[element].n);
+        if (p[element].tags) free(p[element].tags);
+
+        __arena_item_decode_array_cleanup(p[element].items, p[element].n);
+        if (p[element].items) free(p[element].items);
+
+        __int8_t_decode_array_cleanup(&(p[element].rows), 1);
+
+        { int a;
+        for (a = 0; a < p[element].rows; a++) {
+            __float_decode_array_cleanup(p[element].grid[a], 2);
+            if (p[element].grid[a]) free(p[element].grid[a]);
+        }
+        }
+        if (p[element].grid) free(p[element].grid);
+
+    }
+    return 0;
+}
+
+int arena1_decode(const void *buf, int offset, int maxlen, arena1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __arena1_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena1_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int arena1_decode_cleanup(arena1 *p)
+{
+    return __arena1_decode_array_cleanup(p, 1);
+}
+
+int __arena1_decode_array_arena(const void *buf, int offset, int maxlen, arena1 *p, int elements, zcm_arena_t *arena)
+{
+    int pos = 0, thislen, element;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].utime), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_decode_array_arena(buf, offset + pos, maxlen - pos, &(p[element].name), 1, arena);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].data = (int16_t*) zcm_arena_alloc(arena, sizeof(int16_t) * p[element].n);
+        if (!p[element].data && p[element].n > 0) return -1;
+        thislen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, p[element].data, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].tags = (char**) zcm_arena_alloc(arena, sizeof(char*) * p[element].n);
+        if (!p[element].tags && p[element].n > 0) return -1;
+        thislen = __string_decode_array_arena(buf, offset + pos, maxlen - pos, p[element].tags, p[element].n, arena);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].items = (arena_item*) zcm_arena_alloc(arena, sizeof(arena_item) * p[element].n);
+        if (!p[element].items && p[element].n > 0) return -1;
+        thislen = __arena_item_decode_array_arena(buf, offset + pos, maxlen - pos, p[element].items, p[element].n, arena);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int8_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].rows), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].grid = (float**) zcm_arena_alloc(arena, sizeof(float*) * p[element].rows);
+        if (!p[element].grid && p[element].rows > 0) return -1;
+        { int a;
+        for (a = 0; a < p[element].rows; a++) {
+            p[element].grid[a] = (float*) zcm_arena_alloc(arena, sizeof(float) * 2);
+            if (!p[element].grid[a] && 2 > 0) return -1;
+            thislen = __float_decode_array(buf, offset + pos, maxlen - pos, p[element].grid[a], 2);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+    }
+    return pos;
+}
+
+int arena1_decode_arena(const void *buf, int offset, int maxlen, arena1 *p, zcm_arena_t *arena)
+{
+    int pos = 0, thislen;
+    int64_t hash = __arena1_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena1_decode_array_arena(buf, offset + pos, maxlen - pos, p, 1, arena);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __arena1_clone_array(const arena1 *p, arena1 *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int64_t_clone_array(&(p[element].utime), &(q[element].utime), 1);
+
+        __string_clone_array(&(p[element].name), &(q[element].name), 1);
+
+        __int32_t_clone_array(&(p[element].n), &(q[element].n), 1);
+
+        q[element].data = (int16_t*) zcm_malloc(sizeof(int16_t) * q[element].n);
+        __int16_t_clone_array(p[element].data, q[element].data, p[element].n);
+
+        q[element].tags = (char**) zcm_malloc(sizeof(char*) * q[element].n);
+        __string_clone_array(p[element].tags, q[element].tags, p[element].n);
+
+        q[element].items = (arena_item*) zcm_malloc(sizeof(arena_item) * q[element].n);
+        __arena_item_clone_array(p[element].items, q[element].items, p[element].n);
+
+        __int8_t_clone_array(&(p[element].rows), &(q[element].rows), 1);
+
+        q[element].grid = (float**) zcm_malloc(sizeof(float*) * q[element].rows);
+        { int a;
+        for (a = 0; a < p[element].rows; a++) {
+            q[element].grid[a] = (float*) zcm_malloc(sizeof(float) * 2);
+            __float_clone_array(p[element].grid[a], q[element].grid[a], 2);
+        }
+        }
+
+    }
+    return 0;
+}
+
+arena1 *arena1_copy(const arena1 *p)
+{
+    arena1 *q = (arena1*) malloc(sizeof(arena1));
+    __arena1_clone_array(p, q, 1);
+    return q;
+}
+
+void arena1_destroy(arena1 *p)
+{
+    __arena1_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int arena1_publish(zcm_t *lc, const char *channel, const arena1 *p)
+{
+      int max_data_size = arena1_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = arena1_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _arena1_subscription_t {
+    arena1_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+    zcm_arena_t *arena;
+};
+static
+void arena1_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    arena1 p;
+    arena1_subscription_t *h = (arena1_subscription_t*) userdata;
+    memset(&p, 0, sizeof(arena1));
+    if (h->arena)
+        status = arena1_decode_arena (rbuf->data, 0, rbuf->data_size, &p, h->arena);
+    else
+        status = arena1_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding arena1!!!\n", status);
+        if (h->arena) zcm_arena_reset (h->arena);
+        return;
+    }
+
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    if (h->arena) zcm_arena_reset (h->arena);
+    else arena1_decode_cleanup (&p);
+}
+
+arena1_subscription_t* arena1_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    arena1_handler_t f, void *userdata)
+{
+    return arena1_subscribe_arena (zcm, channel, f, userdata, NULL);
+}
+
+arena1_subscription_t* arena1_subscribe_arena (zcm_t *zcm,
+                    const char *channel,
+                    arena1_handler_t f, void *userdata,
+                    zcm_arena_t *arena)
+{
+    arena1_subscription_t *n = (arena1_subscription_t*)
+                       malloc(sizeof(arena1_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->arena = arena;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              arena1_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg arena1 ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int arena1_unsubscribe(zcm_t *zcm, arena1_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe arena1_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
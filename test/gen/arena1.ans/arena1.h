@@ -0,0 +1,160 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _arena1_h
+#define _arena1_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "arena_item.h"
+typedef struct _arena1 arena1;
+struct _arena1
+{
+    int64_t    utime;
+    char*      name;
+    int32_t    n;
+    int16_t    *data;
+    char*      *tags;
+    arena_item *items;
+    int8_t     rows;
+    float      **grid;
+};
+
+/**
+ * Create a deep copy of a arena1.
+ * When no longer needed, destroy it with arena1_destroy()
+ */
+arena1* arena1_copy(const arena1* to_copy);
+
+/**
+ * Destroy an instance of arena1 created by arena1_copy()
+ */
+void arena1_destroy(arena1* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _arena1_subscription_t arena1_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * arena1 is received.
+ */
+typedef void(*arena1_handler_t)(const zcm_recv_buf_t *rbuf,
+             const char *channel, const arena1 *msg, void *userdata);
+
+/**
+ * Publish a message of type arena1 using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int arena1_publish(zcm_t *zcm, const char *channel, const arena1 *msg);
+
+/**
+ * Subscribe to messages of type arena1 using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to arena1_unsubscribe.
+ */
+arena1_subscription_t* arena1_subscribe(zcm_t *zcm, const char *channel, arena1_handler_t handler, void *userdata);
+
+/**
+ * Same as arena1_subscribe(), except that every message is decoded with
+ * arena1_decode_arena() into @p arena, and the arena is reset as soon as
+ * @p handler returns. Messages whose strings and variable-length arrays
+ * do not fit in the arena are dropped. Passing a NULL @p arena is the same
+ * as calling arena1_subscribe().
+ */
+arena1_subscription_t* arena1_subscribe_arena(zcm_t *zcm, const char *channel, arena1_handler_t handler, void *userdata, zcm_arena_t *arena);
+
+/**
+ * Removes and destroys a subscription created by arena1_subscribe()
+ */
+int arena1_unsubscribe(zcm_t *zcm, arena1_subscription_t* hid);
+/**
+ * Encode a message of type arena1 into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to arena1_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int arena1_encode(void *buf, int offset, int maxlen, const arena1 *p);
+
+/**
+ * Decode a message of type arena1 from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with arena1_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int arena1_decode(const void *buf, int offset, int maxlen, arena1 *msg);
+
+/**
+ * Release resources allocated by arena1_decode()
+ * @return 0
+ */
+int arena1_decode_cleanup(arena1 *p);
+
+/**
+ * Decode a message of type arena1 from binary form, allocating all strings
+ * and variable-length arrays from @p arena instead of the heap. The decoded
+ * message must not be passed to arena1_decode_cleanup(): it remains valid
+ * until the arena is reset.
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @param arena The arena to allocate from
+ * @return The number of bytes decoded, or <0 if an error occured
+ *         (including running out of arena space).
+ */
+int arena1_decode_arena(const void *buf, int offset, int maxlen, arena1 *msg, zcm_arena_t *arena);
+
+/**
+ * Check how many bytes are required to encode a message of type arena1
+ */
+int arena1_encoded_size(const arena1 *p);
+
+// ZCM support functions. Users should not call these
+int64_t __arena1_get_hash(void);
+uint64_t __arena1_hash_recursive(const __zcm_hash_ptr *p);
+int     __arena1_encode_array(void *buf, int offset, int maxlen, const arena1 *p, int elements);
+int     __arena1_decode_array(const void *buf, int offset, int maxlen, arena1 *p, int elements);
+int     __arena1_decode_array_cleanup(arena1 *p, int elements);
+int     __arena1_decode_array_arena(const void *buf, int offset, int maxlen, arena1 *p, int elements, zcm_arena_t *arena);
+int     __arena1_encoded_array_size(const arena1 *p, int elements);
+int     __arena1_clone_array(const arena1 *p, arena1 *q, int elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
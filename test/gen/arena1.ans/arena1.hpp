@@ -0,0 +1,273 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+ * BY HAND!!
+ *
+ * Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+
+#ifndef __arena1_hpp__
+#define __arena1_hpp__
+
+#include <string>
+#include <vector>
+#include "arena_item.hpp"
+
+
+class arena1
+{
+    public:
+        int64_t    utime;
+
+        std::string name;
+
+        int32_t    n;
+
+        std::vector< int16_t > data;
+
+        std::vector< std::string > tags;
+
+        std::vector< arena_item > items;
+
+        int8_t     rows;
+
+        std::vector< std::vector< float > > grid;
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~arena1() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void *buf, int offset, int maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline int getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "arena1"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int _encodeNoHash(void *buf, int offset, int maxlen) const;
+        inline int _getEncodedSizeNoHash() const;
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr *p);
+        // Caller guarantees that buf holds at least _getEncodedSizeNoHash() bytes
+        inline int _encodeNoHashUnchecked(void *buf, int offset) const;
+
+        // Encoded size of this type (without hash) if it never varies, -1 otherwise
+        enum { _fixedEncodedSizeNoHash = -1 };
+};
+
+int arena1::encode(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+    int64_t hash = (int64_t)getHash();
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int arena1::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int arena1::getEncodedSize() const
+{
+    return 8 + _getEncodedSizeNoHash();
+}
+
+int64_t arena1::getHash()
+{
+    static int64_t hash = _computeHash(NULL);
+    return hash;
+}
+
+const char* arena1::getTypeName()
+{
+    return "arena1";
+}
+
+int arena1::_encodeNoHash(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &this->utime, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    char* name_cstr = (char*) this->name.c_str();
+    tlen = __string_encode_array(buf, offset + pos, maxlen - pos, &name_cstr, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &this->n, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    if(this->n > 0) {
+        tlen = __int16_t_encode_array(buf, offset + pos, maxlen - pos, &this->data[0], this->n);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < this->n; a0++) {
+        char* __cstr = (char*) this->tags[a0].c_str();
+        tlen = __string_encode_array(buf, offset + pos, maxlen - pos, &__cstr, 1);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < this->n; a0++) {
+        tlen = this->items[a0]._encodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    tlen = __int8_t_encode_array(buf, offset + pos, maxlen - pos, &this->rows, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    for (int a0 = 0; a0 < this->rows; a0++) {
+        tlen = __float_encode_array(buf, offset + pos, maxlen - pos, &this->grid[a0][0], 2);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    return pos;
+}
+
+int arena1::_encodeNoHashUnchecked(void *buf, int offset) const
+{
+    return this->_encodeNoHash(buf, offset, 0x7fffffff - offset);
+}
+
+int arena1::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+
+    tlen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this->utime, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    int32_t __name_len__;
+    tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &__name_len__, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+    if(__name_len__ > maxlen - pos) return -1;
+    this->name.assign(((const char*)buf) + offset + pos, __name_len__ - 1);
+    pos += __name_len__;
+
+    tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &this->n, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    if(this->n > 0) {
+        this->data.resize(this->n);
+        tlen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, &this->data[0], this->n);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    this->tags.resize(this->n);
+    for (int a0 = 0; a0 < this->n; a0++) {
+        int32_t __elem_len;
+        tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &__elem_len, 1);
+        if(tlen < 0) return tlen; else pos += tlen;
+        if(__elem_len > maxlen - pos) return -1;
+        this->tags[a0].assign(((const char*)buf) + offset + pos, __elem_len -  1);
+        pos += __elem_len;
+    }
+
+    this->items.resize(this->n);
+    for (int a0 = 0; a0 < this->n; a0++) {
+        tlen = this->items[a0]._decodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    tlen = __int8_t_decode_array(buf, offset + pos, maxlen - pos, &this->rows, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    this->grid.resize(this->rows);
+    for (int a0 = 0; a0 < this->rows; a0++) {
+        if(2 > 0) {
+            this->grid[a0].resize(2);
+            tlen = __float_decode_array(buf, offset + pos, maxlen - pos, &this->grid[a0][0], 2);
+            if(tlen < 0) return tlen; else pos += tlen;
+        }
+    }
+
+    return pos;
+}
+
+int arena1::_getEncodedSizeNoHash() const
+{
+    int enc_size = 0;
+    enc_size += __int64_t_encoded_array_size(NULL, 1);
+    enc_size += this->name.size() + 4 + 1;
+    enc_size += __int32_t_encoded_array_size(NULL, 1);
+    enc_size += __int16_t_encoded_array_size(NULL, this->n);
+    for (int a0 = 0; a0 < this->n; a0++) {
+        enc_size += this->tags[a0].size() + 4 + 1;
+    }
+    if (arena_item::_fixedEncodedSizeNoHash >= 0) enc_size += this->n * arena_item::_fixedEncodedSizeNoHash;
+    else {
+        for (int a0 = 0; a0 < this->n; a0++) {
+            enc_size += this->items[a0]._getEncodedSizeNoHash();
+        }
+    }
+    enc_size += __int8_t_encoded_array_size(NULL, 1);
+    enc_size += this->rows * __float_encoded_array_size(NULL, 2);
+    return enc_size;
+}
+
+uint64_t arena1::_computeHash(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for(fp = p; fp != NULL; fp = fp->parent)
+        if(fp->v == arena1::getHash)
+            return 0;
+    const __zcm_hash_ptr cp = { p, (void*)arena1::getHash };
+
+    uint64_t hash = (uint64_t)0xf49b3a51e03f6f5eLL +
+         arena_item::_computeHash(&cp);
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+#endif
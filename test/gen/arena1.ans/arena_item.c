@@ -0,0 +1,303 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "arena_item.h"
+
+static int __arena_item_hash_computed;
+static uint64_t __arena_item_hash;
+
+uint64_t __arena_item_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __arena_item_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__arena_item_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x4e0209efa677fe2fLL
+         + __string_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __arena_item_get_hash(void)
+{
+    if (!__arena_item_hash_computed) {
+        __arena_item_hash = (int64_t)__arena_item_hash_recursive(NULL);
+        __arena_item_hash_computed = 1;
+    }
+
+    return __arena_item_hash;
+}
+
+int __arena_item_encode_array(void *buf, int offset, int maxlen, const arena_item *p, int elements)
+{
+    int pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, &(p[element].label), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __double_encode_array(buf, offset + pos, maxlen - pos, p[element].values, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int arena_item_encode(void *buf, int offset, int maxlen, const arena_item *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __arena_item_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __arena_item_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __arena_item_encoded_array_size(const arena_item *p, int elements)
+{
+    int size = 0, element;
+    for (element = 0; element < elements; element++) {
+
+        size += __string_encoded_array_size(&(p[element].label), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].n), 1);
+
+        size += __double_encoded_array_size(p[element].values, p[element].n);
+
+    }
+    return size;
+}
+
+int arena_item_encoded_size(const arena_item *p)
+{
+    return 8 + __arena_item_encoded_array_size(p, 1);
+}
+
+int __arena_item_decode_array(const void *buf, int offset, int maxlen, arena_item *p, int elements)
+{
+    int pos = 0, thislen, element;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, &(p[element].label), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].values = (double*) zcm_malloc(sizeof(double) * p[element].n);
+        thislen = __double_decode_array(buf, offset + pos, maxlen - pos, p[element].values, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __arena_item_decode_array_cleanup(arena_item *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __string_decode_array_cleanup(&(p[element].label), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].n), 1);
+
+        __double_decode_array_cleanup(p[element].values, p[element].n);
+        if (p[element].values) free(p[element].values);
+
+    }
+    return 0;
+}
+
+int arena_item_decode(const void *buf, int offset, int maxlen, arena_item *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __arena_item_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena_item_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int arena_item_decode_cleanup(arena_item *p)
+{
+    return __arena_item_decode_array_cleanup(p, 1);
+}
+
+int __arena_item_decode_array_arena(const void *buf, int offset, int maxlen, arena_item *p, int elements, zcm_arena_t *arena)
+{
+    int pos = 0, thislen, element;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __string_decode_array_arena(buf, offset + pos, maxlen - pos, &(p[element].label), 1, arena);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].values = (double*) zcm_arena_alloc(arena, sizeof(double) * p[element].n);
+        if (!p[element].values && p[element].n > 0) return -1;
+        thislen = __double_decode_array(buf, offset + pos, maxlen - pos, p[element].values, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int arena_item_decode_arena(const void *buf, int offset, int maxlen, arena_item *p, zcm_arena_t *arena)
+{
+    int pos = 0, thislen;
+    int64_t hash = __arena_item_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena_item_decode_array_arena(buf, offset + pos, maxlen - pos, p, 1, arena);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __arena_item_clone_array(const arena_item *p, arena_item *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __string_clone_array(&(p[element].label), &(q[element].label), 1);
+
+        __int32_t_clone_array(&(p[element].n), &(q[element].n), 1);
+
+        q[element].values = (double*) zcm_malloc(sizeof(double) * q[element].n);
+        __double_clone_array(p[element].values, q[element].values, p[element].n);
+
+    }
+    return 0;
+}
+
+arena_item *arena_item_copy(const arena_item *p)
+{
+    arena_item *q = (arena_item*) malloc(sizeof(arena_item));
+    __arena_item_clone_array(p, q, 1);
+    return q;
+}
+
+void arena_item_destroy(arena_item *p)
+{
+    __arena_item_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int arena_item_publish(zcm_t *lc, const char *channel, const arena_item *p)
+{
+      int max_data_size = arena_item_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = arena_item_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _arena_item_subscription_t {
+    arena_item_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+    zcm_arena_t *arena;
+};
+static
+void arena_item_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    arena_item p;
+    arena_item_subscription_t *h = (arena_item_subscription_t*) userdata;
+    memset(&p, 0, sizeof(arena_item));
+    if (h->arena)
+        status = arena_item_decode_arena (rbuf->data, 0, rbuf->data_size, &p, h->arena);
+    else
+        status = arena_item_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding arena_item!!!\n", status);
+        if (h->arena) zcm_arena_reset (h->arena);
+        return;
+    }
+
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    if (h->arena) zcm_arena_reset (h->arena);
+    else arena_item_decode_cleanup (&p);
+}
+
+arena_item_subscription_t* arena_item_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    arena_item_handler_t f, void *userdata)
+{
+    return arena_item_subscribe_arena (zcm, channel, f, userdata, NULL);
+}
+
+arena_item_subscription_t* arena_item_subscribe_arena (zcm_t *zcm,
+                    const char *channel,
+                    arena_item_handler_t f, void *userdata,
+                    zcm_arena_t *arena)
+{
+    arena_item_subscription_t *n = (arena_item_subscription_t*)
+                       malloc(sizeof(arena_item_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->arena = arena;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              arena_item_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg arena_item ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int arena_item_unsubscribe(zcm_t *zcm, arena_item_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe arena_item_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
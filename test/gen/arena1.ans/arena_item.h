@@ -0,0 +1,154 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _arena_item_h
+#define _arena_item_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _arena_item arena_item;
+struct _arena_item
+{
+    char*      label;
+    int32_t    n;
+    double     *values;
+};
+
+/**
+ * Create a deep copy of a arena_item.
+ * When no longer needed, destroy it with arena_item_destroy()
+ */
+arena_item* arena_item_copy(const arena_item* to_copy);
+
+/**
+ * Destroy an instance of arena_item created by arena_item_copy()
+ */
+void arena_item_destroy(arena_item* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _arena_item_subscription_t arena_item_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * arena_item is received.
+ */
+typedef void(*arena_item_handler_t)(const zcm_recv_buf_t *rbuf,
+             const char *channel, const arena_item *msg, void *userdata);
+
+/**
+ * Publish a message of type arena_item using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int arena_item_publish(zcm_t *zcm, const char *channel, const arena_item *msg);
+
+/**
+ * Subscribe to messages of type arena_item using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to arena_item_unsubscribe.
+ */
+arena_item_subscription_t* arena_item_subscribe(zcm_t *zcm, const char *channel, arena_item_handler_t handler, void *userdata);
+
+/**
+ * Same as arena_item_subscribe(), except that every message is decoded with
+ * arena_item_decode_arena() into @p arena, and the arena is reset as soon as
+ * @p handler returns. Messages whose strings and variable-length arrays
+ * do not fit in the arena are dropped. Passing a NULL @p arena is the same
+ * as calling arena_item_subscribe().
+ */
+arena_item_subscription_t* arena_item_subscribe_arena(zcm_t *zcm, const char *channel, arena_item_handler_t handler, void *userdata, zcm_arena_t *arena);
+
+/**
+ * Removes and destroys a subscription created by arena_item_subscribe()
+ */
+int arena_item_unsubscribe(zcm_t *zcm, arena_item_subscription_t* hid);
+/**
+ * Encode a message of type arena_item into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to arena_item_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int arena_item_encode(void *buf, int offset, int maxlen, const arena_item *p);
+
+/**
+ * Decode a message of type arena_item from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with arena_item_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int arena_item_decode(const void *buf, int offset, int maxlen, arena_item *msg);
+
+/**
+ * Release resources allocated by arena_item_decode()
+ * @return 0
+ */
+int arena_item_decode_cleanup(arena_item *p);
+
+/**
+ * Decode a message of type arena_item from binary form, allocating all strings
+ * and variable-length arrays from @p arena instead of the heap. The decoded
+ * message must not be passed to arena_item_decode_cleanup(): it remains valid
+ * until the arena is reset.
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @param arena The arena to allocate from
+ * @return The number of bytes decoded, or <0 if an error occured
+ *         (including running out of arena space).
+ */
+int arena_item_decode_arena(const void *buf, int offset, int maxlen, arena_item *msg, zcm_arena_t *arena);
+
+/**
+ * Check how many bytes are required to encode a message of type arena_item
+ */
+int arena_item_encoded_size(const arena_item *p);
+
+// ZCM support functions. Users should not call these
+int64_t __arena_item_get_hash(void);
+uint64_t __arena_item_hash_recursive(const __zcm_hash_ptr *p);
+int     __arena_item_encode_array(void *buf, int offset, int maxlen, const arena_item *p, int elements);
+int     __arena_item_decode_array(const void *buf, int offset, int maxlen, arena_item *p, int elements);
+int     __arena_item_decode_array_cleanup(arena_item *p, int elements);
+int     __arena_item_decode_array_arena(const void *buf, int offset, int maxlen, arena_item *p, int elements, zcm_arena_t *arena);
+int     __arena_item_encoded_array_size(const arena_item *p, int elements);
+int     __arena_item_clone_array(const arena_item *p, arena_item *q, int elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
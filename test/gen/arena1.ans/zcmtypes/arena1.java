@@ -0,0 +1,169 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class arena1 implements zcm.zcm.ZCMEncodable
+{
+    public long utime;
+    public String name;
+    public int n;
+    public short data[];
+    public String tags[];
+    public zcmtypes.arena_item items[];
+    public byte rows;
+    public float grid[][];
+ 
+    public arena1()
+    {
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0xf49b3a51e03f6f5eL;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.arena1.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.arena1.class);
+        long hash = ZCM_FINGERPRINT_BASE
+             + zcmtypes.arena_item._hashRecursive(classes)
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        char[] __strbuf = null;
+        outs.writeLong(this.utime); 
+ 
+        __strbuf = new char[this.name.length()]; this.name.getChars(0, this.name.length(), __strbuf, 0); outs.writeInt(__strbuf.length+1); for (int _i = 0; _i < __strbuf.length; _i++) outs.write(__strbuf[_i]); outs.writeByte(0); 
+ 
+        outs.writeInt(this.n); 
+ 
+        for (int a = 0; a < this.n; a++) {
+            outs.writeShort(this.data[a]); 
+        }
+ 
+        for (int a = 0; a < this.n; a++) {
+            __strbuf = new char[this.tags[a].length()]; this.tags[a].getChars(0, this.tags[a].length(), __strbuf, 0); outs.writeInt(__strbuf.length+1); for (int _i = 0; _i < __strbuf.length; _i++) outs.write(__strbuf[_i]); outs.writeByte(0); 
+        }
+ 
+        for (int a = 0; a < this.n; a++) {
+            this.items[a]._encodeRecursive(outs); 
+        }
+ 
+        outs.writeByte(this.rows); 
+ 
+        for (int a = 0; a < this.rows; a++) {
+            for (int b = 0; b < 2; b++) {
+                outs.writeFloat(this.grid[a][b]); 
+            }
+        }
+ 
+    }
+ 
+    public arena1(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public arena1(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.arena1 _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.arena1 o = new zcmtypes.arena1();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        char[] __strbuf = null;
+        this.utime = ins.readLong();
+ 
+        __strbuf = new char[ins.readInt()-1]; for (int _i = 0; _i < __strbuf.length; _i++) __strbuf[_i] = (char) (ins.readByte()&0xff); ins.readByte(); this.name = new String(__strbuf);
+ 
+        this.n = ins.readInt();
+ 
+        this.data = new short[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            this.data[a] = ins.readShort();
+        }
+ 
+        this.tags = new String[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            __strbuf = new char[ins.readInt()-1]; for (int _i = 0; _i < __strbuf.length; _i++) __strbuf[_i] = (char) (ins.readByte()&0xff); ins.readByte(); this.tags[a] = new String(__strbuf);
+        }
+ 
+        this.items = new zcmtypes.arena_item[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            this.items[a] = zcmtypes.arena_item._decodeRecursiveFactory(ins);
+        }
+ 
+        this.rows = ins.readByte();
+ 
+        this.grid = new float[(int) rows][(int) 2];
+        for (int a = 0; a < this.rows; a++) {
+            for (int b = 0; b < 2; b++) {
+                this.grid[a][b] = ins.readFloat();
+            }
+        }
+ 
+    }
+ 
+    public zcmtypes.arena1 copy()
+    {
+        zcmtypes.arena1 outobj = new zcmtypes.arena1();
+        outobj.utime = this.utime;
+ 
+        outobj.name = this.name;
+ 
+        outobj.n = this.n;
+ 
+        outobj.data = new short[(int) n];
+        if (this.n > 0)
+            System.arraycopy(this.data, 0, outobj.data, 0, this.n); 
+        outobj.tags = new String[(int) n];
+        if (this.n > 0)
+            System.arraycopy(this.tags, 0, outobj.tags, 0, this.n); 
+        outobj.items = new zcmtypes.arena_item[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            outobj.items[a] = this.items[a].copy();
+        }
+ 
+        outobj.rows = this.rows;
+ 
+        outobj.grid = new float[(int) rows][(int) 2];
+        for (int a = 0; a < this.rows; a++) {
+            System.arraycopy(this.grid[a], 0, outobj.grid[a], 0, 2);        }
+ 
+        return outobj;
+    }
+ 
+}
+
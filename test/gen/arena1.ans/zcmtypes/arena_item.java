@@ -0,0 +1,108 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class arena_item implements zcm.zcm.ZCMEncodable
+{
+    public String label;
+    public int n;
+    public double values[];
+ 
+    public arena_item()
+    {
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0x4e0209efa677fe2fL;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.arena_item.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.arena_item.class);
+        long hash = ZCM_FINGERPRINT_BASE
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        char[] __strbuf = null;
+        __strbuf = new char[this.label.length()]; this.label.getChars(0, this.label.length(), __strbuf, 0); outs.writeInt(__strbuf.length+1); for (int _i = 0; _i < __strbuf.length; _i++) outs.write(__strbuf[_i]); outs.writeByte(0); 
+ 
+        outs.writeInt(this.n); 
+ 
+        for (int a = 0; a < this.n; a++) {
+            outs.writeDouble(this.values[a]); 
+        }
+ 
+    }
+ 
+    public arena_item(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public arena_item(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.arena_item _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.arena_item o = new zcmtypes.arena_item();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        char[] __strbuf = null;
+        __strbuf = new char[ins.readInt()-1]; for (int _i = 0; _i < __strbuf.length; _i++) __strbuf[_i] = (char) (ins.readByte()&0xff); ins.readByte(); this.label = new String(__strbuf);
+ 
+        this.n = ins.readInt();
+ 
+        this.values = new double[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            this.values[a] = ins.readDouble();
+        }
+ 
+    }
+ 
+    public zcmtypes.arena_item copy()
+    {
+        zcmtypes.arena_item outobj = new zcmtypes.arena_item();
+        outobj.label = this.label;
+ 
+        outobj.n = this.n;
+ 
+        outobj.values = new double[(int) n];
+        if (this.n > 0)
+            System.arraycopy(this.values, 0, outobj.values, 0, this.n); 
+        return outobj;
+    }
+ 
+}
+
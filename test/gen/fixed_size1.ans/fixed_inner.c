@@ -0,0 +1,241 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "fixed_inner.h"
+
+static int __fixed_inner_hash_computed;
+static uint64_t __fixed_inner_hash;
+
+uint64_t __fixed_inner_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __fixed_inner_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__fixed_inner_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0xbb071e2c8a6bbd0dLL
+         + __int16_t_hash_recursive(&cp)
+         + __float_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __fixed_inner_get_hash(void)
+{
+    if (!__fixed_inner_hash_computed) {
+        __fixed_inner_hash = (int64_t)__fixed_inner_hash_recursive(NULL);
+        __fixed_inner_hash_computed = 1;
+    }
+
+    return __fixed_inner_hash;
+}
+
+int __fixed_inner_encode_array(void *buf, int offset, int maxlen, const fixed_inner *p, int elements)
+{
+    uint8_t *data = (uint8_t*) buf + offset;
+    int pos = 0, element;
+
+    if (maxlen < elements * (FIXED_INNER_ENCODED_SIZE - 8)) return -1;
+
+#ifdef __ZCM_BIG_ENDIAN_HOST
+    if (sizeof(fixed_inner) == (FIXED_INNER_ENCODED_SIZE - 8)) {
+        memcpy(data, p, elements * (FIXED_INNER_ENCODED_SIZE - 8));
+        return elements * (FIXED_INNER_ENCODED_SIZE - 8);
+    }
+#endif
+
+    for (element = 0; element < elements; element++) {
+        __zcm_encode_be(data + pos, &p[element].a, 1, 2);
+        pos += 2;
+        __zcm_encode_be(data + pos, &p[element].b[0], 3, 4);
+        pos += 12;
+    }
+    return pos;
+}
+
+int fixed_inner_encode(void *buf, int offset, int maxlen, const fixed_inner *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __fixed_inner_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __fixed_inner_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __fixed_inner_encoded_array_size(const fixed_inner *p, int elements)
+{
+    (void)p;
+    return elements * (FIXED_INNER_ENCODED_SIZE - 8);
+}
+
+int fixed_inner_encoded_size(const fixed_inner *p)
+{
+    return 8 + __fixed_inner_encoded_array_size(p, 1);
+}
+
+int __fixed_inner_decode_array(const void *buf, int offset, int maxlen, fixed_inner *p, int elements)
+{
+    const uint8_t *data = (const uint8_t*) buf + offset;
+    int pos = 0, element;
+
+    if (maxlen < elements * (FIXED_INNER_ENCODED_SIZE - 8)) return -1;
+
+#ifdef __ZCM_BIG_ENDIAN_HOST
+    if (sizeof(fixed_inner) == (FIXED_INNER_ENCODED_SIZE - 8)) {
+        memcpy(p, data, elements * (FIXED_INNER_ENCODED_SIZE - 8));
+        return elements * (FIXED_INNER_ENCODED_SIZE - 8);
+    }
+#endif
+
+    for (element = 0; element < elements; element++) {
+        __zcm_decode_be(&p[element].a, data + pos, 1, 2);
+        pos += 2;
+        __zcm_decode_be(&p[element].b[0], data + pos, 3, 4);
+        pos += 12;
+    }
+    return pos;
+}
+
+int __fixed_inner_decode_array_cleanup(fixed_inner *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int16_t_decode_array_cleanup(&(p[element].a), 1);
+
+        __float_decode_array_cleanup(p[element].b, 3);
+
+    }
+    return 0;
+}
+
+int fixed_inner_decode(const void *buf, int offset, int maxlen, fixed_inner *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __fixed_inner_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __fixed_inner_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int fixed_inner_decode_cleanup(fixed_inner *p)
+{
+    return __fixed_inner_decode_array_cleanup(p, 1);
+}
+
+int __fixed_inner_clone_array(const fixed_inner *p, fixed_inner *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int16_t_clone_array(&(p[element].a), &(q[element].a), 1);
+
+        __float_clone_array(p[element].b, q[element].b, 3);
+
+    }
+    return 0;
+}
+
+fixed_inner *fixed_inner_copy(const fixed_inner *p)
+{
+    fixed_inner *q = (fixed_inner*) malloc(sizeof(fixed_inner));
+    __fixed_inner_clone_array(p, q, 1);
+    return q;
+}
+
+void fixed_inner_destroy(fixed_inner *p)
+{
+    __fixed_inner_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int fixed_inner_publish(zcm_t *lc, const char *channel, const fixed_inner *p)
+{
+      int max_data_size = fixed_inner_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = fixed_inner_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _fixed_inner_subscription_t {
+    fixed_inner_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+};
+static
+void fixed_inner_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    fixed_inner p;
+    memset(&p, 0, sizeof(fixed_inner));
+    status = fixed_inner_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding fixed_inner!!!\n", status);
+        return;
+    }
+
+    fixed_inner_subscription_t *h = (fixed_inner_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    fixed_inner_decode_cleanup (&p);
+}
+
+fixed_inner_subscription_t* fixed_inner_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    fixed_inner_handler_t f, void *userdata)
+{
+    fixed_inner_subscription_t *n = (fixed_inner_subscription_t*)
+                       malloc(sizeof(fixed_inner_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              fixed_inner_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg fixed_inner ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int fixed_inner_unsubscribe(zcm_t *zcm, fixed_inner_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe fixed_inner_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,132 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _fixed_inner_h
+#define _fixed_inner_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _fixed_inner fixed_inner;
+struct _fixed_inner
+{
+    int16_t    a;
+    float      b[3];
+};
+
+/**
+ * Every fixed_inner encodes to exactly this many bytes (including the hash)
+ */
+#define FIXED_INNER_ENCODED_SIZE 22
+
+/**
+ * Create a deep copy of a fixed_inner.
+ * When no longer needed, destroy it with fixed_inner_destroy()
+ */
+fixed_inner* fixed_inner_copy(const fixed_inner* to_copy);
+
+/**
+ * Destroy an instance of fixed_inner created by fixed_inner_copy()
+ */
+void fixed_inner_destroy(fixed_inner* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _fixed_inner_subscription_t fixed_inner_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * fixed_inner is received.
+ */
+typedef void(*fixed_inner_handler_t)(const zcm_recv_buf_t *rbuf,
+             const char *channel, const fixed_inner *msg, void *userdata);
+
+/**
+ * Publish a message of type fixed_inner using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int fixed_inner_publish(zcm_t *zcm, const char *channel, const fixed_inner *msg);
+
+/**
+ * Subscribe to messages of type fixed_inner using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to fixed_inner_unsubscribe.
+ */
+fixed_inner_subscription_t* fixed_inner_subscribe(zcm_t *zcm, const char *channel, fixed_inner_handler_t handler, void *userdata);
+
+/**
+ * Removes and destroys a subscription created by fixed_inner_subscribe()
+ */
+int fixed_inner_unsubscribe(zcm_t *zcm, fixed_inner_subscription_t* hid);
+/**
+ * Encode a message of type fixed_inner into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to fixed_inner_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int fixed_inner_encode(void *buf, int offset, int maxlen, const fixed_inner *p);
+
+/**
+ * Decode a message of type fixed_inner from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with fixed_inner_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int fixed_inner_decode(const void *buf, int offset, int maxlen, fixed_inner *msg);
+
+/**
+ * Release resources allocated by fixed_inner_decode()
+ * @return 0
+ */
+int fixed_inner_decode_cleanup(fixed_inner *p);
+
+/**
+ * Check how many bytes are required to encode a message of type fixed_inner
+ */
+int fixed_inner_encoded_size(const fixed_inner *p);
+
+// ZCM support functions. Users should not call these
+int64_t __fixed_inner_get_hash(void);
+uint64_t __fixed_inner_hash_recursive(const __zcm_hash_ptr *p);
+int     __fixed_inner_encode_array(void *buf, int offset, int maxlen, const fixed_inner *p, int elements);
+int     __fixed_inner_decode_array(const void *buf, int offset, int maxlen, fixed_inner *p, int elements);
+int     __fixed_inner_decode_array_cleanup(fixed_inner *p, int elements);
+int     __fixed_inner_encoded_array_size(const fixed_inner *p, int elements);
+int     __fixed_inner_clone_array(const fixed_inner *p, fixed_inner *q, int elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+ * BY HAND!!
+ *
+ * Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+
+#ifndef __fixed_inner_hpp__
+#define __fixed_inner_hpp__
+
+
+
+class fixed_inner
+{
+    public:
+        int16_t    a;
+
+        float      b[3];
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~fixed_inner() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void *buf, int offset, int maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline int getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "fixed_inner"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int _encodeNoHash(void *buf, int offset, int maxlen) const;
+        inline int _getEncodedSizeNoHash() const;
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr *p);
+        // Caller guarantees that buf holds at least _getEncodedSizeNoHash() bytes
+        inline int _encodeNoHashUnchecked(void *buf, int offset) const;
+
+        // Encoded size of this type (without hash) if it never varies, -1 otherwise
+        enum { _fixedEncodedSizeNoHash = 14 };
+};
+
+int fixed_inner::encode(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+    int64_t hash = (int64_t)getHash();
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int fixed_inner::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int fixed_inner::getEncodedSize() const
+{
+    return 8 + _getEncodedSizeNoHash();
+}
+
+int64_t fixed_inner::getHash()
+{
+    static int64_t hash = _computeHash(NULL);
+    return hash;
+}
+
+const char* fixed_inner::getTypeName()
+{
+    return "fixed_inner";
+}
+
+int fixed_inner::_encodeNoHash(void *buf, int offset, int maxlen) const
+{
+    if (_fixedEncodedSizeNoHash >= 0) {
+        if (maxlen < _fixedEncodedSizeNoHash) return -1;
+        return this->_encodeNoHashUnchecked(buf, offset);
+    }
+
+    int pos = 0, tlen;
+
+    tlen = __int16_t_encode_array(buf, offset + pos, maxlen - pos, &this->a, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __float_encode_array(buf, offset + pos, maxlen - pos, &this->b[0], 3);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int fixed_inner::_encodeNoHashUnchecked(void *buf, int offset) const
+{
+    uint8_t *p = (uint8_t*) buf + offset;
+    int pos = 0;
+
+    __zcm_encode_be(p + pos, &this->a, 1, 2);
+    pos += 2;
+    __zcm_encode_be(p + pos, &this->b[0], 3, 4);
+    pos += 12;
+
+    return pos;
+}
+
+int fixed_inner::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+
+    tlen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, &this->a, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __float_decode_array(buf, offset + pos, maxlen - pos, &this->b[0], 3);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int fixed_inner::_getEncodedSizeNoHash() const
+{
+    if (_fixedEncodedSizeNoHash >= 0) return _fixedEncodedSizeNoHash;
+    int enc_size = 0;
+    enc_size += __int16_t_encoded_array_size(NULL, 1);
+    enc_size += __float_encoded_array_size(NULL, 3);
+    return enc_size;
+}
+
+uint64_t fixed_inner::_computeHash(const __zcm_hash_ptr *)
+{
+    uint64_t hash = (uint64_t)0xbb071e2c8a6bbd0dLL;
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+#endif
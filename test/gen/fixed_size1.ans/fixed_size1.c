@@ -0,0 +1,294 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "fixed_size1.h"
+
+static int __fixed_size1_hash_computed;
+static uint64_t __fixed_size1_hash;
+
+uint64_t __fixed_size1_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __fixed_size1_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__fixed_size1_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0xa47ab3501d068511LL
+         + __int64_t_hash_recursive(&cp)
+         + __fixed_inner_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __boolean_hash_recursive(&cp)
+         + __byte_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __fixed_size1_get_hash(void)
+{
+    if (!__fixed_size1_hash_computed) {
+        __fixed_size1_hash = (int64_t)__fixed_size1_hash_recursive(NULL);
+        __fixed_size1_hash_computed = 1;
+    }
+
+    return __fixed_size1_hash;
+}
+
+int __fixed_size1_encode_array(void *buf, int offset, int maxlen, const fixed_size1 *p, int elements)
+{
+    int pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].utime), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __fixed_inner_encode_array(buf, offset + pos, maxlen - pos, p[element].inner, 4);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            thislen = __double_encode_array(buf, offset + pos, maxlen - pos, p[element].m[a], 2);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+        thislen = __boolean_encode_array(buf, offset + pos, maxlen - pos, &(p[element].ok), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __byte_encode_array(buf, offset + pos, maxlen - pos, p[element].raw, 8);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int fixed_size1_encode(void *buf, int offset, int maxlen, const fixed_size1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __fixed_size1_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __fixed_size1_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __fixed_size1_encoded_array_size(const fixed_size1 *p, int elements)
+{
+    int size = 0, element;
+    for (element = 0; element < elements; element++) {
+
+        size += __int64_t_encoded_array_size(&(p[element].utime), 1);
+
+        size += __fixed_inner_encoded_array_size(p[element].inner, 4);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            size += __double_encoded_array_size(p[element].m[a], 2);
+        }
+        }
+
+        size += __boolean_encoded_array_size(&(p[element].ok), 1);
+
+        size += __byte_encoded_array_size(p[element].raw, 8);
+
+    }
+    return size;
+}
+
+int fixed_size1_encoded_size(const fixed_size1 *p)
+{
+    return 8 + __fixed_size1_encoded_array_size(p, 1);
+}
+
+int __fixed_size1_decode_array(const void *buf, int offset, int maxlen, fixed_size1 *p, int elements)
+{
+    int pos = 0, thislen, element;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].utime), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __fixed_inner_decode_array(buf, offset + pos, maxlen - pos, p[element].inner, 4);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            thislen = __double_decode_array(buf, offset + pos, maxlen - pos, p[element].m[a], 2);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+        thislen = __boolean_decode_array(buf, offset + pos, maxlen - pos, &(p[element].ok), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __byte_decode_array(buf, offset + pos, maxlen - pos, p[element].raw, 8);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __fixed_size1_decode_array_cleanup(fixed_size1 *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int64_t_decode_array_cleanup(&(p[element].utime), 1);
+
+        __fixed_inner_decode_array_cleanup(p[element].inner, 4);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            __double_decode_array_cleanup(p[element].m[a], 2);
+        }
+        }
+
+        __boolean_decode_array_cleanup(&(p[element].ok), 1);
+
+        __byte_decode_array_cleanup(p[element].raw, 8);
+
+    }
+    return 0;
+}
+
+int fixed_size1_decode(const void *buf, int offset, int maxlen, fixed_size1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __fixed_size1_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __fixed_size1_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int fixed_size1_decode_cleanup(fixed_size1 *p)
+{
+    return __fixed_size1_decode_array_cleanup(p, 1);
+}
+
+int __fixed_size1_clone_array(const fixed_size1 *p, fixed_size1 *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int64_t_clone_array(&(p[element].utime), &(q[element].utime), 1);
+
+        __fixed_inner_clone_array(p[element].inner, q[element].inner, 4);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            __double_clone_array(p[element].m[a], q[element].m[a], 2);
+        }
+        }
+
+        __boolean_clone_array(&(p[element].ok), &(q[element].ok), 1);
+
+        __byte_clone_array(p[element].raw, q[element].raw, 8);
+
+    }
+    return 0;
+}
+
+fixed_size1 *fixed_size1_copy(const fixed_size1 *p)
+{
+    fixed_size1 *q = (fixed_size1*) malloc(sizeof(fixed_size1));
+    __fixed_size1_clone_array(p, q, 1);
+    return q;
+}
+
+void fixed_size1_destroy(fixed_size1 *p)
+{
+    __fixed_size1_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int fixed_size1_publish(zcm_t *lc, const char *channel, const fixed_size1 *p)
+{
+      int max_data_size = fixed_size1_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = fixed_size1_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _fixed_size1_subscription_t {
+    fixed_size1_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+};
+static
+void fixed_size1_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    fixed_size1 p;
+    memset(&p, 0, sizeof(fixed_size1));
+    status = fixed_size1_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding fixed_size1!!!\n", status);
+        return;
+    }
+
+    fixed_size1_subscription_t *h = (fixed_size1_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    fixed_size1_decode_cleanup (&p);
+}
+
+fixed_size1_subscription_t* fixed_size1_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    fixed_size1_handler_t f, void *userdata)
+{
+    fixed_size1_subscription_t *n = (fixed_size1_subscription_t*)
+                       malloc(sizeof(fixed_size1_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              fixed_size1_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg fixed_size1 ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int fixed_size1_unsubscribe(zcm_t *zcm, fixed_size1_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe fixed_size1_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
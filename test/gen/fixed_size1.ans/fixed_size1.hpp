@@ -0,0 +1,238 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+ * BY HAND!!
+ *
+ * Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+
+#ifndef __fixed_size1_hpp__
+#define __fixed_size1_hpp__
+
+#include "fixed_inner.hpp"
+
+
+class fixed_size1
+{
+    public:
+        int64_t    utime;
+
+        fixed_inner inner[4];
+
+        double     m[2][2];
+
+        int8_t     ok;
+
+        uint8_t    raw[8];
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~fixed_size1() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void *buf, int offset, int maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline int getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "fixed_size1"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int _encodeNoHash(void *buf, int offset, int maxlen) const;
+        inline int _getEncodedSizeNoHash() const;
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr *p);
+        // Caller guarantees that buf holds at least _getEncodedSizeNoHash() bytes
+        inline int _encodeNoHashUnchecked(void *buf, int offset) const;
+
+        // Encoded size of this type (without hash) if it never varies, -1 otherwise
+        enum { _fixedEncodedSizeNoHash = ((int)fixed_inner::_fixedEncodedSizeNoHash < 0) ? -1 : 49 + 4 * (int)fixed_inner::_fixedEncodedSizeNoHash };
+};
+
+int fixed_size1::encode(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+    int64_t hash = (int64_t)getHash();
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int fixed_size1::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int fixed_size1::getEncodedSize() const
+{
+    return 8 + _getEncodedSizeNoHash();
+}
+
+int64_t fixed_size1::getHash()
+{
+    static int64_t hash = _computeHash(NULL);
+    return hash;
+}
+
+const char* fixed_size1::getTypeName()
+{
+    return "fixed_size1";
+}
+
+int fixed_size1::_encodeNoHash(void *buf, int offset, int maxlen) const
+{
+    if (_fixedEncodedSizeNoHash >= 0) {
+        if (maxlen < _fixedEncodedSizeNoHash) return -1;
+        return this->_encodeNoHashUnchecked(buf, offset);
+    }
+
+    int pos = 0, tlen;
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &this->utime, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    for (int a0 = 0; a0 < 4; a0++) {
+        tlen = this->inner[a0]._encodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < 2; a0++) {
+        tlen = __double_encode_array(buf, offset + pos, maxlen - pos, &this->m[a0][0], 2);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    tlen = __boolean_encode_array(buf, offset + pos, maxlen - pos, &this->ok, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __byte_encode_array(buf, offset + pos, maxlen - pos, &this->raw[0], 8);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int fixed_size1::_encodeNoHashUnchecked(void *buf, int offset) const
+{
+    uint8_t *p = (uint8_t*) buf + offset;
+    int pos = 0;
+
+    __zcm_encode_be(p + pos, &this->utime, 1, 8);
+    pos += 8;
+    for (int a0 = 0; a0 < 4; a0++) {
+        pos += this->inner[a0]._encodeNoHashUnchecked(p, pos);
+    }
+    __zcm_encode_be(p + pos, &this->m[0][0], 4, 8);
+    pos += 32;
+    memcpy(p + pos, &this->ok, 1);
+    pos += 1;
+    memcpy(p + pos, &this->raw[0], 8);
+    pos += 8;
+
+    return pos;
+}
+
+int fixed_size1::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+
+    tlen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this->utime, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    for (int a0 = 0; a0 < 4; a0++) {
+        tlen = this->inner[a0]._decodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < 2; a0++) {
+        tlen = __double_decode_array(buf, offset + pos, maxlen - pos, &this->m[a0][0], 2);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    tlen = __boolean_decode_array(buf, offset + pos, maxlen - pos, &this->ok, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __byte_decode_array(buf, offset + pos, maxlen - pos, &this->raw[0], 8);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int fixed_size1::_getEncodedSizeNoHash() const
+{
+    if (_fixedEncodedSizeNoHash >= 0) return _fixedEncodedSizeNoHash;
+    int enc_size = 0;
+    enc_size += __int64_t_encoded_array_size(NULL, 1);
+    if (fixed_inner::_fixedEncodedSizeNoHash >= 0) enc_size += 4 * fixed_inner::_fixedEncodedSizeNoHash;
+    else {
+        for (int a0 = 0; a0 < 4; a0++) {
+            enc_size += this->inner[a0]._getEncodedSizeNoHash();
+        }
+    }
+    enc_size += 2 * __double_encoded_array_size(NULL, 2);
+    enc_size += __boolean_encoded_array_size(NULL, 1);
+    enc_size += __byte_encoded_array_size(NULL, 8);
+    return enc_size;
+}
+
+uint64_t fixed_size1::_computeHash(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for(fp = p; fp != NULL; fp = fp->parent)
+        if(fp->v == fixed_size1::getHash)
+            return 0;
+    const __zcm_hash_ptr cp = { p, (void*)fixed_size1::getHash };
+
+    uint64_t hash = (uint64_t)0xa47ab3501d068511LL +
+         fixed_inner::_computeHash(&cp);
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+#endif
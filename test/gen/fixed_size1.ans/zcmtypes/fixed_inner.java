@@ -0,0 +1,99 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class fixed_inner implements zcm.zcm.ZCMEncodable
+{
+    public short a;
+    public float b[];
+ 
+    public fixed_inner()
+    {
+        b = new float[3];
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0xbb071e2c8a6bbd0dL;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.fixed_inner.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.fixed_inner.class);
+        long hash = ZCM_FINGERPRINT_BASE
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        outs.writeShort(this.a); 
+ 
+        for (int a = 0; a < 3; a++) {
+            outs.writeFloat(this.b[a]); 
+        }
+ 
+    }
+ 
+    public fixed_inner(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public fixed_inner(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.fixed_inner _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.fixed_inner o = new zcmtypes.fixed_inner();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        this.a = ins.readShort();
+ 
+        this.b = new float[(int) 3];
+        for (int a = 0; a < 3; a++) {
+            this.b[a] = ins.readFloat();
+        }
+ 
+    }
+ 
+    public zcmtypes.fixed_inner copy()
+    {
+        zcmtypes.fixed_inner outobj = new zcmtypes.fixed_inner();
+        outobj.a = this.a;
+ 
+        outobj.b = new float[(int) 3];
+        System.arraycopy(this.b, 0, outobj.b, 0, 3); 
+        return outobj;
+    }
+ 
+}
+
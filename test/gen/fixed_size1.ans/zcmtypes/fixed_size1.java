@@ -0,0 +1,137 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class fixed_size1 implements zcm.zcm.ZCMEncodable
+{
+    public long utime;
+    public zcmtypes.fixed_inner inner[];
+    public double m[][];
+    public boolean ok;
+    public byte raw[];
+ 
+    public fixed_size1()
+    {
+        inner = new zcmtypes.fixed_inner[4];
+        m = new double[2][2];
+        raw = new byte[8];
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0xa47ab3501d068511L;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.fixed_size1.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.fixed_size1.class);
+        long hash = ZCM_FINGERPRINT_BASE
+             + zcmtypes.fixed_inner._hashRecursive(classes)
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        outs.writeLong(this.utime); 
+ 
+        for (int a = 0; a < 4; a++) {
+            this.inner[a]._encodeRecursive(outs); 
+        }
+ 
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 2; b++) {
+                outs.writeDouble(this.m[a][b]); 
+            }
+        }
+ 
+        outs.writeByte( this.ok ? 1 : 0); 
+ 
+        outs.write(this.raw, 0, 8);
+ 
+    }
+ 
+    public fixed_size1(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public fixed_size1(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.fixed_size1 _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.fixed_size1 o = new zcmtypes.fixed_size1();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        this.utime = ins.readLong();
+ 
+        this.inner = new zcmtypes.fixed_inner[(int) 4];
+        for (int a = 0; a < 4; a++) {
+            this.inner[a] = zcmtypes.fixed_inner._decodeRecursiveFactory(ins);
+        }
+ 
+        this.m = new double[(int) 2][(int) 2];
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 2; b++) {
+                this.m[a][b] = ins.readDouble();
+            }
+        }
+ 
+        this.ok = ins.readByte()!=0;
+ 
+        this.raw = new byte[(int) 8];
+        ins.readFully(this.raw, 0, 8); 
+    }
+ 
+    public zcmtypes.fixed_size1 copy()
+    {
+        zcmtypes.fixed_size1 outobj = new zcmtypes.fixed_size1();
+        outobj.utime = this.utime;
+ 
+        outobj.inner = new zcmtypes.fixed_inner[(int) 4];
+        for (int a = 0; a < 4; a++) {
+            outobj.inner[a] = this.inner[a].copy();
+        }
+ 
+        outobj.m = new double[(int) 2][(int) 2];
+        for (int a = 0; a < 2; a++) {
+            System.arraycopy(this.m[a], 0, outobj.m[a], 0, 2);        }
+ 
+        outobj.ok = this.ok;
+ 
+        outobj.raw = new byte[(int) 8];
+        System.arraycopy(this.raw, 0, outobj.raw, 0, 8); 
+        return outobj;
+    }
+ 
+}
+
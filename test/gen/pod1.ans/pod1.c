@@ -0,0 +1,303 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "pod1.h"
+
+static int __pod1_hash_computed;
+static uint64_t __pod1_hash;
+
+uint64_t __pod1_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __pod1_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__pod1_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x397b20fb2046c98aLL
+         + __int8_t_hash_recursive(&cp)
+         + __int64_t_hash_recursive(&cp)
+         + __int16_t_hash_recursive(&cp)
+         + __float_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __boolean_hash_recursive(&cp)
+         + __byte_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __pod1_get_hash(void)
+{
+    if (!__pod1_hash_computed) {
+        __pod1_hash = (int64_t)__pod1_hash_recursive(NULL);
+        __pod1_hash_computed = 1;
+    }
+
+    return __pod1_hash;
+}
+
+int __pod1_encode_array(void *buf, int offset, int maxlen, const pod1 *p, int elements)
+{
+    uint8_t *data = (uint8_t*) buf + offset;
+    int pos = 0, element;
+
+    if (maxlen < elements * (POD1_ENCODED_SIZE - 8)) return -1;
+
+#ifdef __ZCM_BIG_ENDIAN_HOST
+    if (sizeof(pod1) == (POD1_ENCODED_SIZE - 8)) {
+        memcpy(data, p, elements * (POD1_ENCODED_SIZE - 8));
+        return elements * (POD1_ENCODED_SIZE - 8);
+    }
+#endif
+
+    for (element = 0; element < elements; element++) {
+        memcpy(data + pos, &p[element].flag, 1);
+        pos += 1;
+        __zcm_encode_be(data + pos, &p[element].utime, 1, 8);
+        pos += 8;
+        __zcm_encode_be(data + pos, &p[element].counts[0], 3, 2);
+        pos += 6;
+        __zcm_encode_be(data + pos, &p[element].grid[0][0], 6, 4);
+        pos += 24;
+        __zcm_encode_be(data + pos, &p[element].scale, 1, 8);
+        pos += 8;
+        memcpy(data + pos, &p[element].valid, 1);
+        pos += 1;
+        memcpy(data + pos, &p[element].raw[0], 5);
+        pos += 5;
+        __zcm_encode_be(data + pos, &p[element].id, 1, 4);
+        pos += 4;
+    }
+    return pos;
+}
+
+int pod1_encode(void *buf, int offset, int maxlen, const pod1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __pod1_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __pod1_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __pod1_encoded_array_size(const pod1 *p, int elements)
+{
+    (void)p;
+    return elements * (POD1_ENCODED_SIZE - 8);
+}
+
+int pod1_encoded_size(const pod1 *p)
+{
+    return 8 + __pod1_encoded_array_size(p, 1);
+}
+
+int __pod1_decode_array(const void *buf, int offset, int maxlen, pod1 *p, int elements)
+{
+    const uint8_t *data = (const uint8_t*) buf + offset;
+    int pos = 0, element;
+
+    if (maxlen < elements * (POD1_ENCODED_SIZE - 8)) return -1;
+
+#ifdef __ZCM_BIG_ENDIAN_HOST
+    if (sizeof(pod1) == (POD1_ENCODED_SIZE - 8)) {
+        memcpy(p, data, elements * (POD1_ENCODED_SIZE - 8));
+        return elements * (POD1_ENCODED_SIZE - 8);
+    }
+#endif
+
+    for (element = 0; element < elements; element++) {
+        memcpy(&p[element].flag, data + pos, 1);
+        pos += 1;
+        __zcm_decode_be(&p[element].utime, data + pos, 1, 8);
+        pos += 8;
+        __zcm_decode_be(&p[element].counts[0], data + pos, 3, 2);
+        pos += 6;
+        __zcm_decode_be(&p[element].grid[0][0], data + pos, 6, 4);
+        pos += 24;
+        __zcm_decode_be(&p[element].scale, data + pos, 1, 8);
+        pos += 8;
+        memcpy(&p[element].valid, data + pos, 1);
+        pos += 1;
+        memcpy(&p[element].raw[0], data + pos, 5);
+        pos += 5;
+        __zcm_decode_be(&p[element].id, data + pos, 1, 4);
+        pos += 4;
+    }
+    return pos;
+}
+
+int __pod1_decode_array_cleanup(pod1 *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int8_t_decode_array_cleanup(&(p[element].flag), 1);
+
+        __int64_t_decode_array_cleanup(&(p[element].utime), 1);
+
+        __int16_t_decode_array_cleanup(p[element].counts, 3);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            __float_decode_array_cleanup(p[element].grid[a], 3);
+        }
+        }
+
+        __double_decode_array_cleanup(&(p[element].scale), 1);
+
+        __boolean_decode_array_cleanup(&(p[element].valid), 1);
+
+        __byte_decode_array_cleanup(p[element].raw, 5);
+
+        __int32_t_decode_array_cleanup(&(p[element].id), 1);
+
+    }
+    return 0;
+}
+
+int pod1_decode(const void *buf, int offset, int maxlen, pod1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __pod1_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __pod1_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int pod1_decode_cleanup(pod1 *p)
+{
+    return __pod1_decode_array_cleanup(p, 1);
+}
+
+int __pod1_clone_array(const pod1 *p, pod1 *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int8_t_clone_array(&(p[element].flag), &(q[element].flag), 1);
+
+        __int64_t_clone_array(&(p[element].utime), &(q[element].utime), 1);
+
+        __int16_t_clone_array(p[element].counts, q[element].counts, 3);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            __float_clone_array(p[element].grid[a], q[element].grid[a], 3);
+        }
+        }
+
+        __double_clone_array(&(p[element].scale), &(q[element].scale), 1);
+
+        __boolean_clone_array(&(p[element].valid), &(q[element].valid), 1);
+
+        __byte_clone_array(p[element].raw, q[element].raw, 5);
+
+        __int32_t_clone_array(&(p[element].id), &(q[element].id), 1);
+
+    }
+    return 0;
+}
+
+pod1 *pod1_copy(const pod1 *p)
+{
+    pod1 *q = (pod1*) malloc(sizeof(pod1));
+    __pod1_clone_array(p, q, 1);
+    return q;
+}
+
+void pod1_destroy(pod1 *p)
+{
+    __pod1_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int pod1_publish(zcm_t *lc, const char *channel, const pod1 *p)
+{
+      int max_data_size = pod1_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = pod1_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _pod1_subscription_t {
+    pod1_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+};
+static
+void pod1_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    pod1 p;
+    memset(&p, 0, sizeof(pod1));
+    status = pod1_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding pod1!!!\n", status);
+        return;
+    }
+
+    pod1_subscription_t *h = (pod1_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    pod1_decode_cleanup (&p);
+}
+
+pod1_subscription_t* pod1_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    pod1_handler_t f, void *userdata)
+{
+    pod1_subscription_t *n = (pod1_subscription_t*)
+                       malloc(sizeof(pod1_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              pod1_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg pod1 ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int pod1_unsubscribe(zcm_t *zcm, pod1_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe pod1_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,138 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _pod1_h
+#define _pod1_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _pod1 pod1;
+struct _pod1
+{
+    int8_t     flag;
+    int64_t    utime;
+    int16_t    counts[3];
+    float      grid[2][3];
+    double     scale;
+    int8_t     valid;
+    uint8_t    raw[5];
+    int32_t    id;
+};
+
+/**
+ * Every pod1 encodes to exactly this many bytes (including the hash)
+ */
+#define POD1_ENCODED_SIZE 65
+
+/**
+ * Create a deep copy of a pod1.
+ * When no longer needed, destroy it with pod1_destroy()
+ */
+pod1* pod1_copy(const pod1* to_copy);
+
+/**
+ * Destroy an instance of pod1 created by pod1_copy()
+ */
+void pod1_destroy(pod1* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _pod1_subscription_t pod1_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * pod1 is received.
+ */
+typedef void(*pod1_handler_t)(const zcm_recv_buf_t *rbuf,
+             const char *channel, const pod1 *msg, void *userdata);
+
+/**
+ * Publish a message of type pod1 using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int pod1_publish(zcm_t *zcm, const char *channel, const pod1 *msg);
+
+/**
+ * Subscribe to messages of type pod1 using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to pod1_unsubscribe.
+ */
+pod1_subscription_t* pod1_subscribe(zcm_t *zcm, const char *channel, pod1_handler_t handler, void *userdata);
+
+/**
+ * Removes and destroys a subscription created by pod1_subscribe()
+ */
+int pod1_unsubscribe(zcm_t *zcm, pod1_subscription_t* hid);
+/**
+ * Encode a message of type pod1 into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to pod1_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int pod1_encode(void *buf, int offset, int maxlen, const pod1 *p);
+
+/**
+ * Decode a message of type pod1 from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with pod1_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int pod1_decode(const void *buf, int offset, int maxlen, pod1 *msg);
+
+/**
+ * Release resources allocated by pod1_decode()
+ * @return 0
+ */
+int pod1_decode_cleanup(pod1 *p);
+
+/**
+ * Check how many bytes are required to encode a message of type pod1
+ */
+int pod1_encoded_size(const pod1 *p);
+
+// ZCM support functions. Users should not call these
+int64_t __pod1_get_hash(void);
+uint64_t __pod1_hash_recursive(const __zcm_hash_ptr *p);
+int     __pod1_encode_array(void *buf, int offset, int maxlen, const pod1 *p, int elements);
+int     __pod1_decode_array(const void *buf, int offset, int maxlen, pod1 *p, int elements);
+int     __pod1_decode_array_cleanup(pod1 *p, int elements);
+int     __pod1_encoded_array_size(const pod1 *p, int elements);
+int     __pod1_clone_array(const pod1 *p, pod1 *q, int elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class pod1 implements zcm.zcm.ZCMEncodable
+{
+    public byte flag;
+    public long utime;
+    public short counts[];
+    public float grid[][];
+    public double scale;
+    public boolean valid;
+    public byte raw[];
+    public int id;
+ 
+    public pod1()
+    {
+        counts = new short[3];
+        grid = new float[2][3];
+        raw = new byte[5];
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0x397b20fb2046c98aL;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.pod1.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.pod1.class);
+        long hash = ZCM_FINGERPRINT_BASE
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        outs.writeByte(this.flag); 
+ 
+        outs.writeLong(this.utime); 
+ 
+        for (int a = 0; a < 3; a++) {
+            outs.writeShort(this.counts[a]); 
+        }
+ 
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 3; b++) {
+                outs.writeFloat(this.grid[a][b]); 
+            }
+        }
+ 
+        outs.writeDouble(this.scale); 
+ 
+        outs.writeByte( this.valid ? 1 : 0); 
+ 
+        outs.write(this.raw, 0, 5);
+ 
+        outs.writeInt(this.id); 
+ 
+    }
+ 
+    public pod1(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public pod1(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.pod1 _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.pod1 o = new zcmtypes.pod1();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        this.flag = ins.readByte();
+ 
+        this.utime = ins.readLong();
+ 
+        this.counts = new short[(int) 3];
+        for (int a = 0; a < 3; a++) {
+            this.counts[a] = ins.readShort();
+        }
+ 
+        this.grid = new float[(int) 2][(int) 3];
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 3; b++) {
+                this.grid[a][b] = ins.readFloat();
+            }
+        }
+ 
+        this.scale = ins.readDouble();
+ 
+        this.valid = ins.readByte()!=0;
+ 
+        this.raw = new byte[(int) 5];
+        ins.readFully(this.raw, 0, 5); 
+        this.id = ins.readInt();
+ 
+    }
+ 
+    public zcmtypes.pod1 copy()
+    {
+        zcmtypes.pod1 outobj = new zcmtypes.pod1();
+        outobj.flag = this.flag;
+ 
+        outobj.utime = this.utime;
+ 
+        outobj.counts = new short[(int) 3];
+        System.arraycopy(this.counts, 0, outobj.counts, 0, 3); 
+        outobj.grid = new float[(int) 2][(int) 3];
+        for (int a = 0; a < 2; a++) {
+            System.arraycopy(this.grid[a], 0, outobj.grid[a], 0, 3);        }
+ 
+        outobj.scale = this.scale;
+ 
+        outobj.valid = this.valid;
+ 
+        outobj.raw = new byte[(int) 5];
+        System.arraycopy(this.raw, 0, outobj.raw, 0, 5); 
+        outobj.id = this.id;
+ 
+        return outobj;
+    }
+ 
+}
+
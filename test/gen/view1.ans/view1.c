@@ -0,0 +1,342 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "view1.h"
+
+static int __view1_hash_computed;
+static uint64_t __view1_hash;
+
+uint64_t __view1_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __view1_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__view1_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x6e12446524b5b108LL
+         + __int64_t_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __float_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __string_hash_recursive(&cp)
+         + __string_hash_recursive(&cp)
+         + __view_point_hash_recursive(&cp)
+         + __view_tag_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __view1_get_hash(void)
+{
+    if (!__view1_hash_computed) {
+        __view1_hash = (int64_t)__view1_hash_recursive(NULL);
+        __view1_hash_computed = 1;
+    }
+
+    return __view1_hash;
+}
+
+int __view1_encode_array(void *buf, int offset, int maxlen, const view1 *p, int elements)
+{
+    int pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].utime), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __float_encode_array(buf, offset + pos, maxlen - pos, p[element].samples, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            thislen = __double_encode_array(buf, offset + pos, maxlen - pos, p[element].pose[a], 3);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, p[element].labels, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __view_point_encode_array(buf, offset + pos, maxlen - pos, p[element].points, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __view_tag_encode_array(buf, offset + pos, maxlen - pos, p[element].tags, 2);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int view1_encode(void *buf, int offset, int maxlen, const view1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __view1_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __view1_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __view1_encoded_array_size(const view1 *p, int elements)
+{
+    int size = 0, element;
+    for (element = 0; element < elements; element++) {
+
+        size += __int64_t_encoded_array_size(&(p[element].utime), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].n), 1);
+
+        size += __float_encoded_array_size(p[element].samples, p[element].n);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            size += __double_encoded_array_size(p[element].pose[a], 3);
+        }
+        }
+
+        size += __string_encoded_array_size(&(p[element].name), 1);
+
+        size += __string_encoded_array_size(p[element].labels, p[element].n);
+
+        size += __view_point_encoded_array_size(p[element].points, p[element].n);
+
+        size += __view_tag_encoded_array_size(p[element].tags, 2);
+
+    }
+    return size;
+}
+
+int view1_encoded_size(const view1 *p)
+{
+    return 8 + __view1_encoded_array_size(p, 1);
+}
+
+int __view1_decode_array(const void *buf, int offset, int maxlen, view1 *p, int elements)
+{
+    int pos = 0, thislen, element;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].utime), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].samples = (float*) zcm_malloc(sizeof(float) * p[element].n);
+        thislen = __float_decode_array(buf, offset + pos, maxlen - pos, p[element].samples, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            thislen = __double_decode_array(buf, offset + pos, maxlen - pos, p[element].pose[a], 3);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].labels = (char**) zcm_malloc(sizeof(char*) * p[element].n);
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, p[element].labels, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].points = (view_point*) zcm_malloc(sizeof(view_point) * p[element].n);
+        thislen = __view_point_decode_array(buf, offset + pos, maxlen - pos, p[element].points, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __view_tag_decode_array(buf, offset + pos, maxlen - pos, p[element].tags, 2);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __view1_decode_array_cleanup(view1 *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int64_t_decode_array_cleanup(&(p[element].utime), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].n), 1);
+
+        __float_decode_array_cleanup(p[element].samples, p[element].n);
+        if (p[element].samples) free(p[element].samples);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            __double_decode_array_cleanup(p[element].pose[a], 3);
+        }
+        }
+
+        __string_decode_array_cleanup(&(p[element].name), 1);
+
+        __string_decode_array_cleanup(p[element].labels, p[element].n);
+        if (p[element].labels) free(p[element].labels);
+
+        __view_point_decode_array_cleanup(p[element].points, p[element].n);
+        if (p[element].points) free(p[element].points);
+
+        __view_tag_decode_array_cleanup(p[element].tags, 2);
+
+    }
+    return 0;
+}
+
+int view1_decode(const void *buf, int offset, int maxlen, view1 *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __view1_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __view1_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int view1_decode_cleanup(view1 *p)
+{
+    return __view1_decode_array_cleanup(p, 1);
+}
+
+int __view1_clone_array(const view1 *p, view1 *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __int64_t_clone_array(&(p[element].utime), &(q[element].utime), 1);
+
+        __int32_t_clone_array(&(p[element].n), &(q[element].n), 1);
+
+        q[element].samples = (float*) zcm_malloc(sizeof(float) * q[element].n);
+        __float_clone_array(p[element].samples, q[element].samples, p[element].n);
+
+        { int a;
+        for (a = 0; a < 2; a++) {
+            __double_clone_array(p[element].pose[a], q[element].pose[a], 3);
+        }
+        }
+
+        __string_clone_array(&(p[element].name), &(q[element].name), 1);
+
+        q[element].labels = (char**) zcm_malloc(sizeof(char*) * q[element].n);
+        __string_clone_array(p[element].labels, q[element].labels, p[element].n);
+
+        q[element].points = (view_point*) zcm_malloc(sizeof(view_point) * q[element].n);
+        __view_point_clone_array(p[element].points, q[element].points, p[element].n);
+
+        __view_tag_clone_array(p[element].tags, q[element].tags, 2);
+
+    }
+    return 0;
+}
+
+view1 *view1_copy(const view1 *p)
+{
+    view1 *q = (view1*) malloc(sizeof(view1));
+    __view1_clone_array(p, q, 1);
+    return q;
+}
+
+void view1_destroy(view1 *p)
+{
+    __view1_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int view1_publish(zcm_t *lc, const char *channel, const view1 *p)
+{
+      int max_data_size = view1_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = view1_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _view1_subscription_t {
+    view1_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+};
+static
+void view1_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    view1 p;
+    memset(&p, 0, sizeof(view1));
+    status = view1_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding view1!!!\n", status);
+        return;
+    }
+
+    view1_subscription_t *h = (view1_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    view1_decode_cleanup (&p);
+}
+
+view1_subscription_t* view1_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    view1_handler_t f, void *userdata)
+{
+    view1_subscription_t *n = (view1_subscription_t*)
+                       malloc(sizeof(view1_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              view1_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg view1 ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int view1_unsubscribe(zcm_t *zcm, view1_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe view1_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
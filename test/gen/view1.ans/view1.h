@@ -0,0 +1,135 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _view1_h
+#define _view1_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "view_point.h"
+#include "view_tag.h"
+typedef struct _view1 view1;
+struct _view1
+{
+    int64_t    utime;
+    int32_t    n;
+    float      *samples;
+    double     pose[2][3];
+    char*      name;
+    char*      *labels;
+    view_point *points;
+    view_tag   tags[2];
+};
+
+/**
+ * Create a deep copy of a view1.
+ * When no longer needed, destroy it with view1_destroy()
+ */
+view1* view1_copy(const view1* to_copy);
+
+/**
+ * Destroy an instance of view1 created by view1_copy()
+ */
+void view1_destroy(view1* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _view1_subscription_t view1_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * view1 is received.
+ */
+typedef void(*view1_handler_t)(const zcm_recv_buf_t *rbuf,
+             const char *channel, const view1 *msg, void *userdata);
+
+/**
+ * Publish a message of type view1 using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int view1_publish(zcm_t *zcm, const char *channel, const view1 *msg);
+
+/**
+ * Subscribe to messages of type view1 using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to view1_unsubscribe.
+ */
+view1_subscription_t* view1_subscribe(zcm_t *zcm, const char *channel, view1_handler_t handler, void *userdata);
+
+/**
+ * Removes and destroys a subscription created by view1_subscribe()
+ */
+int view1_unsubscribe(zcm_t *zcm, view1_subscription_t* hid);
+/**
+ * Encode a message of type view1 into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to view1_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int view1_encode(void *buf, int offset, int maxlen, const view1 *p);
+
+/**
+ * Decode a message of type view1 from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with view1_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int view1_decode(const void *buf, int offset, int maxlen, view1 *msg);
+
+/**
+ * Release resources allocated by view1_decode()
+ * @return 0
+ */
+int view1_decode_cleanup(view1 *p);
+
+/**
+ * Check how many bytes are required to encode a message of type view1
+ */
+int view1_encoded_size(const view1 *p);
+
+// ZCM support functions. Users should not call these
+int64_t __view1_get_hash(void);
+uint64_t __view1_hash_recursive(const __zcm_hash_ptr *p);
+int     __view1_encode_array(void *buf, int offset, int maxlen, const view1 *p, int elements);
+int     __view1_decode_array(const void *buf, int offset, int maxlen, view1 *p, int elements);
+int     __view1_decode_array_cleanup(view1 *p, int elements);
+int     __view1_encoded_array_size(const view1 *p, int elements);
+int     __view1_clone_array(const view1 *p, view1 *q, int elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,533 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+ * BY HAND!!
+ *
+ * Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm_view.hpp>
+
+#ifndef __view1_hpp__
+#define __view1_hpp__
+
+#include <vector>
+#include <string>
+#include "view_point.hpp"
+#include "view_tag.hpp"
+
+
+class view1
+{
+    public:
+        int64_t    utime;
+
+        int32_t    n;
+
+        std::vector< float > samples;
+
+        double     pose[2][3];
+
+        std::string name;
+
+        std::vector< std::string > labels;
+
+        std::vector< view_point > points;
+
+        view_tag   tags[2];
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~view1() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void *buf, int offset, int maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline int getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "view1"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int _encodeNoHash(void *buf, int offset, int maxlen) const;
+        inline int _getEncodedSizeNoHash() const;
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr *p);
+        // Caller guarantees that buf holds at least _getEncodedSizeNoHash() bytes
+        inline int _encodeNoHashUnchecked(void *buf, int offset) const;
+
+        // Encoded size of this type (without hash) if it never varies, -1 otherwise
+        enum { _fixedEncodedSizeNoHash = -1 };
+};
+
+int view1::encode(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+    int64_t hash = (int64_t)getHash();
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int view1::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int view1::getEncodedSize() const
+{
+    return 8 + _getEncodedSizeNoHash();
+}
+
+int64_t view1::getHash()
+{
+    static int64_t hash = _computeHash(NULL);
+    return hash;
+}
+
+const char* view1::getTypeName()
+{
+    return "view1";
+}
+
+int view1::_encodeNoHash(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &this->utime, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &this->n, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    if(this->n > 0) {
+        tlen = __float_encode_array(buf, offset + pos, maxlen - pos, &this->samples[0], this->n);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < 2; a0++) {
+        tlen = __double_encode_array(buf, offset + pos, maxlen - pos, &this->pose[a0][0], 3);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    char* name_cstr = (char*) this->name.c_str();
+    tlen = __string_encode_array(buf, offset + pos, maxlen - pos, &name_cstr, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    for (int a0 = 0; a0 < this->n; a0++) {
+        char* __cstr = (char*) this->labels[a0].c_str();
+        tlen = __string_encode_array(buf, offset + pos, maxlen - pos, &__cstr, 1);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < this->n; a0++) {
+        tlen = this->points[a0]._encodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < 2; a0++) {
+        tlen = this->tags[a0]._encodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    return pos;
+}
+
+int view1::_encodeNoHashUnchecked(void *buf, int offset) const
+{
+    return this->_encodeNoHash(buf, offset, 0x7fffffff - offset);
+}
+
+int view1::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+
+    tlen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this->utime, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &this->n, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    if(this->n > 0) {
+        this->samples.resize(this->n);
+        tlen = __float_decode_array(buf, offset + pos, maxlen - pos, &this->samples[0], this->n);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < 2; a0++) {
+        tlen = __double_decode_array(buf, offset + pos, maxlen - pos, &this->pose[a0][0], 3);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    int32_t __name_len__;
+    tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &__name_len__, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+    if(__name_len__ > maxlen - pos) return -1;
+    this->name.assign(((const char*)buf) + offset + pos, __name_len__ - 1);
+    pos += __name_len__;
+
+    this->labels.resize(this->n);
+    for (int a0 = 0; a0 < this->n; a0++) {
+        int32_t __elem_len;
+        tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &__elem_len, 1);
+        if(tlen < 0) return tlen; else pos += tlen;
+        if(__elem_len > maxlen - pos) return -1;
+        this->labels[a0].assign(((const char*)buf) + offset + pos, __elem_len -  1);
+        pos += __elem_len;
+    }
+
+    this->points.resize(this->n);
+    for (int a0 = 0; a0 < this->n; a0++) {
+        tlen = this->points[a0]._decodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    for (int a0 = 0; a0 < 2; a0++) {
+        tlen = this->tags[a0]._decodeNoHash(buf, offset + pos, maxlen - pos);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    return pos;
+}
+
+int view1::_getEncodedSizeNoHash() const
+{
+    int enc_size = 0;
+    enc_size += __int64_t_encoded_array_size(NULL, 1);
+    enc_size += __int32_t_encoded_array_size(NULL, 1);
+    enc_size += __float_encoded_array_size(NULL, this->n);
+    enc_size += 2 * __double_encoded_array_size(NULL, 3);
+    enc_size += this->name.size() + 4 + 1;
+    for (int a0 = 0; a0 < this->n; a0++) {
+        enc_size += this->labels[a0].size() + 4 + 1;
+    }
+    if (view_point::_fixedEncodedSizeNoHash >= 0) enc_size += this->n * view_point::_fixedEncodedSizeNoHash;
+    else {
+        for (int a0 = 0; a0 < this->n; a0++) {
+            enc_size += this->points[a0]._getEncodedSizeNoHash();
+        }
+    }
+    if (view_tag::_fixedEncodedSizeNoHash >= 0) enc_size += 2 * view_tag::_fixedEncodedSizeNoHash;
+    else {
+        for (int a0 = 0; a0 < 2; a0++) {
+            enc_size += this->tags[a0]._getEncodedSizeNoHash();
+        }
+    }
+    return enc_size;
+}
+
+uint64_t view1::_computeHash(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for(fp = p; fp != NULL; fp = fp->parent)
+        if(fp->v == view1::getHash)
+            return 0;
+    const __zcm_hash_ptr cp = { p, (void*)view1::getHash };
+
+    uint64_t hash = (uint64_t)0x6e12446524b5b108LL +
+         view_point::_computeHash(&cp) +
+         view_tag::_computeHash(&cp);
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+/**
+ * A zero-copy, read-only view of an encoded view1.
+ * decode() only walks the lengths of the message; every field is read
+ * straight out of the encoded buffer when its accessor is called.
+ * The buffer passed to decode() must outlive the view.
+ */
+class view1View
+{
+    public:
+        inline view1View() : _buf(NULL), _len(0) {}
+
+        /**
+         * Validate an encoded message and point this view at it.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to read while validating.
+         * @return The number of bytes spanned by the message, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Returns true if this view currently points at a valid message
+         */
+        inline bool good() const { return _buf != NULL; }
+
+        /**
+         * Decode the whole message into @p msg.
+         */
+        inline int copyTo(view1& msg) const { return msg._decodeNoHash(_buf, 0, _len); }
+
+        inline static int64_t getHash() { return view1::getHash(); }
+        inline static const char* getTypeName() { return view1::getTypeName(); }
+
+        // Field accessors. Arrays of strings and zcmtypes take a flattened
+        // (row-major) index; none are bounds checked. Elements of fixed size
+        // are found directly, others by walking on from the last element read,
+        // so iterating over an array is linear. That makes a view unsafe to
+        // share between threads
+        inline int64_t utime() const;
+        inline int32_t n() const;
+        inline zcm::ArrayView<float> samples() const;
+        inline zcm::ArrayView<double> pose() const;
+        inline const char* name() const;
+        inline const char* labels(int i) const;
+        inline view_pointView points(int i) const;
+        inline view_tagView tags(int i) const;
+
+        // ZCM support functions. Users should not call these
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+
+    private:
+        const uint8_t *_buf;
+        int _len;
+        int _offsets[8];
+        // Index and offset of the last element read from each array of
+        // strings or zcmtypes
+        mutable int _lastIdx[8];
+        mutable int _lastPos[8];
+};
+
+int view1View::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+    _buf = NULL;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) { _buf = NULL; return thislen; } else pos += thislen;
+
+    return pos;
+}
+
+int view1View::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+    int64_t n;
+    (void)tlen; (void)n;
+
+    _buf = (const uint8_t*)buf + offset;
+    _len = maxlen;
+
+    _offsets[0] = pos;
+    n = 1;
+    if (n * (int64_t)sizeof(int64_t) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(int64_t);
+
+    _offsets[1] = pos;
+    n = 1;
+    if (n * (int64_t)sizeof(int32_t) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(int32_t);
+
+    _offsets[2] = pos;
+    n = 1;
+    n *= (int64_t)this->n();
+    if (n < 0 || n > maxlen) return -1;
+    if (n * (int64_t)sizeof(float) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(float);
+
+    _offsets[3] = pos;
+    n = 1;
+    n *= (int64_t)2;
+    if (n < 0 || n > maxlen) return -1;
+    n *= (int64_t)3;
+    if (n < 0 || n > maxlen) return -1;
+    if (n * (int64_t)sizeof(double) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(double);
+
+    _offsets[4] = pos;
+    n = 1;
+    for (int64_t i = 0; i < n; i++) {
+        int32_t len;
+        tlen = __int32_t_decode_array(_buf, pos, maxlen - pos, &len, 1);
+        if (tlen < 0) return tlen; else pos += tlen;
+        if (len < 1 || len > maxlen - pos || _buf[pos + len - 1] != 0) return -1;
+        pos += len;
+    }
+
+    _offsets[5] = pos;
+    _lastIdx[5] = 0;
+    _lastPos[5] = pos;
+    n = 1;
+    n *= (int64_t)this->n();
+    if (n < 0 || n > maxlen) return -1;
+    for (int64_t i = 0; i < n; i++) {
+        int32_t len;
+        tlen = __int32_t_decode_array(_buf, pos, maxlen - pos, &len, 1);
+        if (tlen < 0) return tlen; else pos += tlen;
+        if (len < 1 || len > maxlen - pos || _buf[pos + len - 1] != 0) return -1;
+        pos += len;
+    }
+
+    _offsets[6] = pos;
+    _lastIdx[6] = 0;
+    _lastPos[6] = pos;
+    n = 1;
+    n *= (int64_t)this->n();
+    if (n < 0 || n > maxlen) return -1;
+    if (view_point::_fixedEncodedSizeNoHash >= 0) {
+        if (n * (int64_t)view_point::_fixedEncodedSizeNoHash > maxlen - pos) return -1;
+        pos += (int)n * (int)view_point::_fixedEncodedSizeNoHash;
+    } else {
+        for (int64_t i = 0; i < n; i++) {
+            tlen = view_pointView()._decodeNoHash(_buf, pos, maxlen - pos);
+            if (tlen < 0) return tlen; else pos += tlen;
+        }
+    }
+
+    _offsets[7] = pos;
+    _lastIdx[7] = 0;
+    _lastPos[7] = pos;
+    n = 1;
+    n *= (int64_t)2;
+    if (n < 0 || n > maxlen) return -1;
+    if (view_tag::_fixedEncodedSizeNoHash >= 0) {
+        if (n * (int64_t)view_tag::_fixedEncodedSizeNoHash > maxlen - pos) return -1;
+        pos += (int)n * (int)view_tag::_fixedEncodedSizeNoHash;
+    } else {
+        for (int64_t i = 0; i < n; i++) {
+            tlen = view_tagView()._decodeNoHash(_buf, pos, maxlen - pos);
+            if (tlen < 0) return tlen; else pos += tlen;
+        }
+    }
+
+    return pos;
+}
+
+int64_t view1View::utime() const
+{
+    int64_t v;
+    __int64_t_decode_array(_buf, _offsets[0], sizeof(v), &v, 1);
+    return v;
+}
+
+int32_t view1View::n() const
+{
+    int32_t v;
+    __int32_t_decode_array(_buf, _offsets[1], sizeof(v), &v, 1);
+    return v;
+}
+
+zcm::ArrayView<float> view1View::samples() const
+{
+    return zcm::ArrayView<float>(_buf + _offsets[2], (int)(this->n()));
+}
+
+zcm::ArrayView<double> view1View::pose() const
+{
+    return zcm::ArrayView<double>(_buf + _offsets[3], (int)(2 * 3));
+}
+
+const char* view1View::name() const
+{
+    int pos = _offsets[4];
+    return (const char*)_buf + pos + 4;
+}
+
+const char* view1View::labels(int i) const
+{
+    int pos = _offsets[5];
+    int a = 0;
+    if (i >= _lastIdx[5]) { a = _lastIdx[5]; pos = _lastPos[5]; }
+    for (; a < i; a++) {
+        int32_t len;
+        __int32_t_decode_array(_buf, pos, 4, &len, 1);
+        pos += 4 + len;
+    }
+    _lastIdx[5] = i;
+    _lastPos[5] = pos;
+    return (const char*)_buf + pos + 4;
+}
+
+view_pointView view1View::points(int i) const
+{
+    view_pointView v;
+    int pos = _offsets[6];
+    if (view_point::_fixedEncodedSizeNoHash >= 0) {
+        pos += i * (int)view_point::_fixedEncodedSizeNoHash;
+    } else {
+        int a = 0;
+        if (i >= _lastIdx[6]) { a = _lastIdx[6]; pos = _lastPos[6]; }
+        for (; a < i; a++)
+            pos += v._decodeNoHash(_buf, pos, _len - pos);
+        _lastIdx[6] = i;
+        _lastPos[6] = pos;
+    }
+    v._decodeNoHash(_buf, pos, _len - pos);
+    return v;
+}
+
+view_tagView view1View::tags(int i) const
+{
+    view_tagView v;
+    int pos = _offsets[7];
+    if (view_tag::_fixedEncodedSizeNoHash >= 0) {
+        pos += i * (int)view_tag::_fixedEncodedSizeNoHash;
+    } else {
+        int a = 0;
+        if (i >= _lastIdx[7]) { a = _lastIdx[7]; pos = _lastPos[7]; }
+        for (; a < i; a++)
+            pos += v._decodeNoHash(_buf, pos, _len - pos);
+        _lastIdx[7] = i;
+        _lastPos[7] = pos;
+    }
+    v._decodeNoHash(_buf, pos, _len - pos);
+    return v;
+}
+
+#endif
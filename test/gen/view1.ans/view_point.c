@@ -0,0 +1,241 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "view_point.h"
+
+static int __view_point_hash_computed;
+static uint64_t __view_point_hash;
+
+uint64_t __view_point_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __view_point_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__view_point_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0xa8644c145ac1631aLL
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __view_point_get_hash(void)
+{
+    if (!__view_point_hash_computed) {
+        __view_point_hash = (int64_t)__view_point_hash_recursive(NULL);
+        __view_point_hash_computed = 1;
+    }
+
+    return __view_point_hash;
+}
+
+int __view_point_encode_array(void *buf, int offset, int maxlen, const view_point *p, int elements)
+{
+    uint8_t *data = (uint8_t*) buf + offset;
+    int pos = 0, element;
+
+    if (maxlen < elements * (VIEW_POINT_ENCODED_SIZE - 8)) return -1;
+
+#ifdef __ZCM_BIG_ENDIAN_HOST
+    if (sizeof(view_point) == (VIEW_POINT_ENCODED_SIZE - 8)) {
+        memcpy(data, p, elements * (VIEW_POINT_ENCODED_SIZE - 8));
+        return elements * (VIEW_POINT_ENCODED_SIZE - 8);
+    }
+#endif
+
+    for (element = 0; element < elements; element++) {
+        __zcm_encode_be(data + pos, &p[element].x, 1, 8);
+        pos += 8;
+        __zcm_encode_be(data + pos, &p[element].y, 1, 8);
+        pos += 8;
+    }
+    return pos;
+}
+
+int view_point_encode(void *buf, int offset, int maxlen, const view_point *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __view_point_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __view_point_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __view_point_encoded_array_size(const view_point *p, int elements)
+{
+    (void)p;
+    return elements * (VIEW_POINT_ENCODED_SIZE - 8);
+}
+
+int view_point_encoded_size(const view_point *p)
+{
+    return 8 + __view_point_encoded_array_size(p, 1);
+}
+
+int __view_point_decode_array(const void *buf, int offset, int maxlen, view_point *p, int elements)
+{
+    const uint8_t *data = (const uint8_t*) buf + offset;
+    int pos = 0, element;
+
+    if (maxlen < elements * (VIEW_POINT_ENCODED_SIZE - 8)) return -1;
+
+#ifdef __ZCM_BIG_ENDIAN_HOST
+    if (sizeof(view_point) == (VIEW_POINT_ENCODED_SIZE - 8)) {
+        memcpy(p, data, elements * (VIEW_POINT_ENCODED_SIZE - 8));
+        return elements * (VIEW_POINT_ENCODED_SIZE - 8);
+    }
+#endif
+
+    for (element = 0; element < elements; element++) {
+        __zcm_decode_be(&p[element].x, data + pos, 1, 8);
+        pos += 8;
+        __zcm_decode_be(&p[element].y, data + pos, 1, 8);
+        pos += 8;
+    }
+    return pos;
+}
+
+int __view_point_decode_array_cleanup(view_point *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __double_decode_array_cleanup(&(p[element].x), 1);
+
+        __double_decode_array_cleanup(&(p[element].y), 1);
+
+    }
+    return 0;
+}
+
+int view_point_decode(const void *buf, int offset, int maxlen, view_point *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __view_point_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __view_point_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int view_point_decode_cleanup(view_point *p)
+{
+    return __view_point_decode_array_cleanup(p, 1);
+}
+
+int __view_point_clone_array(const view_point *p, view_point *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __double_clone_array(&(p[element].x), &(q[element].x), 1);
+
+        __double_clone_array(&(p[element].y), &(q[element].y), 1);
+
+    }
+    return 0;
+}
+
+view_point *view_point_copy(const view_point *p)
+{
+    view_point *q = (view_point*) malloc(sizeof(view_point));
+    __view_point_clone_array(p, q, 1);
+    return q;
+}
+
+void view_point_destroy(view_point *p)
+{
+    __view_point_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int view_point_publish(zcm_t *lc, const char *channel, const view_point *p)
+{
+      int max_data_size = view_point_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = view_point_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _view_point_subscription_t {
+    view_point_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+};
+static
+void view_point_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    view_point p;
+    memset(&p, 0, sizeof(view_point));
+    status = view_point_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding view_point!!!\n", status);
+        return;
+    }
+
+    view_point_subscription_t *h = (view_point_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    view_point_decode_cleanup (&p);
+}
+
+view_point_subscription_t* view_point_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    view_point_handler_t f, void *userdata)
+{
+    view_point_subscription_t *n = (view_point_subscription_t*)
+                       malloc(sizeof(view_point_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              view_point_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg view_point ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int view_point_unsubscribe(zcm_t *zcm, view_point_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe view_point_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,132 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _view_point_h
+#define _view_point_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _view_point view_point;
+struct _view_point
+{
+    double     x;
+    double     y;
+};
+
+/**
+ * Every view_point encodes to exactly this many bytes (including the hash)
+ */
+#define VIEW_POINT_ENCODED_SIZE 24
+
+/**
+ * Create a deep copy of a view_point.
+ * When no longer needed, destroy it with view_point_destroy()
+ */
+view_point* view_point_copy(const view_point* to_copy);
+
+/**
+ * Destroy an instance of view_point created by view_point_copy()
+ */
+void view_point_destroy(view_point* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _view_point_subscription_t view_point_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * view_point is received.
+ */
+typedef void(*view_point_handler_t)(const zcm_recv_buf_t *rbuf,
+             const char *channel, const view_point *msg, void *userdata);
+
+/**
+ * Publish a message of type view_point using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int view_point_publish(zcm_t *zcm, const char *channel, const view_point *msg);
+
+/**
+ * Subscribe to messages of type view_point using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to view_point_unsubscribe.
+ */
+view_point_subscription_t* view_point_subscribe(zcm_t *zcm, const char *channel, view_point_handler_t handler, void *userdata);
+
+/**
+ * Removes and destroys a subscription created by view_point_subscribe()
+ */
+int view_point_unsubscribe(zcm_t *zcm, view_point_subscription_t* hid);
+/**
+ * Encode a message of type view_point into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to view_point_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int view_point_encode(void *buf, int offset, int maxlen, const view_point *p);
+
+/**
+ * Decode a message of type view_point from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with view_point_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int view_point_decode(const void *buf, int offset, int maxlen, view_point *msg);
+
+/**
+ * Release resources allocated by view_point_decode()
+ * @return 0
+ */
+int view_point_decode_cleanup(view_point *p);
+
+/**
+ * Check how many bytes are required to encode a message of type view_point
+ */
+int view_point_encoded_size(const view_point *p);
+
+// ZCM support functions. Users should not call these
+int64_t __view_point_get_hash(void);
+uint64_t __view_point_hash_recursive(const __zcm_hash_ptr *p);
+int     __view_point_encode_array(void *buf, int offset, int maxlen, const view_point *p, int elements);
+int     __view_point_decode_array(const void *buf, int offset, int maxlen, view_point *p, int elements);
+int     __view_point_decode_array_cleanup(view_point *p, int elements);
+int     __view_point_encoded_array_size(const view_point *p, int elements);
+int     __view_point_clone_array(const view_point *p, view_point *q, int elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
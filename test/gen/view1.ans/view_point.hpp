@@ -0,0 +1,290 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+ * BY HAND!!
+ *
+ * Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm_view.hpp>
+
+#ifndef __view_point_hpp__
+#define __view_point_hpp__
+
+
+
+class view_point
+{
+    public:
+        double     x;
+
+        double     y;
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~view_point() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void *buf, int offset, int maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline int getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "view_point"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int _encodeNoHash(void *buf, int offset, int maxlen) const;
+        inline int _getEncodedSizeNoHash() const;
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr *p);
+        // Caller guarantees that buf holds at least _getEncodedSizeNoHash() bytes
+        inline int _encodeNoHashUnchecked(void *buf, int offset) const;
+
+        // Encoded size of this type (without hash) if it never varies, -1 otherwise
+        enum { _fixedEncodedSizeNoHash = 16 };
+};
+
+int view_point::encode(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+    int64_t hash = (int64_t)getHash();
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int view_point::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int view_point::getEncodedSize() const
+{
+    return 8 + _getEncodedSizeNoHash();
+}
+
+int64_t view_point::getHash()
+{
+    static int64_t hash = _computeHash(NULL);
+    return hash;
+}
+
+const char* view_point::getTypeName()
+{
+    return "view_point";
+}
+
+int view_point::_encodeNoHash(void *buf, int offset, int maxlen) const
+{
+    if (_fixedEncodedSizeNoHash >= 0) {
+        if (maxlen < _fixedEncodedSizeNoHash) return -1;
+        return this->_encodeNoHashUnchecked(buf, offset);
+    }
+
+    int pos = 0, tlen;
+
+    tlen = __double_encode_array(buf, offset + pos, maxlen - pos, &this->x, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __double_encode_array(buf, offset + pos, maxlen - pos, &this->y, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int view_point::_encodeNoHashUnchecked(void *buf, int offset) const
+{
+    uint8_t *p = (uint8_t*) buf + offset;
+    int pos = 0;
+
+    __zcm_encode_be(p + pos, &this->x, 1, 8);
+    pos += 8;
+    __zcm_encode_be(p + pos, &this->y, 1, 8);
+    pos += 8;
+
+    return pos;
+}
+
+int view_point::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+
+    tlen = __double_decode_array(buf, offset + pos, maxlen - pos, &this->x, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __double_decode_array(buf, offset + pos, maxlen - pos, &this->y, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int view_point::_getEncodedSizeNoHash() const
+{
+    if (_fixedEncodedSizeNoHash >= 0) return _fixedEncodedSizeNoHash;
+    int enc_size = 0;
+    enc_size += __double_encoded_array_size(NULL, 1);
+    enc_size += __double_encoded_array_size(NULL, 1);
+    return enc_size;
+}
+
+uint64_t view_point::_computeHash(const __zcm_hash_ptr *)
+{
+    uint64_t hash = (uint64_t)0xa8644c145ac1631aLL;
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+/**
+ * A zero-copy, read-only view of an encoded view_point.
+ * decode() only walks the lengths of the message; every field is read
+ * straight out of the encoded buffer when its accessor is called.
+ * The buffer passed to decode() must outlive the view.
+ */
+class view_pointView
+{
+    public:
+        inline view_pointView() : _buf(NULL), _len(0) {}
+
+        /**
+         * Validate an encoded message and point this view at it.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to read while validating.
+         * @return The number of bytes spanned by the message, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Returns true if this view currently points at a valid message
+         */
+        inline bool good() const { return _buf != NULL; }
+
+        /**
+         * Decode the whole message into @p msg.
+         */
+        inline int copyTo(view_point& msg) const { return msg._decodeNoHash(_buf, 0, _len); }
+
+        inline static int64_t getHash() { return view_point::getHash(); }
+        inline static const char* getTypeName() { return view_point::getTypeName(); }
+
+        // Field accessors. Arrays of strings and zcmtypes take a flattened
+        // (row-major) index; none are bounds checked. Elements of fixed size
+        // are found directly, others by walking on from the last element read,
+        // so iterating over an array is linear. That makes a view unsafe to
+        // share between threads
+        inline double x() const;
+        inline double y() const;
+
+        // ZCM support functions. Users should not call these
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+
+    private:
+        const uint8_t *_buf;
+        int _len;
+        int _offsets[2];
+        // Index and offset of the last element read from each array of
+        // strings or zcmtypes
+        mutable int _lastIdx[2];
+        mutable int _lastPos[2];
+};
+
+int view_pointView::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+    _buf = NULL;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) { _buf = NULL; return thislen; } else pos += thislen;
+
+    return pos;
+}
+
+int view_pointView::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+    int64_t n;
+    (void)tlen; (void)n;
+
+    _buf = (const uint8_t*)buf + offset;
+    _len = maxlen;
+
+    _offsets[0] = pos;
+    n = 1;
+    if (n * (int64_t)sizeof(double) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(double);
+
+    _offsets[1] = pos;
+    n = 1;
+    if (n * (int64_t)sizeof(double) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(double);
+
+    return pos;
+}
+
+double view_pointView::x() const
+{
+    double v;
+    __double_decode_array(_buf, _offsets[0], sizeof(v), &v, 1);
+    return v;
+}
+
+double view_pointView::y() const
+{
+    double v;
+    __double_decode_array(_buf, _offsets[1], sizeof(v), &v, 1);
+    return v;
+}
+
+#endif
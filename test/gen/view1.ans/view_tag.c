@@ -0,0 +1,251 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include "view_tag.h"
+
+static int __view_tag_hash_computed;
+static uint64_t __view_tag_hash;
+
+uint64_t __view_tag_hash_recursive(const __zcm_hash_ptr *p)
+{
+    const __zcm_hash_ptr *fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __view_tag_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__view_tag_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x1cadbabf7d1aa575LL
+         + __string_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __int16_t_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __view_tag_get_hash(void)
+{
+    if (!__view_tag_hash_computed) {
+        __view_tag_hash = (int64_t)__view_tag_hash_recursive(NULL);
+        __view_tag_hash_computed = 1;
+    }
+
+    return __view_tag_hash;
+}
+
+int __view_tag_encode_array(void *buf, int offset, int maxlen, const view_tag *p, int elements)
+{
+    int pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int16_t_encode_array(buf, offset + pos, maxlen - pos, p[element].v, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int view_tag_encode(void *buf, int offset, int maxlen, const view_tag *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __view_tag_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __view_tag_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int __view_tag_encoded_array_size(const view_tag *p, int elements)
+{
+    int size = 0, element;
+    for (element = 0; element < elements; element++) {
+
+        size += __string_encoded_array_size(&(p[element].name), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].n), 1);
+
+        size += __int16_t_encoded_array_size(p[element].v, p[element].n);
+
+    }
+    return size;
+}
+
+int view_tag_encoded_size(const view_tag *p)
+{
+    return 8 + __view_tag_encoded_array_size(p, 1);
+}
+
+int __view_tag_decode_array(const void *buf, int offset, int maxlen, view_tag *p, int elements)
+{
+    int pos = 0, thislen, element;
+
+    for (element = 0; element < elements; element++) {
+
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].n), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].v = (int16_t*) zcm_malloc(sizeof(int16_t) * p[element].n);
+        thislen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, p[element].v, p[element].n);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __view_tag_decode_array_cleanup(view_tag *p, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __string_decode_array_cleanup(&(p[element].name), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].n), 1);
+
+        __int16_t_decode_array_cleanup(p[element].v, p[element].n);
+        if (p[element].v) free(p[element].v);
+
+    }
+    return 0;
+}
+
+int view_tag_decode(const void *buf, int offset, int maxlen, view_tag *p)
+{
+    int pos = 0, thislen;
+    int64_t hash = __view_tag_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __view_tag_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int view_tag_decode_cleanup(view_tag *p)
+{
+    return __view_tag_decode_array_cleanup(p, 1);
+}
+
+int __view_tag_clone_array(const view_tag *p, view_tag *q, int elements)
+{
+    int element;
+    for (element = 0; element < elements; element++) {
+
+        __string_clone_array(&(p[element].name), &(q[element].name), 1);
+
+        __int32_t_clone_array(&(p[element].n), &(q[element].n), 1);
+
+        q[element].v = (int16_t*) zcm_malloc(sizeof(int16_t) * q[element].n);
+        __int16_t_clone_array(p[element].v, q[element].v, p[element].n);
+
+    }
+    return 0;
+}
+
+view_tag *view_tag_copy(const view_tag *p)
+{
+    view_tag *q = (view_tag*) malloc(sizeof(view_tag));
+    __view_tag_clone_array(p, q, 1);
+    return q;
+}
+
+void view_tag_destroy(view_tag *p)
+{
+    __view_tag_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int view_tag_publish(zcm_t *lc, const char *channel, const view_tag *p)
+{
+      int max_data_size = view_tag_encoded_size (p);
+      uint8_t *buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = view_tag_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (lc, channel, (char *)buf, (size_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _view_tag_subscription_t {
+    view_tag_handler_t user_handler;
+    void *userdata;
+    zcm_sub_t *z_sub;
+};
+static
+void view_tag_handler_stub (const zcm_recv_buf_t *rbuf,
+                            const char *channel, void *userdata)
+{
+    int status;
+    view_tag p;
+    memset(&p, 0, sizeof(view_tag));
+    status = view_tag_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        fprintf (stderr, "error %d decoding view_tag!!!\n", status);
+        return;
+    }
+
+    view_tag_subscription_t *h = (view_tag_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    view_tag_decode_cleanup (&p);
+}
+
+view_tag_subscription_t* view_tag_subscribe (zcm_t *zcm,
+                    const char *channel,
+                    view_tag_handler_t f, void *userdata)
+{
+    view_tag_subscription_t *n = (view_tag_subscription_t*)
+                       malloc(sizeof(view_tag_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              view_tag_handler_stub, n);
+    if (n->z_sub == NULL) {
+        fprintf (stderr,"couldn't reg view_tag ZCM handler!\n");
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int view_tag_unsubscribe(zcm_t *zcm, view_tag_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        fprintf(stderr,
+           "couldn't unsubscribe view_tag_handler %p!\n", hid);
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,128 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+// BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _view_tag_h
+#define _view_tag_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _view_tag view_tag;
+struct _view_tag
+{
+    char*      name;
+    int32_t    n;
+    int16_t    *v;
+};
+
+/**
+ * Create a deep copy of a view_tag.
+ * When no longer needed, destroy it with view_tag_destroy()
+ */
+view_tag* view_tag_copy(const view_tag* to_copy);
+
+/**
+ * Destroy an instance of view_tag created by view_tag_copy()
+ */
+void view_tag_destroy(view_tag* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _view_tag_subscription_t view_tag_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * view_tag is received.
+ */
+typedef void(*view_tag_handler_t)(const zcm_recv_buf_t *rbuf,
+             const char *channel, const view_tag *msg, void *userdata);
+
+/**
+ * Publish a message of type view_tag using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int view_tag_publish(zcm_t *zcm, const char *channel, const view_tag *msg);
+
+/**
+ * Subscribe to messages of type view_tag using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to view_tag_unsubscribe.
+ */
+view_tag_subscription_t* view_tag_subscribe(zcm_t *zcm, const char *channel, view_tag_handler_t handler, void *userdata);
+
+/**
+ * Removes and destroys a subscription created by view_tag_subscribe()
+ */
+int view_tag_unsubscribe(zcm_t *zcm, view_tag_subscription_t* hid);
+/**
+ * Encode a message of type view_tag into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to view_tag_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int view_tag_encode(void *buf, int offset, int maxlen, const view_tag *p);
+
+/**
+ * Decode a message of type view_tag from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with view_tag_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int view_tag_decode(const void *buf, int offset, int maxlen, view_tag *msg);
+
+/**
+ * Release resources allocated by view_tag_decode()
+ * @return 0
+ */
+int view_tag_decode_cleanup(view_tag *p);
+
+/**
+ * Check how many bytes are required to encode a message of type view_tag
+ */
+int view_tag_encoded_size(const view_tag *p);
+
+// ZCM support functions. Users should not call these
+int64_t __view_tag_get_hash(void);
+uint64_t __view_tag_hash_recursive(const __zcm_hash_ptr *p);
+int     __view_tag_encode_array(void *buf, int offset, int maxlen, const view_tag *p, int elements);
+int     __view_tag_decode_array(const void *buf, int offset, int maxlen, view_tag *p, int elements);
+int     __view_tag_decode_array_cleanup(view_tag *p, int elements);
+int     __view_tag_encoded_array_size(const view_tag *p, int elements);
+int     __view_tag_clone_array(const view_tag *p, view_tag *q, int elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,314 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.  DO NOT MODIFY
+ * BY HAND!!
+ *
+ * Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm_view.hpp>
+
+#ifndef __view_tag_hpp__
+#define __view_tag_hpp__
+
+#include <string>
+#include <vector>
+
+
+class view_tag
+{
+    public:
+        std::string name;
+
+        int32_t    n;
+
+        std::vector< int16_t > v;
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~view_tag() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void *buf, int offset, int maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline int getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "view_tag"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int _encodeNoHash(void *buf, int offset, int maxlen) const;
+        inline int _getEncodedSizeNoHash() const;
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr *p);
+        // Caller guarantees that buf holds at least _getEncodedSizeNoHash() bytes
+        inline int _encodeNoHashUnchecked(void *buf, int offset) const;
+
+        // Encoded size of this type (without hash) if it never varies, -1 otherwise
+        enum { _fixedEncodedSizeNoHash = -1 };
+};
+
+int view_tag::encode(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+    int64_t hash = (int64_t)getHash();
+
+    tlen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (tlen < 0) return tlen; else pos += tlen;
+
+    return pos;
+}
+
+int view_tag::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int view_tag::getEncodedSize() const
+{
+    return 8 + _getEncodedSizeNoHash();
+}
+
+int64_t view_tag::getHash()
+{
+    static int64_t hash = _computeHash(NULL);
+    return hash;
+}
+
+const char* view_tag::getTypeName()
+{
+    return "view_tag";
+}
+
+int view_tag::_encodeNoHash(void *buf, int offset, int maxlen) const
+{
+    int pos = 0, tlen;
+
+    char* name_cstr = (char*) this->name.c_str();
+    tlen = __string_encode_array(buf, offset + pos, maxlen - pos, &name_cstr, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    tlen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &this->n, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    if(this->n > 0) {
+        tlen = __int16_t_encode_array(buf, offset + pos, maxlen - pos, &this->v[0], this->n);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    return pos;
+}
+
+int view_tag::_encodeNoHashUnchecked(void *buf, int offset) const
+{
+    return this->_encodeNoHash(buf, offset, 0x7fffffff - offset);
+}
+
+int view_tag::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+
+    int32_t __name_len__;
+    tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &__name_len__, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+    if(__name_len__ > maxlen - pos) return -1;
+    this->name.assign(((const char*)buf) + offset + pos, __name_len__ - 1);
+    pos += __name_len__;
+
+    tlen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &this->n, 1);
+    if(tlen < 0) return tlen; else pos += tlen;
+
+    if(this->n > 0) {
+        this->v.resize(this->n);
+        tlen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, &this->v[0], this->n);
+        if(tlen < 0) return tlen; else pos += tlen;
+    }
+
+    return pos;
+}
+
+int view_tag::_getEncodedSizeNoHash() const
+{
+    int enc_size = 0;
+    enc_size += this->name.size() + 4 + 1;
+    enc_size += __int32_t_encoded_array_size(NULL, 1);
+    enc_size += __int16_t_encoded_array_size(NULL, this->n);
+    return enc_size;
+}
+
+uint64_t view_tag::_computeHash(const __zcm_hash_ptr *)
+{
+    uint64_t hash = (uint64_t)0x1cadbabf7d1aa575LL;
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+/**
+ * A zero-copy, read-only view of an encoded view_tag.
+ * decode() only walks the lengths of the message; every field is read
+ * straight out of the encoded buffer when its accessor is called.
+ * The buffer passed to decode() must outlive the view.
+ */
+class view_tagView
+{
+    public:
+        inline view_tagView() : _buf(NULL), _len(0) {}
+
+        /**
+         * Validate an encoded message and point this view at it.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to read while validating.
+         * @return The number of bytes spanned by the message, or <0 if an error occured.
+         */
+        inline int decode(const void *buf, int offset, int maxlen);
+
+        /**
+         * Returns true if this view currently points at a valid message
+         */
+        inline bool good() const { return _buf != NULL; }
+
+        /**
+         * Decode the whole message into @p msg.
+         */
+        inline int copyTo(view_tag& msg) const { return msg._decodeNoHash(_buf, 0, _len); }
+
+        inline static int64_t getHash() { return view_tag::getHash(); }
+        inline static const char* getTypeName() { return view_tag::getTypeName(); }
+
+        // Field accessors. Arrays of strings and zcmtypes take a flattened
+        // (row-major) index; none are bounds checked. Elements of fixed size
+        // are found directly, others by walking on from the last element read,
+        // so iterating over an array is linear. That makes a view unsafe to
+        // share between threads
+        inline const char* name() const;
+        inline int32_t n() const;
+        inline zcm::ArrayView<int16_t> v() const;
+
+        // ZCM support functions. Users should not call these
+        inline int _decodeNoHash(const void *buf, int offset, int maxlen);
+
+    private:
+        const uint8_t *_buf;
+        int _len;
+        int _offsets[3];
+        // Index and offset of the last element read from each array of
+        // strings or zcmtypes
+        mutable int _lastIdx[3];
+        mutable int _lastPos[3];
+};
+
+int view_tagView::decode(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, thislen;
+    _buf = NULL;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) { _buf = NULL; return thislen; } else pos += thislen;
+
+    return pos;
+}
+
+int view_tagView::_decodeNoHash(const void *buf, int offset, int maxlen)
+{
+    int pos = 0, tlen;
+    int64_t n;
+    (void)tlen; (void)n;
+
+    _buf = (const uint8_t*)buf + offset;
+    _len = maxlen;
+
+    _offsets[0] = pos;
+    n = 1;
+    for (int64_t i = 0; i < n; i++) {
+        int32_t len;
+        tlen = __int32_t_decode_array(_buf, pos, maxlen - pos, &len, 1);
+        if (tlen < 0) return tlen; else pos += tlen;
+        if (len < 1 || len > maxlen - pos || _buf[pos + len - 1] != 0) return -1;
+        pos += len;
+    }
+
+    _offsets[1] = pos;
+    n = 1;
+    if (n * (int64_t)sizeof(int32_t) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(int32_t);
+
+    _offsets[2] = pos;
+    n = 1;
+    n *= (int64_t)this->n();
+    if (n < 0 || n > maxlen) return -1;
+    if (n * (int64_t)sizeof(int16_t) > maxlen - pos) return -1;
+    pos += (int)n * (int)sizeof(int16_t);
+
+    return pos;
+}
+
+const char* view_tagView::name() const
+{
+    int pos = _offsets[0];
+    return (const char*)_buf + pos + 4;
+}
+
+int32_t view_tagView::n() const
+{
+    int32_t v;
+    __int32_t_decode_array(_buf, _offsets[1], sizeof(v), &v, 1);
+    return v;
+}
+
+zcm::ArrayView<int16_t> view_tagView::v() const
+{
+    return zcm::ArrayView<int16_t>(_buf + _offsets[2], (int)(this->n()));
+}
+
+#endif
@@ -0,0 +1,180 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class view1 implements zcm.zcm.ZCMEncodable
+{
+    public long utime;
+    public int n;
+    public float samples[];
+    public double pose[][];
+    public String name;
+    public String labels[];
+    public zcmtypes.view_point points[];
+    public zcmtypes.view_tag tags[];
+ 
+    public view1()
+    {
+        pose = new double[2][3];
+        tags = new zcmtypes.view_tag[2];
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0x6e12446524b5b108L;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.view1.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.view1.class);
+        long hash = ZCM_FINGERPRINT_BASE
+             + zcmtypes.view_point._hashRecursive(classes)
+             + zcmtypes.view_tag._hashRecursive(classes)
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        char[] __strbuf = null;
+        outs.writeLong(this.utime); 
+ 
+        outs.writeInt(this.n); 
+ 
+        for (int a = 0; a < this.n; a++) {
+            outs.writeFloat(this.samples[a]); 
+        }
+ 
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 3; b++) {
+                outs.writeDouble(this.pose[a][b]); 
+            }
+        }
+ 
+        __strbuf = new char[this.name.length()]; this.name.getChars(0, this.name.length(), __strbuf, 0); outs.writeInt(__strbuf.length+1); for (int _i = 0; _i < __strbuf.length; _i++) outs.write(__strbuf[_i]); outs.writeByte(0); 
+ 
+        for (int a = 0; a < this.n; a++) {
+            __strbuf = new char[this.labels[a].length()]; this.labels[a].getChars(0, this.labels[a].length(), __strbuf, 0); outs.writeInt(__strbuf.length+1); for (int _i = 0; _i < __strbuf.length; _i++) outs.write(__strbuf[_i]); outs.writeByte(0); 
+        }
+ 
+        for (int a = 0; a < this.n; a++) {
+            this.points[a]._encodeRecursive(outs); 
+        }
+ 
+        for (int a = 0; a < 2; a++) {
+            this.tags[a]._encodeRecursive(outs); 
+        }
+ 
+    }
+ 
+    public view1(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public view1(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.view1 _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.view1 o = new zcmtypes.view1();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        char[] __strbuf = null;
+        this.utime = ins.readLong();
+ 
+        this.n = ins.readInt();
+ 
+        this.samples = new float[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            this.samples[a] = ins.readFloat();
+        }
+ 
+        this.pose = new double[(int) 2][(int) 3];
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 3; b++) {
+                this.pose[a][b] = ins.readDouble();
+            }
+        }
+ 
+        __strbuf = new char[ins.readInt()-1]; for (int _i = 0; _i < __strbuf.length; _i++) __strbuf[_i] = (char) (ins.readByte()&0xff); ins.readByte(); this.name = new String(__strbuf);
+ 
+        this.labels = new String[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            __strbuf = new char[ins.readInt()-1]; for (int _i = 0; _i < __strbuf.length; _i++) __strbuf[_i] = (char) (ins.readByte()&0xff); ins.readByte(); this.labels[a] = new String(__strbuf);
+        }
+ 
+        this.points = new zcmtypes.view_point[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            this.points[a] = zcmtypes.view_point._decodeRecursiveFactory(ins);
+        }
+ 
+        this.tags = new zcmtypes.view_tag[(int) 2];
+        for (int a = 0; a < 2; a++) {
+            this.tags[a] = zcmtypes.view_tag._decodeRecursiveFactory(ins);
+        }
+ 
+    }
+ 
+    public zcmtypes.view1 copy()
+    {
+        zcmtypes.view1 outobj = new zcmtypes.view1();
+        outobj.utime = this.utime;
+ 
+        outobj.n = this.n;
+ 
+        outobj.samples = new float[(int) n];
+        if (this.n > 0)
+            System.arraycopy(this.samples, 0, outobj.samples, 0, this.n); 
+        outobj.pose = new double[(int) 2][(int) 3];
+        for (int a = 0; a < 2; a++) {
+            System.arraycopy(this.pose[a], 0, outobj.pose[a], 0, 3);        }
+ 
+        outobj.name = this.name;
+ 
+        outobj.labels = new String[(int) n];
+        if (this.n > 0)
+            System.arraycopy(this.labels, 0, outobj.labels, 0, this.n); 
+        outobj.points = new zcmtypes.view_point[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            outobj.points[a] = this.points[a].copy();
+        }
+ 
+        outobj.tags = new zcmtypes.view_tag[(int) 2];
+        for (int a = 0; a < 2; a++) {
+            outobj.tags[a] = this.tags[a].copy();
+        }
+ 
+        return outobj;
+    }
+ 
+}
+
@@ -0,0 +1,93 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class view_point implements zcm.zcm.ZCMEncodable
+{
+    public double x;
+    public double y;
+ 
+    public view_point()
+    {
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0xa8644c145ac1631aL;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.view_point.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.view_point.class);
+        long hash = ZCM_FINGERPRINT_BASE
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        outs.writeDouble(this.x); 
+ 
+        outs.writeDouble(this.y); 
+ 
+    }
+ 
+    public view_point(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public view_point(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.view_point _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.view_point o = new zcmtypes.view_point();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        this.x = ins.readDouble();
+ 
+        this.y = ins.readDouble();
+ 
+    }
+ 
+    public zcmtypes.view_point copy()
+    {
+        zcmtypes.view_point outobj = new zcmtypes.view_point();
+        outobj.x = this.x;
+ 
+        outobj.y = this.y;
+ 
+        return outobj;
+    }
+ 
+}
+
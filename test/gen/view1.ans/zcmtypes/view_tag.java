@@ -0,0 +1,108 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class view_tag implements zcm.zcm.ZCMEncodable
+{
+    public String name;
+    public int n;
+    public short v[];
+ 
+    public view_tag()
+    {
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0x1cadbabf7d1aa575L;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.view_tag.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.view_tag.class);
+        long hash = ZCM_FINGERPRINT_BASE
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        char[] __strbuf = null;
+        __strbuf = new char[this.name.length()]; this.name.getChars(0, this.name.length(), __strbuf, 0); outs.writeInt(__strbuf.length+1); for (int _i = 0; _i < __strbuf.length; _i++) outs.write(__strbuf[_i]); outs.writeByte(0); 
+ 
+        outs.writeInt(this.n); 
+ 
+        for (int a = 0; a < this.n; a++) {
+            outs.writeShort(this.v[a]); 
+        }
+ 
+    }
+ 
+    public view_tag(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public view_tag(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.view_tag _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.view_tag o = new zcmtypes.view_tag();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        char[] __strbuf = null;
+        __strbuf = new char[ins.readInt()-1]; for (int _i = 0; _i < __strbuf.length; _i++) __strbuf[_i] = (char) (ins.readByte()&0xff); ins.readByte(); this.name = new String(__strbuf);
+ 
+        this.n = ins.readInt();
+ 
+        this.v = new short[(int) n];
+        for (int a = 0; a < this.n; a++) {
+            this.v[a] = ins.readShort();
+        }
+ 
+    }
+ 
+    public zcmtypes.view_tag copy()
+    {
+        zcmtypes.view_tag outobj = new zcmtypes.view_tag();
+        outobj.name = this.name;
+ 
+        outobj.n = this.n;
+ 
+        outobj.v = new short[(int) n];
+        if (this.n > 0)
+            System.arraycopy(this.v, 0, outobj.v, 0, this.n); 
+        return outobj;
+    }
+ 
+}
+
@@ -96,6 +96,21 @@ static zcm_trans_t *transport_sub_create(zcm_url_t *url)
     return &sub_trans;
 }
 
+static zcm_trans_methods_t nonblock_methods;
+static zcm_trans_t nonblock_trans;
+static size_t nonblock_get_mtu(zcm_trans_t *zt) { return 4*GENERIC_MTU; }
+static int    nonblock_sendmsg(zcm_trans_t *zt, zcm_msg_t msg) { return ZCM_EOK; }
+static int    nonblock_update(zcm_trans_t *zt) { return ZCM_EOK; }
+static zcm_trans_t *transport_nonblock_create(zcm_url_t *url)
+{
+    init_generic(&nonblock_trans, &nonblock_methods);
+    nonblock_trans.trans_type = ZCM_NONBLOCKING;
+    nonblock_methods.get_mtu = nonblock_get_mtu;
+    nonblock_methods.sendmsg = nonblock_sendmsg;
+    nonblock_methods.update = nonblock_update;
+    return &nonblock_trans;
+}
+
 static void register_transports(void)
 {
     ENSURE(zcm_transport_register(
@@ -109,6 +124,9 @@ static void register_transports(void)
 
     ENSURE(zcm_transport_register(
         "test-sub", "", transport_sub_create));
+
+    ENSURE(zcm_transport_register(
+        "test-nonblock", "", transport_nonblock_create));
 }
 
 static void test_fail_construct(void)
@@ -195,6 +213,71 @@ static void test_publish_msgdrop(void)
     zcm_cleanup(&zcm);
 }
 
+static void test_publish_reserve(void)
+{
+    zcm_t zcm;
+    zcm_init(&zcm, "test-generic");
+    zcm_start(&zcm);
+
+    /* too big for the mtu */
+    ENSURE(NULL == zcm_publish_reserve(&zcm, "FOO", GENERIC_MTU+1));
+    ENSURE(ZCM_EINVALID == zcm_errno(&zcm));
+
+    /* reserve, fill, and commit */
+    char *buf = zcm_publish_reserve(&zcm, "FOO", GENERIC_MTU);
+    ENSURE(NULL != buf);
+    ENSURE(ZCM_EOK == zcm_errno(&zcm));
+    memset(buf, 'A', GENERIC_MTU);
+    ENSURE(0 == zcm_publish_commit(&zcm, buf));
+    ENSURE(ZCM_EOK == zcm_errno(&zcm));
+
+    /* a committed buffer can't be committed or aborted again */
+    ENSURE(-1 == zcm_publish_commit(&zcm, buf));
+    ENSURE(ZCM_EINVALID == zcm_errno(&zcm));
+    ENSURE(-1 == zcm_publish_abort(&zcm, buf));
+    ENSURE(ZCM_EINVALID == zcm_errno(&zcm));
+
+    /* reserve and abort */
+    ENSURE(NULL != (buf = zcm_publish_reserve(&zcm, "FOO", 1)));
+    ENSURE(0 == zcm_publish_abort(&zcm, buf));
+    ENSURE(-1 == zcm_publish_commit(&zcm, buf));
+    ENSURE(ZCM_EINVALID == zcm_errno(&zcm));
+
+    /* leftover reservations are reclaimed on cleanup */
+    ENSURE(NULL != zcm_publish_reserve(&zcm, "FOO", 1));
+
+    zcm_flush(&zcm);
+    zcm_stop(&zcm);
+    zcm_cleanup(&zcm);
+}
+
+static void test_publish_reserve_nonblock(void)
+{
+    zcm_t zcm;
+    ENSURE(0 == zcm_init(&zcm, "test-nonblock"));
+
+    /* fits the mtu, but not the preallocated buffer (ZCM_NONBLOCK_RESERVE_MAX) */
+    ENSURE(NULL == zcm_publish_reserve(&zcm, "FOO", 257));
+    ENSURE(ZCM_EINVALID == zcm_errno(&zcm));
+
+    /* only one reservation at a time */
+    char *buf = zcm_publish_reserve(&zcm, "FOO", 256);
+    ENSURE(NULL != buf);
+    memset(buf, 'A', 256);
+    ENSURE(NULL == zcm_publish_reserve(&zcm, "FOO", 1));
+    ENSURE(ZCM_EAGAIN == zcm_errno(&zcm));
+    ENSURE(0 == zcm_publish_commit(&zcm, buf));
+    ENSURE(-1 == zcm_publish_commit(&zcm, buf));
+    ENSURE(ZCM_EINVALID == zcm_errno(&zcm));
+
+    /* the same buffer is loaned out again */
+    ENSURE(buf == zcm_publish_reserve(&zcm, "FOO", 1));
+    ENSURE(0 == zcm_publish_abort(&zcm, buf));
+    ENSURE(-1 == zcm_publish_abort(&zcm, buf));
+
+    zcm_cleanup(&zcm);
+}
+
 static void test_sub(void)
 {
     zcm_t zcm;
@@ -222,5 +305,7 @@ int main(void)
     test_fail_construct();
     test_publish();
     test_publish_msgdrop();
+    test_publish_reserve();
+    test_publish_reserve_nonblock();
     test_sub();
 }
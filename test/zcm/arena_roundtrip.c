@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The checked in answers of test/gen/arena1.zcm, which scripts/test-gen.sh keeps
+   in sync with zcm-gen --c-arena */
+#include "arena1.h"
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+#define N 4
+#define ROWS 3
+#define ARENA_SIZE 4096
+#define CANARY 0x5a
+
+static char *names[N] = { "zero", "one", "", "three three" };
+
+static int encodeMsg(char *buf, int max)
+{
+    arena1 msg;
+    arena_item items[N];
+    int16_t data[N];
+    char *tags[N];
+    float rowData[ROWS][2];
+    float *grid[ROWS];
+    double values[N][N];
+    int i, j;
+
+    msg.utime = 0x0102030405060708LL;
+    msg.name = "arena";
+    msg.n = N;
+    for (i = 0; i < N; ++i) {
+        data[i] = -i;
+        tags[i] = names[N - 1 - i];
+        items[i].label = names[i];
+        items[i].n = i;
+        for (j = 0; j < i; ++j)
+            values[i][j] = i * 0.5 + j;
+        items[i].values = values[i];
+    }
+    msg.data = data;
+    msg.tags = tags;
+    msg.items = items;
+    msg.rows = ROWS;
+    for (i = 0; i < ROWS; ++i) {
+        rowData[i][0] = i;
+        rowData[i][1] = -i;
+        grid[i] = rowData[i];
+    }
+    msg.grid = grid;
+
+    ENSURE(arena1_encoded_size(&msg) <= max);
+    return arena1_encode(buf, 0, max, &msg);
+}
+
+static void checkMsg(const arena1 *msg)
+{
+    int i, j;
+    ENSURE(msg->utime == 0x0102030405060708LL);
+    ENSURE(strcmp(msg->name, "arena") == 0);
+    ENSURE(msg->n == N);
+    for (i = 0; i < N; ++i) {
+        ENSURE(msg->data[i] == -i);
+        ENSURE(strcmp(msg->tags[i], names[N - 1 - i]) == 0);
+        ENSURE(strcmp(msg->items[i].label, names[i]) == 0);
+        ENSURE(msg->items[i].n == i);
+        for (j = 0; j < i; ++j)
+            ENSURE(msg->items[i].values[j] == i * 0.5 + j);
+    }
+    ENSURE(msg->rows == ROWS);
+    for (i = 0; i < ROWS; ++i) {
+        ENSURE(msg->grid[i][0] == i);
+        ENSURE(msg->grid[i][1] == -i);
+    }
+}
+
+int main(void)
+{
+    char buf[1024];
+    static char mem[ARENA_SIZE + 1];
+    zcm_arena_t arena;
+    arena1 msg;
+    int len, i;
+    size_t used;
+
+    len = encodeMsg(buf, sizeof(buf));
+    ENSURE(len > 0);
+
+    /* The heap and arena decoders agree */
+    ENSURE(arena1_decode(buf, 0, len, &msg) == len);
+    checkMsg(&msg);
+    arena1_decode_cleanup(&msg);
+
+    zcm_arena_init(&arena, mem, ARENA_SIZE);
+    ENSURE(arena1_decode_arena(buf, 0, len, &msg, &arena) == len);
+    checkMsg(&msg);
+    used = arena.used;
+    ENSURE(used > 0);
+    for (i = 0; i < N; ++i) {
+        ENSURE((char*)msg.tags[i] >= mem && (char*)msg.tags[i] < mem + used);
+        ENSURE((char*)msg.items[i].label >= mem && (char*)msg.items[i].label < mem + used);
+    }
+
+    /* Resetting releases everything, so decoding again takes the same space */
+    for (i = 0; i < 100; ++i) {
+        zcm_arena_reset(&arena);
+        ENSURE(arena1_decode_arena(buf, 0, len, &msg, &arena) == len);
+        ENSURE(arena.used == used);
+    }
+    checkMsg(&msg);
+
+    /* An arena that is too small fails the decode without overrunning it */
+    for (i = 0; i < (int)used; ++i) {
+        memset(mem, CANARY, sizeof(mem));
+        zcm_arena_init(&arena, mem, i);
+        ENSURE(arena1_decode_arena(buf, 0, len, &msg, &arena) < 0);
+        ENSURE(arena.used <= (size_t)i);
+        ENSURE(mem[i] == CANARY);
+    }
+
+    /* Every truncated message is rejected */
+    zcm_arena_init(&arena, mem, ARENA_SIZE);
+    for (i = 0; i < len; ++i) {
+        zcm_arena_reset(&arena);
+        ENSURE(arena1_decode_arena(buf, 0, i, &msg, &arena) < 0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+// Tests util/ChannelFilter.hpp: exact names win over regexes, regexes must match
+// the whole channel and are tried in the order they were added, and the cached
+// verdicts are always the ones the rules would give, even as the rules change
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/ChannelFilter.hpp"
+
+using namespace std;
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+typedef ChannelFilter::Verdict Verdict;
+
+// The rules evaluated from scratch on every lookup, one regex at a time
+struct Reference
+{
+    Verdict dflt = Verdict::PASS;
+    vector<pair<string, Verdict>> exact;
+    vector<pair<regex, Verdict>> regexes;
+
+    Verdict verdict(const string& channel) const
+    {
+        for (auto it = exact.rbegin(); it != exact.rend(); ++it)
+            if (it->first == channel) return it->second;
+        for (auto& r : regexes)
+            if (regex_match(channel, r.first)) return r.second;
+        return dflt;
+    }
+};
+
+static void testExactMatches()
+{
+    ChannelFilter filter;
+    ENSURE(filter.passes("ANY"));
+
+    filter.addChannel("POSE", Verdict::DROP);
+    ENSURE(filter.verdict("POSE") == Verdict::DROP);
+    ENSURE(filter.verdict("POSE2") == Verdict::PASS);
+    ENSURE(filter.verdict("pose") == Verdict::PASS);
+    ENSURE(filter.verdict("") == Verdict::PASS);
+
+    // Re-adding a channel replaces its verdict
+    filter.addChannel("POSE", Verdict::UNSPECIFIED);
+    ENSURE(filter.verdict("POSE") == Verdict::UNSPECIFIED);
+
+    filter.setDefault(Verdict::DROP);
+    ENSURE(!filter.passes("POSE2"));
+    filter.addChannel("POSE2", Verdict::PASS);
+    ENSURE(filter.passes("POSE2"));
+}
+
+static void testRegexMatches()
+{
+    ChannelFilter filter(Verdict::UNSPECIFIED);
+    filter.addRegex("CAM_.*", Verdict::PASS);
+    filter.addRegex("IMU|GPS", Verdict::PASS);
+    filter.addRegex(".*_DEBUG", Verdict::DROP);
+    filter.addRegex("CAM_.*_RAW", Verdict::DROP);
+
+    // Regexes match the whole channel
+    ENSURE(filter.verdict("CAM_LEFT") == Verdict::PASS);
+    ENSURE(filter.verdict("MY_CAM_LEFT") == Verdict::UNSPECIFIED);
+    ENSURE(filter.verdict("IMU") == Verdict::PASS);
+    ENSURE(filter.verdict("GPS") == Verdict::PASS);
+    ENSURE(filter.verdict("IMU_GPS") == Verdict::UNSPECIFIED);
+    ENSURE(filter.verdict("PLANNER_DEBUG") == Verdict::DROP);
+
+    // The first regex to match decides, even past one with another verdict
+    ENSURE(filter.verdict("CAM_LEFT_DEBUG") == Verdict::PASS);
+    ENSURE(filter.verdict("CAM_LEFT_RAW") == Verdict::PASS);
+
+    // Exact names are checked before any regex
+    filter.addChannel("CAM_BACK", Verdict::DROP);
+    filter.addChannel("IMU_DEBUG", Verdict::PASS);
+    ENSURE(filter.verdict("CAM_BACK") == Verdict::DROP);
+    ENSURE(filter.verdict("IMU_DEBUG") == Verdict::PASS);
+    ENSURE(filter.verdict("CAM_FRONT") == Verdict::PASS);
+
+    bool threw = false;
+    try {
+        filter.addRegex("CAM_(", Verdict::DROP);
+    } catch (const regex_error&) {
+        threw = true;
+    }
+    ENSURE(threw);
+}
+
+static vector<string> makeChannels()
+{
+    static const char* const prefixes[] = { "", "CAM_", "IMU", "GPS", "MY_", "POSE" };
+    static const char* const names[] = { "", "LEFT", "RIGHT", "A", "POSE", "X1" };
+    static const char* const suffixes[] = { "", "_RAW", "_DEBUG", "2", "_DEBUG_RAW" };
+    vector<string> channels;
+    for (auto p : prefixes)
+        for (auto n : names)
+            for (auto s : suffixes)
+                channels.push_back(string(p) + n + s);
+    return channels;
+}
+
+// Every lookup, whether it's the first one for its channel or a cached one, and
+// whether or not the rules changed since the channel was last seen, must agree
+// with the rules themselves
+static void testCachedMatchesUncached()
+{
+    vector<string> channels = makeChannels();
+    ChannelFilter filter;
+    Reference ref;
+
+    auto checkAll = [&]() {
+        for (int pass = 0; pass < 2; ++pass)
+            for (auto& c : channels)
+                ENSURE(filter.verdict(c) == ref.verdict(c));
+        // Looked up in the opposite order too, in case of order dependence
+        for (auto it = channels.rbegin(); it != channels.rend(); ++it)
+            ENSURE(filter.verdict(*it) == ref.verdict(*it));
+    };
+
+    auto addRegex = [&](const string& re, Verdict v) {
+        filter.addRegex(re, v);
+        ref.regexes.emplace_back(regex(re), v);
+        checkAll();
+    };
+    auto addChannel = [&](const string& channel, Verdict v) {
+        filter.addChannel(channel, v);
+        ref.exact.emplace_back(channel, v);
+        checkAll();
+    };
+    auto setDefault = [&](Verdict v) {
+        filter.setDefault(v);
+        ref.dflt = v;
+        checkAll();
+    };
+
+    checkAll();
+    addRegex("CAM_.*", Verdict::DROP);
+    addRegex(".*_RAW", Verdict::DROP);
+    addRegex(".*_DEBUG.*", Verdict::PASS);
+    addChannel("CAM_LEFT", Verdict::PASS);
+    setDefault(Verdict::UNSPECIFIED);
+    addRegex("IMU.*|GPS.*", Verdict::PASS);
+    addRegex("MY_.*", Verdict::DROP);
+    addChannel("MY_A", Verdict::PASS);
+    addChannel("CAM_LEFT", Verdict::DROP);
+    addRegex(".*", Verdict::PASS);
+    setDefault(Verdict::DROP);
+    addChannel("", Verdict::UNSPECIFIED);
+}
+
+int main()
+{
+    testExactMatches();
+    testRegexMatches();
+    testCachedMatchesUncached();
+    return 0;
+}
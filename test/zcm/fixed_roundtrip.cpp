@@ -0,0 +1,91 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// The checked in answers of test/gen/fixed_size1.zcm, which scripts/test-gen.sh
+// keeps in sync with zcm-gen
+#include "fixed_size1.hpp"
+
+using namespace std;
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+static fixed_size1 makeMsg()
+{
+    fixed_size1 msg;
+    msg.utime = 0x0102030405060708LL;
+    for (int i = 0; i < 4; ++i) {
+        msg.inner[i].a = -i - 1;
+        for (int j = 0; j < 3; ++j)
+            msg.inner[i].b[j] = i + j / 4.0f;
+    }
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j)
+            msg.m[i][j] = i * 1e100 - j;
+    msg.ok = true;
+    for (int i = 0; i < 8; ++i)
+        msg.raw[i] = 0xf0 + i;
+    return msg;
+}
+
+// Encodes 'msg' one field at a time with the coretypes helpers, the way the
+// generated code does for types that aren't fixed size
+static vector<char> encodeByField(const fixed_size1& msg)
+{
+    vector<char> buf(1024);
+    char *p = buf.data();
+    int pos = 0, max = buf.size();
+    int64_t hash = fixed_size1::getHash();
+    pos += __int64_t_encode_array(p, pos, max - pos, &hash, 1);
+    pos += __int64_t_encode_array(p, pos, max - pos, &msg.utime, 1);
+    for (int i = 0; i < 4; ++i) {
+        pos += __int16_t_encode_array(p, pos, max - pos, &msg.inner[i].a, 1);
+        pos += __float_encode_array(p, pos, max - pos, msg.inner[i].b, 3);
+    }
+    pos += __double_encode_array(p, pos, max - pos, &msg.m[0][0], 4);
+    pos += __boolean_encode_array(p, pos, max - pos, &msg.ok, 1);
+    pos += __byte_encode_array(p, pos, max - pos, msg.raw, 8);
+    buf.resize(pos);
+    return buf;
+}
+
+int main()
+{
+    fixed_size1 msg = makeMsg();
+    vector<char> expected = encodeByField(msg);
+
+    ENSURE(fixed_inner::_fixedEncodedSizeNoHash == 14);
+    ENSURE(fixed_size1::_fixedEncodedSizeNoHash == (int)expected.size() - 8);
+    ENSURE(msg.getEncodedSize() == (int)expected.size());
+
+    // The fused encoder writes the same bytes
+    vector<char> buf(expected.size());
+    ENSURE(msg.encode(buf.data(), 0, buf.size()) == (int)buf.size());
+    ENSURE(buf == expected);
+
+    // ... at any offset
+    vector<char> shifted(buf.size() + 3);
+    ENSURE(msg.encode(shifted.data(), 3, buf.size()) == (int)buf.size());
+    ENSURE(memcmp(shifted.data() + 3, expected.data(), buf.size()) == 0);
+
+    // and refuses buffers that are too small, without writing past them
+    for (size_t len = 0; len < buf.size(); ++len) {
+        vector<char> small(len + 1, 0x5a);
+        ENSURE(msg.encode(small.data(), 0, len) < 0);
+        ENSURE(small[len] == 0x5a);
+    }
+
+    fixed_size1 out;
+    ENSURE(out.decode(buf.data(), 0, buf.size()) == (int)buf.size());
+    vector<char> again(buf.size());
+    ENSURE(out.encode(again.data(), 0, again.size()) == (int)again.size());
+    ENSURE(again == expected);
+
+    return 0;
+}
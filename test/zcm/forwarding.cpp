@@ -0,0 +1,365 @@
+// Tests zcm_forward() between blocking instances: the received buffer is handed
+// over to the destination without a copy only from the last callback, the other
+// callbacks still see the message, a full destination queue leaves the message
+// untouched, and forwarding in steady state doesn't grow the buffer pools
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "zcm/zcm.h"
+#include "zcm/transport.h"
+
+using namespace std;
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+#define NUM_MSGS 2000
+#define MAX_SIZE 4096
+#define TIMEOUT_MS 2000
+
+// A blocking transport that delivers everything sent on it back to itself.
+// Sends can be held up to fill the send queue of the zcm instance using it
+struct Loopback : public zcm_trans_t
+{
+    zcm_trans_methods_t methods;
+
+    mutex lk;
+    condition_variable cv;
+    deque<pair<string, vector<char>>> queue;
+    pair<string, vector<char>> current; // handed out by the last recvmsg()
+    bool gateOpen = true;
+    // The payload buffer each channel was last sent from
+    map<string, const char*> sentFrom;
+
+    Loopback()
+    {
+        memset(&methods, 0, sizeof(methods));
+        methods.get_mtu = getMtu;
+        methods.sendmsg = sendmsg;
+        methods.recvmsg_enable = recvmsgEnable;
+        methods.recvmsg = recvmsg;
+        methods.destroy = destroy;
+        trans_type = ZCM_BLOCKING;
+        vtbl = &methods;
+    }
+
+    void setGate(bool open)
+    {
+        unique_lock<mutex> g(lk);
+        gateOpen = open;
+        cv.notify_all();
+    }
+
+    const char* lastSentFrom(const string& channel)
+    {
+        unique_lock<mutex> g(lk);
+        return sentFrom[channel];
+    }
+
+    static Loopback* cast(zcm_trans_t* zt) { return (Loopback*)zt; }
+
+    static size_t getMtu(zcm_trans_t* zt) { return MAX_SIZE; }
+
+    static int sendmsg(zcm_trans_t* zt, zcm_msg_t msg)
+    {
+        Loopback* t = cast(zt);
+        unique_lock<mutex> g(t->lk);
+        t->cv.wait(g, [&]() { return t->gateOpen; });
+        t->sentFrom[msg.channel] = msg.buf;
+        t->queue.emplace_back(msg.channel, vector<char>(msg.buf, msg.buf + msg.len));
+        t->cv.notify_all();
+        return ZCM_EOK;
+    }
+
+    static int recvmsgEnable(zcm_trans_t* zt, const char* channel, bool enable)
+    { return ZCM_EOK; }
+
+    static int recvmsg(zcm_trans_t* zt, zcm_msg_t* msg, int timeout)
+    {
+        Loopback* t = cast(zt);
+        unique_lock<mutex> g(t->lk);
+        if (!t->cv.wait_for(g, chrono::milliseconds(timeout),
+                            [&]() { return !t->queue.empty(); }))
+            return ZCM_EAGAIN;
+        t->current = std::move(t->queue.front());
+        t->queue.pop_front();
+        memset(msg, 0, sizeof(*msg));
+        msg->channel = t->current.first.c_str();
+        msg->buf = t->current.second.data();
+        msg->len = t->current.second.size();
+        return ZCM_EOK;
+    }
+
+    static void destroy(zcm_trans_t* zt) {}
+};
+
+// Counts the messages received per channel and keeps the last payload of each
+struct Collector
+{
+    struct Channel
+    {
+        size_t count = 0;
+        vector<char> last;
+    };
+
+    mutex lk;
+    condition_variable cv;
+    map<string, Channel> channels;
+
+    static void handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+    {
+        Collector* c = (Collector*)usr;
+        unique_lock<mutex> g(c->lk);
+        Channel& ch = c->channels[channel];
+        ch.count++;
+        ch.last.assign(rbuf->data, rbuf->data + rbuf->data_size);
+        c->cv.notify_all();
+    }
+
+    // Waits for the n'th message on 'channel' and returns its payload
+    vector<char> waitFor(const string& channel, size_t n)
+    {
+        unique_lock<mutex> g(lk);
+        ENSURE(cv.wait_for(g, chrono::milliseconds(TIMEOUT_MS),
+                           [&]() { return channels[channel].count >= n; }));
+        ENSURE(channels[channel].count == n);
+        return channels[channel].last;
+    }
+};
+
+static vector<char> makePayload(int i, size_t size)
+{
+    vector<char> data(size);
+    for (size_t j = 0; j < data.size(); ++j) data[j] = (char)(i + j * 13);
+    return data;
+}
+
+static size_t heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+// State shared with the callbacks of the source instance
+struct Source
+{
+    zcm_t* src;
+    zcm_t* dst;
+    vector<char> expected;
+    int firstRet = 0;
+    bool middleSawData = false;
+    int lastRet = 0;
+    int lastErr = 0;
+    const char* lastData = nullptr;
+    bool intactAfterFailure = false;
+    // Bumped once forwardLast() is done, publishing the results above
+    atomic<size_t> lastCalls {0};
+
+    void waitLastCalls(size_t n)
+    {
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(TIMEOUT_MS);
+        while (lastCalls < n) {
+            ENSURE(chrono::steady_clock::now() < deadline);
+            this_thread::yield();
+        }
+        ENSURE(lastCalls == n);
+    }
+};
+
+// Not the last callback: forwards a copy
+static void forwardFirst(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    Source* s = (Source*)usr;
+    s->firstRet = zcm_forward(s->dst, "FWD_FIRST", rbuf);
+}
+
+// Runs between the two forwards, so the message must still be there
+static void checkMiddle(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    Source* s = (Source*)usr;
+    s->middleSawData = rbuf->data_size == s->expected.size() &&
+                       memcmp(rbuf->data, s->expected.data(), rbuf->data_size) == 0;
+}
+
+// The last callback: the received buffer itself is handed to the destination.
+// rbuf->data must not be touched after a successful forward
+static void forwardLast(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    Source* s = (Source*)usr;
+    s->lastData = rbuf->data;
+    s->lastRet = zcm_forward(s->dst, "FWD_LAST", rbuf);
+    s->lastErr = zcm_errno(s->dst);
+    if (s->lastRet != 0)
+        s->intactAfterFailure = rbuf->data_size == s->expected.size() &&
+                                memcmp(rbuf->data, s->expected.data(), rbuf->data_size) == 0;
+    s->lastCalls++;
+}
+
+static void testForwardFromEachCallback()
+{
+    Loopback srcTrans, dstTrans;
+    zcm_t* src = zcm_create_trans(&srcTrans);
+    zcm_t* dst = zcm_create_trans(&dstTrans);
+    ENSURE(src && dst);
+
+    Source s;
+    s.src = src;
+    s.dst = dst;
+    ENSURE(zcm_subscribe(src, "SRC", forwardFirst, &s));
+    ENSURE(zcm_subscribe(src, "SRC", checkMiddle, &s));
+    ENSURE(zcm_subscribe(src, "SRC", forwardLast, &s));
+
+    Collector out;
+    ENSURE(zcm_subscribe(dst, "FWD_.*", Collector::handler, &out));
+
+    zcm_start(src);
+    zcm_start(dst);
+
+    size_t n = 0;
+    auto forwardOne = [&](size_t size) {
+        s.expected = makePayload(n, size);
+        ENSURE(zcm_publish(src, "SRC", s.expected.data(), s.expected.size()) == 0);
+        ++n;
+
+        s.waitLastCalls(n);
+        ENSURE(out.waitFor("FWD_FIRST", n) == s.expected);
+        ENSURE(out.waitFor("FWD_LAST", n) == s.expected);
+        ENSURE(s.firstRet == 0);
+        ENSURE(s.middleSawData);
+        ENSURE(s.lastRet == 0);
+
+        // Only the last forward is sent straight out of the receive buffer
+        ENSURE(dstTrans.lastSentFrom("FWD_LAST") == s.lastData);
+        ENSURE(dstTrans.lastSentFrom("FWD_FIRST") != s.lastData);
+    };
+
+    for (int i = 0; i < NUM_MSGS; ++i)
+        forwardOne(1 + (i * 37) % MAX_SIZE);
+
+    // In steady state, the buffers handed over are replaced from the destination's
+    // pool rather than by new allocations, so the same few buffers keep coming around
+    for (int i = 0; i < NUM_MSGS / 10; ++i)
+        forwardOne(MAX_SIZE);
+    set<const char*> recvBufs;
+    size_t heapBefore = heapInUse();
+    for (int i = 0; i < NUM_MSGS; ++i) {
+        forwardOne(MAX_SIZE);
+        recvBufs.insert(s.lastData);
+    }
+    ENSURE(recvBufs.size() <= 4);
+    // Leaves room for allocator and bookkeeping noise, far below the cost of even
+    // one leaked buffer every few forwards
+    ENSURE(heapInUse() <= heapBefore + 16 * MAX_SIZE);
+
+    zcm_stop(src);
+    zcm_stop(dst);
+    zcm_destroy(src);
+    zcm_destroy(dst);
+}
+
+static void testForwardToSelf()
+{
+    Loopback trans;
+    zcm_t* zcm = zcm_create_trans(&trans);
+    ENSURE(zcm);
+
+    Source s;
+    s.src = zcm;
+    s.dst = zcm;
+    ENSURE(zcm_subscribe(zcm, "SRC", checkMiddle, &s));
+    ENSURE(zcm_subscribe(zcm, "SRC", forwardLast, &s));
+
+    Collector out;
+    ENSURE(zcm_subscribe(zcm, "FWD_LAST", Collector::handler, &out));
+
+    zcm_start(zcm);
+    for (int i = 0; i < NUM_MSGS / 10; ++i) {
+        s.expected = makePayload(i, MAX_SIZE / 2);
+        ENSURE(zcm_publish(zcm, "SRC", s.expected.data(), s.expected.size()) == 0);
+        s.waitLastCalls(i + 1);
+        ENSURE(out.waitFor("FWD_LAST", i + 1) == s.expected);
+        ENSURE(s.middleSawData);
+        ENSURE(s.lastRet == 0);
+        ENSURE(trans.lastSentFrom("FWD_LAST") == s.lastData);
+    }
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+}
+
+static void testDestinationQueueFull()
+{
+    Loopback srcTrans, dstTrans;
+    zcm_t* src = zcm_create_trans(&srcTrans);
+    zcm_t* dst = zcm_create_trans(&dstTrans);
+    ENSURE(src && dst);
+
+    Source s;
+    s.src = src;
+    s.dst = dst;
+    ENSURE(zcm_subscribe(src, "SRC", forwardLast, &s));
+
+    Collector out;
+    ENSURE(zcm_subscribe(dst, ".*", Collector::handler, &out));
+
+    zcm_start(src);
+    zcm_start(dst);
+
+    // Hold up the destination's send thread and fill its queue
+    dstTrans.setGate(false);
+    char fill = 0;
+    size_t filled = 0;
+    while (zcm_publish(dst, "FILL", &fill, 1) == 0) ++filled;
+    ENSURE(zcm_errno(dst) == ZCM_EAGAIN);
+    ENSURE(filled > 0);
+
+    // The forward fails without taking the message away from the source
+    s.expected = makePayload(1, MAX_SIZE);
+    ENSURE(zcm_publish(src, "SRC", s.expected.data(), s.expected.size()) == 0);
+    s.waitLastCalls(1);
+    ENSURE(s.lastRet != 0);
+    ENSURE(s.lastErr == ZCM_EAGAIN);
+    ENSURE(s.intactAfterFailure);
+
+    // Once the queue drains, forwarding works again
+    dstTrans.setGate(true);
+    out.waitFor("FILL", filled);
+    s.expected = makePayload(2, MAX_SIZE);
+    ENSURE(zcm_publish(src, "SRC", s.expected.data(), s.expected.size()) == 0);
+    s.waitLastCalls(2);
+    ENSURE(out.waitFor("FWD_LAST", 1) == s.expected);
+    ENSURE(s.lastRet == 0);
+
+    zcm_stop(src);
+    zcm_stop(dst);
+    zcm_destroy(src);
+    zcm_destroy(dst);
+}
+
+int main()
+{
+    testForwardFromEachCallback();
+    testForwardToSelf();
+    testDestinationQueueFull();
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The checked in answers of test/gen/pod1.zcm, which scripts/test-gen.sh keeps
+   in sync with zcm-gen */
+#include "pod1.h"
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+#define NUM 3
+
+static void makeMsg(pod1 *msg, int seed)
+{
+    int i, j;
+    memset(msg, 0, sizeof(*msg));
+    msg->flag = -seed;
+    msg->utime = 0x0102030405060708LL + seed;
+    for (i = 0; i < 3; ++i)
+        msg->counts[i] = -1000 * i - seed;
+    for (i = 0; i < 2; ++i)
+        for (j = 0; j < 3; ++j)
+            msg->grid[i][j] = i - j / 8.0f + seed;
+    msg->scale = 1e-300 * seed;
+    msg->valid = seed & 1;
+    for (i = 0; i < 5; ++i)
+        msg->raw[i] = 0xf0 + i + seed;
+    msg->id = 0x7f000000 + seed;
+}
+
+/* Encodes 'msg' (without a hash) one field at a time with the coretypes helpers,
+   the way the generated code does for types that aren't plain data */
+static int encodeByField(char *buf, int max, const pod1 *msg)
+{
+    int pos = 0;
+    pos += __int8_t_encode_array(buf, pos, max - pos, &msg->flag, 1);
+    pos += __int64_t_encode_array(buf, pos, max - pos, &msg->utime, 1);
+    pos += __int16_t_encode_array(buf, pos, max - pos, msg->counts, 3);
+    pos += __float_encode_array(buf, pos, max - pos, &msg->grid[0][0], 6);
+    pos += __double_encode_array(buf, pos, max - pos, &msg->scale, 1);
+    pos += __boolean_encode_array(buf, pos, max - pos, &msg->valid, 1);
+    pos += __byte_encode_array(buf, pos, max - pos, msg->raw, 5);
+    pos += __int32_t_encode_array(buf, pos, max - pos, &msg->id, 1);
+    return pos;
+}
+
+int main(void)
+{
+    enum { SIZE = POD1_ENCODED_SIZE - 8 };
+    pod1 msgs[NUM], out[NUM];
+    char expected[NUM * SIZE], buf[NUM * SIZE + 1], enc[POD1_ENCODED_SIZE];
+    int i, len;
+
+    for (i = 0; i < NUM; ++i) {
+        makeMsg(&msgs[i], i + 1);
+        ENSURE(encodeByField(expected + i * SIZE, SIZE, &msgs[i]) == SIZE);
+    }
+
+    ENSURE(pod1_encoded_size(&msgs[0]) == POD1_ENCODED_SIZE);
+    ENSURE(__pod1_encoded_array_size(msgs, NUM) == NUM * SIZE);
+
+    /* The bulk encoder writes the same bytes as field by field encoding */
+    ENSURE(__pod1_encode_array(buf, 0, sizeof(buf), msgs, NUM) == NUM * SIZE);
+    ENSURE(memcmp(buf, expected, NUM * SIZE) == 0);
+
+    /* and refuses buffers that are too small, without writing past them */
+    for (len = 0; len < NUM * SIZE; ++len) {
+        memset(buf, 0x5a, sizeof(buf));
+        ENSURE(__pod1_encode_array(buf, 0, len, msgs, NUM) < 0);
+        ENSURE(buf[len] == 0x5a);
+    }
+
+    ENSURE(__pod1_decode_array(expected, 0, NUM * SIZE, out, NUM) == NUM * SIZE);
+    for (i = 0; i < NUM; ++i) {
+        ENSURE(out[i].flag == msgs[i].flag);
+        ENSURE(out[i].utime == msgs[i].utime);
+        ENSURE(memcmp(out[i].counts, msgs[i].counts, sizeof(out[i].counts)) == 0);
+        ENSURE(memcmp(out[i].grid, msgs[i].grid, sizeof(out[i].grid)) == 0);
+        ENSURE(out[i].scale == msgs[i].scale);
+        ENSURE(out[i].valid == msgs[i].valid);
+        ENSURE(memcmp(out[i].raw, msgs[i].raw, sizeof(out[i].raw)) == 0);
+        ENSURE(out[i].id == msgs[i].id);
+    }
+
+    /* Every truncated message is rejected */
+    ENSURE(pod1_encode(enc, 0, sizeof(enc), &msgs[0]) == POD1_ENCODED_SIZE);
+    for (len = 0; len < POD1_ENCODED_SIZE; ++len)
+        ENSURE(pod1_decode(enc, 0, len, &out[0]) < 0);
+    ENSURE(pod1_decode(enc, 0, sizeof(enc), &out[0]) == POD1_ENCODED_SIZE);
+    ENSURE(out[0].id == msgs[0].id);
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Tests the message pool behind the shared_ptr subscriptions: a message is only
+// reused once every outside reference to it is gone, including references that
+// are dropped on another thread
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <zcm/zcm-cpp.hpp>
+
+#include "types/example_t.hpp"
+
+using namespace std;
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+#define POOL_SIZE 4
+#define NUM_MSGS 20000
+
+// Every field of a message is derived from its utime, so a message that was
+// decoded into while someone still held it shows up as inconsistent
+static example_t makeMsg(int64_t seq)
+{
+    example_t msg;
+    msg.utime = seq;
+    for (int i = 0; i < 3; ++i) msg.position[i] = seq + i;
+    for (int i = 0; i < 4; ++i) msg.orientation[i] = -seq - i;
+    msg.num_ranges = 1 + seq % 50;
+    msg.ranges.resize(msg.num_ranges);
+    for (int i = 0; i < msg.num_ranges; ++i) msg.ranges[i] = (int16_t) (seq + i);
+    msg.name = to_string(seq);
+    msg.enabled = seq & 1;
+    return msg;
+}
+
+static bool consistent(const example_t& msg, int64_t seq)
+{
+    if (msg.utime != seq) return false;
+    for (int i = 0; i < 3; ++i) if (msg.position[i] != seq + i) return false;
+    for (int i = 0; i < 4; ++i) if (msg.orientation[i] != -seq - i) return false;
+    if (msg.num_ranges != 1 + seq % 50 || (int)msg.ranges.size() != msg.num_ranges) return false;
+    for (int i = 0; i < msg.num_ranges; ++i)
+        if (msg.ranges[i] != (int16_t) (seq + i)) return false;
+    return msg.name == to_string(seq) && msg.enabled == (seq & 1);
+}
+
+static shared_ptr<const example_t> last;
+
+static void keepLast(const zcm::ReceiveBuffer* rbuf, const string& channel,
+                     shared_ptr<const example_t> msg, void* usr)
+{
+    last = std::move(msg);
+}
+
+// Sends one message through the (synchronous) nonblock-inproc transport and returns what
+// the subscription handed out for it
+static shared_ptr<const example_t> roundTrip(zcm::ZCM& zcm, int64_t seq)
+{
+    example_t msg = makeMsg(seq);
+    last.reset();
+    ENSURE(zcm.publish("SHARED", &msg) == ZCM_EOK);
+    zcm.flush();
+    ENSURE(last);
+    ENSURE(consistent(*last, seq));
+    return std::move(last);
+}
+
+static void testHeldMessagesAreNotReused()
+{
+    zcm::ZCM zcm("nonblock-inproc");
+    ENSURE(zcm.good());
+    zcm::Subscription* sub = zcm.subscribe<example_t>("SHARED", keepLast, nullptr, POOL_SIZE);
+
+    // Hold more messages than the pool has room for: none of them may be decoded
+    // into while they're held, so they must all be distinct
+    deque<shared_ptr<const example_t>> held;
+    set<const example_t*> seen;
+    for (int i = 0; i < 2 * POOL_SIZE; ++i) {
+        held.push_back(roundTrip(zcm, i));
+        ENSURE(seen.insert(held.back().get()).second);
+    }
+    for (int i = 0; i < 2 * POOL_SIZE; ++i)
+        ENSURE(consistent(*held[i], i));
+
+    // Once released, the pooled messages are handed out again
+    const example_t* first = held.front().get();
+    held.clear();
+    set<const example_t*> reused;
+    for (int i = 0; i < POOL_SIZE; ++i)
+        reused.insert(roundTrip(zcm, 100 + i).get());
+    ENSURE(reused.size() <= POOL_SIZE);
+    ENSURE(reused.count(first) == 1);
+
+    // Holding one message keeps it out of circulation while the rest are recycled
+    shared_ptr<const example_t> keep = roundTrip(zcm, 200);
+    for (int i = 0; i < 4 * POOL_SIZE; ++i) {
+        shared_ptr<const example_t> msg = roundTrip(zcm, 300 + i);
+        ENSURE(msg.get() != keep.get());
+    }
+    ENSURE(consistent(*keep, 200));
+
+    zcm.unsubscribe(sub);
+}
+
+// A consumer thread holds messages for a while and drops them in its own time,
+// racing the dispatch thread that recycles them
+static void testCrossThreadRelease()
+{
+    zcm::ZCM zcm("nonblock-inproc");
+    ENSURE(zcm.good());
+
+    mutex lk;
+    condition_variable cv;
+    deque<shared_ptr<const example_t>> queue;
+    bool done = false;
+    atomic<int> checked {0};
+
+    struct Ctx { mutex* lk; condition_variable* cv; deque<shared_ptr<const example_t>>* queue; };
+    Ctx ctx { &lk, &cv, &queue };
+    auto cb = [](const zcm::ReceiveBuffer* rbuf, const string& channel,
+                 shared_ptr<const example_t> msg, void* usr) {
+        Ctx* ctx = (Ctx*) usr;
+        unique_lock<mutex> g(*ctx->lk);
+        ctx->queue->push_back(std::move(msg));
+        ctx->cv->notify_one();
+    };
+    zcm::Subscription* sub = zcm.subscribe<example_t>("SHARED", cb, &ctx, POOL_SIZE);
+
+    thread consumer([&]() {
+        int64_t expected = 0;
+        while (true) {
+            shared_ptr<const example_t> msg;
+            {
+                unique_lock<mutex> g(lk);
+                cv.wait(g, [&]() { return done || !queue.empty(); });
+                if (queue.empty()) return;
+                msg = std::move(queue.front());
+                queue.pop_front();
+            }
+            // Read the message outside the lock, while the dispatcher keeps decoding
+            ENSURE(consistent(*msg, expected));
+            ++expected;
+            ++checked;
+        }
+    });
+
+    for (int64_t i = 0; i < NUM_MSGS; ++i) {
+        example_t msg = makeMsg(i);
+        ENSURE(zcm.publish("SHARED", &msg) == ZCM_EOK);
+        zcm.flush();
+    }
+
+    {
+        unique_lock<mutex> g(lk);
+        done = true;
+        cv.notify_one();
+    }
+    consumer.join();
+    ENSURE(checked == NUM_MSGS);
+
+    zcm.unsubscribe(sub);
+}
+
+int main()
+{
+    testHeldMessagesAreNotReused();
+    testCrossThreadRelease();
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zcm/stats.h"
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+static void add(zcm_stats_hist_t *h, uint64_t ns, uint64_t times)
+{
+    h->count += times;
+    h->sum_ns += ns * times;
+    h->buckets[zcm_stats_bucket(ns)] += times;
+}
+
+static void test_buckets(void)
+{
+    static const uint64_t first[] = { 0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32 };
+    int b;
+    uint64_t ns;
+
+    for (b = 0; b < (int)(sizeof(first) / sizeof(first[0])); ++b)
+        ENSURE(zcm_stats_bucket_min(b) == first[b]);
+
+    /* Every bucket starts where the last one ended, and holds its own minimum */
+    for (b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b) {
+        ENSURE(zcm_stats_bucket(zcm_stats_bucket_min(b)) == b);
+        if (b + 1 < ZCM_STATS_HIST_BUCKETS) {
+            ENSURE(zcm_stats_bucket_min(b + 1) > zcm_stats_bucket_min(b));
+            ENSURE(zcm_stats_bucket(zcm_stats_bucket_min(b + 1) - 1) == b);
+        }
+        /* so a value is known to within a factor of 1.5 */
+        if (b >= 2 && b + 1 < ZCM_STATS_HIST_BUCKETS)
+            ENSURE(2 * zcm_stats_bucket_min(b + 1) <= 3 * zcm_stats_bucket_min(b));
+    }
+
+    /* Values are never sorted into a bucket past their own */
+    for (ns = 0; ns < 100000; ++ns) {
+        b = zcm_stats_bucket(ns);
+        ENSURE(zcm_stats_bucket_min(b) <= ns);
+    }
+
+    /* The last bucket holds everything from ~3.2s up */
+    b = ZCM_STATS_HIST_BUCKETS - 1;
+    ENSURE(zcm_stats_bucket_min(b) > 3000000000ULL);
+    ENSURE(zcm_stats_bucket_min(b) < 3500000000ULL);
+    ENSURE(zcm_stats_bucket(10000000000ULL) == b);
+    ENSURE(zcm_stats_bucket(UINT64_MAX) == b);
+}
+
+static void test_percentiles(void)
+{
+    zcm_stats_hist_t h;
+    uint64_t fast, slow;
+
+    memset(&h, 0, sizeof(h));
+    ENSURE(zcm_stats_percentile(&h, 0.5) == 0);
+
+    add(&h, 1000, 1);
+    ENSURE(zcm_stats_percentile(&h, 0) == zcm_stats_bucket_min(zcm_stats_bucket(1000)));
+    ENSURE(zcm_stats_percentile(&h, 1) == zcm_stats_bucket_min(zcm_stats_bucket(1000)));
+
+    memset(&h, 0, sizeof(h));
+    add(&h, 100, 90);
+    add(&h, 10000, 10);
+    fast = zcm_stats_bucket_min(zcm_stats_bucket(100));
+    slow = zcm_stats_bucket_min(zcm_stats_bucket(10000));
+    ENSURE(zcm_stats_percentile(&h, 0) == fast);
+    ENSURE(zcm_stats_percentile(&h, 0.5) == fast);
+    ENSURE(zcm_stats_percentile(&h, 0.9) == fast);
+    ENSURE(zcm_stats_percentile(&h, 0.91) == slow);
+    ENSURE(zcm_stats_percentile(&h, 0.99) == slow);
+    ENSURE(zcm_stats_percentile(&h, 1) == slow);
+
+    /* Out of range percentiles are clamped */
+    ENSURE(zcm_stats_percentile(&h, -1) == fast);
+    ENSURE(zcm_stats_percentile(&h, 2) == slow);
+}
+
+static void test_encode_decode(void)
+{
+    zcm_channel_stats_t in[2], out[2];
+    char buf[4096];
+    int len, i, h;
+
+    memset(in, 0, sizeof(in));
+    strcpy(in[0].channel, "FIRST");
+    strcpy(in[1].channel, "SECOND");
+    for (i = 0; i < 2; ++i) {
+        in[i].pub_msgs = 10 + i;
+        in[i].pub_bytes = 1000 + i;
+        in[i].recv_msgs = 20 + i;
+        in[i].recv_bytes = 2000 + i;
+        for (h = 0; h < ZCM_STATS_NUM_HISTS; ++h) {
+            add(&in[i].hists[h], 50 * (h + 1), 3);
+            add(&in[i].hists[h], UINT64_MAX / 4, 1 + i);
+        }
+    }
+
+    len = zcm_stats_encode(in, 2, buf, sizeof(buf));
+    ENSURE(len > 0);
+    ENSURE(zcm_stats_decode(buf, len, out, 2) == 2);
+    for (i = 0; i < 2; ++i) {
+        ENSURE(strcmp(out[i].channel, in[i].channel) == 0);
+        ENSURE(out[i].pub_msgs == in[i].pub_msgs);
+        ENSURE(out[i].pub_bytes == in[i].pub_bytes);
+        ENSURE(out[i].recv_msgs == in[i].recv_msgs);
+        ENSURE(out[i].recv_bytes == in[i].recv_bytes);
+        ENSURE(memcmp(out[i].hists, in[i].hists, sizeof(in[i].hists)) == 0);
+    }
+
+    /* Truncated messages are rejected */
+    for (i = 0; i < len; ++i)
+        ENSURE(zcm_stats_decode(buf, i, out, 2) < 0);
+}
+
+int main(void)
+{
+    test_buckets();
+    test_percentiles();
+    test_encode_decode();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The checked in answers of test/gen/view1.zcm, which scripts/test-gen.sh keeps
+// in sync with zcm-gen --cpp-view
+#include "view1.hpp"
+
+using namespace std;
+
+#define ENSURE(v) do {\
+  if (!(v)) { \
+      fprintf(stderr, "ENSURE: failed for '%s' at %s:%d\n", #v, __FILE__, __LINE__); \
+    exit(1);                                          \
+  }\
+} while(0)
+
+#define N 5
+
+static view1 makeMsg()
+{
+    view1 msg;
+    msg.utime = 0x0102030405060708LL;
+    msg.n = N;
+    for (int i = 0; i < N; ++i) {
+        msg.samples.push_back(i * 1.5f);
+        msg.labels.push_back(string(i + 1, 'a' + i));
+        view_point p;
+        p.x = i;
+        p.y = -i;
+        msg.points.push_back(p);
+    }
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 3; ++j)
+            msg.pose[i][j] = i * 10 + j;
+    msg.name = "view";
+    for (int i = 0; i < 2; ++i) {
+        msg.tags[i].name = i == 0 ? "first" : "second, longer";
+        msg.tags[i].n = i + 2;
+        for (int j = 0; j < msg.tags[i].n; ++j)
+            msg.tags[i].v.push_back(i * 100 + j);
+    }
+    return msg;
+}
+
+static void checkTag(const view_tagView& v, const view_tag& t)
+{
+    ENSURE(strcmp(v.name(), t.name.c_str()) == 0);
+    ENSURE(v.n() == t.n);
+    ENSURE(v.v().size() == t.n);
+    for (int j = 0; j < t.n; ++j)
+        ENSURE(v.v()[j] == t.v[j]);
+}
+
+static void testView(const view1& msg, const vector<char>& buf)
+{
+    view1View view;
+    ENSURE(view.decode(buf.data(), 0, buf.size()) == (int)buf.size());
+    ENSURE(view.good());
+
+    ENSURE(view.utime() == msg.utime);
+    ENSURE(view.n() == N);
+    ENSURE(view.samples().size() == N);
+    for (int i = 0; i < N; ++i)
+        ENSURE(view.samples()[i] == msg.samples[i]);
+    ENSURE(view.pose().size() == 6);
+    for (int i = 0; i < 6; ++i)
+        ENSURE(view.pose()[i] == msg.pose[i / 3][i % 3]);
+    ENSURE(strcmp(view.name(), "view") == 0);
+
+    // In order, then out of order, so the cached element positions are reused
+    // and discarded
+    int order[] = { 0, 1, 2, 3, 4, 3, 0, 4, 2, 2, 1 };
+    for (int i : order) {
+        ENSURE(strcmp(view.labels(i), msg.labels[i].c_str()) == 0);
+        view_pointView p = view.points(i);
+        ENSURE(p.x() == msg.points[i].x);
+        ENSURE(p.y() == msg.points[i].y);
+    }
+    for (int i : { 1, 0, 1 })
+        checkTag(view.tags(i), msg.tags[i]);
+
+    view1 copy;
+    ENSURE(view.copyTo(copy) == (int)buf.size() - 8);
+    ENSURE(copy.utime == msg.utime);
+    ENSURE(copy.labels == msg.labels);
+    ENSURE(copy.tags[1].v == msg.tags[1].v);
+}
+
+static void testTruncated(const vector<char>& buf)
+{
+    // Every prefix of the message must be rejected by both decoders
+    for (size_t len = 0; len < buf.size(); ++len) {
+        vector<char> cut(buf.begin(), buf.begin() + len);
+        view1View view;
+        ENSURE(view.decode(cut.data(), 0, len) < 0);
+        ENSURE(!view.good());
+        view1 msg;
+        ENSURE(msg.decode(cut.data(), 0, len) < 0);
+    }
+
+    // As must a message of another type
+    vector<char> other = buf;
+    other[0] ^= 1;
+    view1View view;
+    ENSURE(view.decode(other.data(), 0, other.size()) < 0);
+}
+
+int main()
+{
+    view1 msg = makeMsg();
+    vector<char> buf(msg.getEncodedSize());
+    ENSURE(msg.encode(buf.data(), 0, buf.size()) == (int)buf.size());
+
+    testView(msg, buf);
+    testTruncated(buf);
+
+    return 0;
+}
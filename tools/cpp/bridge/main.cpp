@@ -1,7 +1,11 @@
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <unistd.h>
 #include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
 #include <atomic>
 #include <signal.h>
 
@@ -11,6 +15,8 @@
 #include "zcm/zcm_coretypes.h"
 
 #include "util/TranscoderPluginDb.hpp"
+#include "util/TimeUtil.hpp"
+#include "util/TokenBucket.hpp"
 
 using namespace std;
 
@@ -30,6 +36,17 @@ struct Args
     vector<int> Adec;
     vector<int> Bdec;
 
+    // Per channel limits, 0 means unlimited
+    vector<double> Arate;
+    vector<double> Brate;
+
+    vector<bool> Aconflate;
+    vector<bool> Bconflate;
+
+    // Bytes per second republished onto each endpoint, 0 means unlimited
+    double Abandwidth = 0;
+    double Bbandwidth = 0;
+
     string Aurl = "";
     string Burl = "";
 
@@ -43,7 +60,7 @@ struct Args
     bool parse(int argc, char *argv[])
     {
         // set some defaults
-        const char *optstring = "hA:B:a:b:D:p:d";
+        const char *optstring = "hA:B:a:b:D:r:cp:d";
         struct option long_opts[] = {
             { "help",              no_argument, 0,  'h' },
             { "A-prefix",    required_argument, 0,   0  },
@@ -53,13 +70,20 @@ struct Args
             { "A-channel",   required_argument, 0,  'a' },
             { "B-channel",   required_argument, 0,  'b' },
             { "decimation",  required_argument, 0,  'D' },
+            { "rate",        required_argument, 0,  'r' },
+            { "conflate",          no_argument, 0,  'c' },
+            { "A-bandwidth", required_argument, 0,   0  },
+            { "B-bandwidth", required_argument, 0,   0  },
             { "plugin-path", required_argument, 0,  'p' },
             { "debug",             no_argument, 0,  'd' },
             { 0, 0, 0, 0 }
         };
 
         int c;
+        // The channel options apply to the last -a or -b channel
         vector<int> *currDec = nullptr;
+        vector<double> *currRate = nullptr;
+        vector<bool> *currConflate = nullptr;
         int option_index;
         while ((c = getopt_long(argc, argv, optstring, long_opts, &option_index)) >= 0) {
             switch (c) {
@@ -68,18 +92,35 @@ struct Args
                 case 'a':
                     Achannels.push_back(optarg);
                     Adec.push_back(0);
+                    Arate.push_back(0);
+                    Aconflate.push_back(false);
                     currDec = &Adec;
+                    currRate = &Arate;
+                    currConflate = &Aconflate;
                     break;
                 case 'b':
                     Bchannels.push_back(optarg);
                     Bdec.push_back(0);
+                    Brate.push_back(0);
+                    Bconflate.push_back(false);
                     currDec = &Bdec;
+                    currRate = &Brate;
+                    currConflate = &Bconflate;
                     break;
                 case 'D':
                     ZCM_ASSERT(currDec != nullptr &&
-                               "Decimation must immediately follow a channel");
+                               "Decimation must follow a channel");
                     currDec->back() = atoi(optarg);
-                    currDec = nullptr;
+                    break;
+                case 'r':
+                    ZCM_ASSERT(currDec != nullptr &&
+                               "Rate must follow a channel");
+                    currRate->back() = atof(optarg);
+                    break;
+                case 'c':
+                    ZCM_ASSERT(currDec != nullptr &&
+                               "Conflate must follow a channel");
+                    currConflate->back() = true;
                     break;
                 case 'p':
                     plugin_path = string(optarg);
@@ -94,6 +135,12 @@ struct Args
                     } else if (string(long_opts[option_index].name) == "B-prefix") {
                         currDec = nullptr;
                         Bprefix = optarg;
+                    } else if (string(long_opts[option_index].name) == "A-bandwidth") {
+                        currDec = nullptr;
+                        Abandwidth = atof(optarg);
+                    } else if (string(long_opts[option_index].name) == "B-bandwidth") {
+                        currDec = nullptr;
+                        Bbandwidth = atof(optarg);
                     }
                     break;
                 case 'h': default: usage(); return false;
@@ -146,6 +193,17 @@ struct Args
              << "                             Ex: zcm-bridge -A ipc -B udpm://239.255.76.67:7667?ttl=0 -b EXAMPLE -d 2" << endl
              << "                             This example would result in the message on EXAMPLE being rebroadcast on" << endl
              << "                             the A url every third message." << endl
+             << "  -r, --rate=HZ              Maximum rate of each channel matched by the preceeding A-channel" << endl
+             << "                             or B-channel. Faster messages are dropped (see --conflate)." << endl
+             << "                             Ex: zcm-bridge -A ipc -B udpm://239.255.76.67:7667?ttl=0 -a POSE -r 5" << endl
+             << "  -c, --conflate             For the preceeding A-channel or B-channel, hold on to the newest message" << endl
+             << "                             that could not be sent because of --rate or --X-bandwidth, and send it" << endl
+             << "                             as soon as it is allowed, instead of dropping it." << endl
+             << "      --A-bandwidth=BPS      Limit the bytes per second republished onto the A url. Held (conflated)" << endl
+             << "                             messages are sent oldest first before any new traffic, so busy" << endl
+             << "                             channels cannot starve the others. Bursts of up to a second's worth" << endl
+             << "                             are allowed." << endl
+             << "      --B-bandwidth=BPS      Limit the bytes per second republished onto the B url" << endl
              << "  -p, --plugin-path=path     Path to shared library containing transcoder plugins" << endl
              << "" << endl << endl;
     }
@@ -161,19 +219,141 @@ struct Bridge
     static TranscoderPluginDb* pluginDb;
     static vector<zcm::TranscoderPlugin*> plugins;
 
+    // Held message of one outgoing channel, guarded by its Link's mutex
+    struct ChannelState
+    {
+        string       outChannel;
+        bool         valid = true; // false if the prefixed channel is too long
+        uint64_t     intervalUs = 0;
+        uint64_t     lastSendUs = 0;
+        bool         conflate = false;
+        bool         queued = false;
+        vector<char> data;
+        size_t       len = 0;
+
+        bool rateAllows(uint64_t now) const
+        { return intervalUs == 0 || lastSendUs == 0 || now - lastSendUs >= intervalUs; }
+    };
+
+    // Everything republished onto one endpoint. Written by the other endpoint's
+    // handle thread and pumped by the main thread
+    struct Link
+    {
+        zcm::ZCM   *zcmOut = nullptr;
+        TokenBucket bucket;
+
+        mutex                 mut;
+        deque<ChannelState*>  waiting; // conflated messages, oldest first
+        bool                  starved = false;
+
+        uint64_t  nDropped = 0;
+        uint64_t  nConflated = 0;
+
+        void init(zcm::ZCM *out, double bps)
+        {
+            zcmOut = out;
+            bucket.reset(bps, TimeUtil::monoUtime());
+        }
+
+        void sent(ChannelState& cs, size_t len, uint64_t now)
+        {
+            bucket.spend(len);
+            cs.lastSendUs = now;
+        }
+
+        // Sends the held messages that are allowed to go out, in the order they were
+        // held. Channels still within their rate interval go to the back of the line.
+        // Must be called with mut held
+        void pump(uint64_t now)
+        {
+            bucket.refill(now);
+            starved = false;
+            for (size_t n = waiting.size(); n > 0 && !waiting.empty(); --n) {
+                ChannelState *cs = waiting.front();
+                waiting.pop_front();
+                if (!cs->rateAllows(now)) {
+                    waiting.push_back(cs);
+                    continue;
+                }
+                if (!bucket.allows(cs->len)) {
+                    waiting.push_front(cs);
+                    starved = true;
+                    break;
+                }
+                int ret = zcmOut->publish(cs->outChannel, cs->data.data(), cs->len);
+                if (ret != ZCM_EOK) ret = zcmOut->err();
+                if (ret == ZCM_EAGAIN) {
+                    // The transport can't take it yet: keep holding the message,
+                    // without spending its budget, until the next pump
+                    waiting.push_front(cs);
+                    starved = true;
+                    break;
+                }
+                cs->queued = false;
+                if (ret != ZCM_EOK) {
+                    nDropped++;
+                    continue;
+                }
+                sent(*cs, cs->len, now);
+            }
+        }
+    };
+
     struct BridgeInfo
     {
-        zcm::ZCM *zcmOut = nullptr;
+        Link     *link = nullptr;
         string    prefix = "";
         int       decimation = 0;
         int       nSkipped = 0;
+        uint64_t  intervalUs = 0;
+        bool      conflate = false;
+
+        // The outgoing channel name: the prefix is written once, and each message's
+        // channel is written after it
+        char      channel[ZCM_CHANNEL_MAXLEN + 1];
+        size_t    prefixLen = 0;
+
+        // Only used if this subscription or its link is limited. Keyed by the
+        // incoming channel, which may differ per message with regex subscriptions
+        unordered_map<string, ChannelState> states;
+
+        BridgeInfo(Link *link, const string &prefix, int dec, double rate, bool conflate) :
+            link(link), prefix(prefix), decimation(dec), nSkipped(0),
+            intervalUs(rate > 0 ? 1e6 / rate : 0), conflate(conflate)
+        {
+            prefixLen = prefix.size();
+            if (prefixLen <= ZCM_CHANNEL_MAXLEN)
+                memcpy(channel, prefix.c_str(), prefixLen + 1);
+        }
+
+        BridgeInfo() { channel[0] = '\0'; }
 
-        BridgeInfo(zcm::ZCM* zcmOut, const string &prefix, int dec) :
-            zcmOut(zcmOut), prefix(prefix), decimation(dec), nSkipped(0) {}
+        // Returns false if the prefixed channel is too long to publish
+        bool setChannel(const string& ch)
+        {
+            if (prefixLen + ch.size() > ZCM_CHANNEL_MAXLEN) return false;
+            memcpy(channel + prefixLen, ch.c_str(), ch.size() + 1);
+            return true;
+        }
 
-        BridgeInfo() {}
+        bool limited() const { return intervalUs > 0 || link->bucket.limited(); }
+
+        ChannelState& state(const string& ch)
+        {
+            auto it = states.find(ch);
+            if (it != states.end()) return it->second;
+            ChannelState& cs = states[ch];
+            cs.outChannel = prefix + ch;
+            cs.valid = cs.outChannel.size() <= ZCM_CHANNEL_MAXLEN;
+            cs.intervalUs = intervalUs;
+            cs.conflate = conflate;
+            return cs;
+        }
     };
 
+    Link linkA; // republished onto zcmA
+    Link linkB; // republished onto zcmB
+
     Bridge() {}
 
     ~Bridge()
@@ -208,6 +388,9 @@ struct Bridge
             return false;
         }
 
+        linkA.init(zcmA, args.Abandwidth);
+        linkB.init(zcmB, args.Bbandwidth);
+
         assert(pluginDb == nullptr);
         // Load plugins from path if specified
         if (args.plugin_path != "") {
@@ -227,12 +410,74 @@ struct Bridge
         return true;
     }
 
+    // Republishes one message, subject to the rate and bandwidth limits. 'rbuf' is
+    // only given if 'data' is the received buffer, so it can be forwarded
+    static void send(BridgeInfo *info, const string& channel, const char *data,
+                     size_t len, const zcm::ReceiveBuffer *rbuf)
+    {
+        if (!info->limited()) {
+            if (!info->setChannel(channel)) return;
+            if (rbuf)
+                info->link->zcmOut->forward(info->channel, rbuf);
+            else
+                info->link->zcmOut->publish(info->channel, data, len);
+            return;
+        }
+
+        Link& link = *info->link;
+        unique_lock<mutex> lk(link.mut);
+
+        ChannelState& cs = info->state(channel);
+        if (!cs.valid) return;
+
+        uint64_t now = TimeUtil::monoUtime();
+        link.pump(now);
+
+        // Held messages go first, so a new message may only skip the line if
+        // the held ones are waiting on their own channel's rate
+        if (!cs.queued && !link.starved && cs.rateAllows(now) && link.bucket.allows(len)) {
+            int ret = rbuf ? link.zcmOut->forward(cs.outChannel, rbuf)
+                           : link.zcmOut->publish(cs.outChannel, data, len);
+            if (ret == ZCM_EOK) {
+                link.sent(cs, len, now);
+                return;
+            }
+            // A full send queue is treated like a spent budget: the message is
+            // held if the channel conflates, and 'data' is still intact to copy
+            if (link.zcmOut->err() != ZCM_EAGAIN) {
+                link.nDropped++;
+                return;
+            }
+            link.starved = true;
+        }
+
+        if (!cs.conflate) {
+            link.nDropped++;
+            return;
+        }
+
+        if (cs.queued) {
+            link.nConflated++;
+        } else {
+            cs.queued = true;
+            link.waiting.push_back(&cs);
+        }
+        cs.data.assign(data, data + len);
+        cs.len = len;
+    }
+
     static void handler(const zcm::ReceiveBuffer* rbuf, const string& channel, void* usr)
     {
         BridgeInfo* info = (BridgeInfo*)usr;
         if (info->nSkipped++ == info->decimation) {
             info->nSkipped = 0;
 
+            // Fast path: hand the received buffer straight to the other side
+            if (plugins.empty()) {
+                send(info, channel, rbuf->data, rbuf->data_size, rbuf);
+                return;
+            }
+
             vector<const zcm::LogEvent*> evts;
 
             zcm::LogEvent le;
@@ -257,11 +502,11 @@ struct Bridge
 
             for (auto* evt : evts) {
                 if (!evt) continue;
-                // Must create newChannel in here to handle regex based subscriptions.
+                // Must use each event's channel to handle regex based subscriptions.
                 // Ie you cant store the whole channel in BridgeInfo because you
                 // don't necessarily know what channel is until you receive a message
-                string newChannel = info->prefix + evt->channel;
-                info->zcmOut->publish(newChannel, evt->data, evt->datalen);
+                bool original = evt == &le && evts.size() == 1;
+                send(info, evt->channel, evt->data, evt->datalen, original ? rbuf : nullptr);
             }
         }
     }
@@ -273,14 +518,15 @@ struct Bridge
         infoA.reserve(args.Achannels.size());
         infoB.reserve(args.Bchannels.size());
 
-        BridgeInfo defaultA(zcmB, args.Bprefix, 0),
-                   defaultB(zcmA, args.Aprefix, 0);
+        BridgeInfo defaultA(&linkB, args.Bprefix, 0, 0, false),
+                   defaultB(&linkA, args.Aprefix, 0, 0, false);
 
         if (args.Achannels.size() == 0) {
             zcmA->subscribe(".*", &handler, &defaultA);
         } else {
             for (size_t i = 0; i < args.Achannels.size(); i++) {
-                infoA.emplace_back(zcmB, args.Bprefix, args.Adec.at(i));
+                infoA.emplace_back(&linkB, args.Bprefix, args.Adec.at(i),
+                                   args.Arate.at(i), args.Aconflate.at(i));
                 zcmA->subscribe(args.Achannels.at(i), &handler, &infoA.back());
             }
         }
@@ -289,7 +535,8 @@ struct Bridge
             zcmB->subscribe(".*", &handler, &defaultB);
         } else {
             for (size_t i = 0; i < args.Bchannels.size(); i++) {
-                infoB.emplace_back(zcmA, args.Aprefix, args.Bdec.at(i));
+                infoB.emplace_back(&linkA, args.Aprefix, args.Bdec.at(i),
+                                   args.Brate.at(i), args.Bconflate.at(i));
                 zcmB->subscribe(args.Bchannels.at(i), &handler, &infoB.back());
             }
         }
@@ -299,16 +546,39 @@ struct Bridge
                    infoB.size() == args.Bchannels.size() &&
                    infoB.size() == args.Bdec.size());
 
+        // Held messages only go out when their channel or link allows it, so
+        // they have to be pumped even when no new messages arrive
+        bool limited = args.Abandwidth > 0 || args.Bbandwidth > 0;
+        for (auto& info : infoA) limited |= info.limited();
+        for (auto& info : infoB) limited |= info.limited();
+
         zcmA->start();
         zcmB->start();
 
-        while (!done) usleep(1e6);
+        while (!done) {
+            if (!limited) {
+                usleep(1e6);
+                continue;
+            }
+            usleep(1000);
+            for (Link *link : { &linkA, &linkB }) {
+                unique_lock<mutex> lk(link->mut);
+                link->pump(TimeUtil::monoUtime());
+            }
+        }
 
         zcmA->stop();
         zcmB->stop();
 
         zcmA->flush();
         zcmB->flush();
+
+        if (args.debug && limited) {
+            cout << "Dropped " << linkA.nDropped << " and conflated " << linkA.nConflated
+                 << " messages to the A url" << endl;
+            cout << "Dropped " << linkB.nDropped << " and conflated " << linkB.nConflated
+                 << " messages to the B url" << endl;
+        }
     }
 };
 
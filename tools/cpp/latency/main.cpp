@@ -0,0 +1,239 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cinttypes>
+
+#include <unistd.h>
+#include <signal.h>
+#include <getopt.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "zcm/zcm.h"
+#include "zcm/stats.h"
+#include "util/TimeUtil.hpp"
+
+using namespace std;
+
+static volatile int done = 0;
+
+static void sighandler(int code)
+{
+    done++;
+    if (done >= 3) exit(1);
+}
+
+struct Args
+{
+    const char *zcmurl = nullptr;
+    string chan        = ".*";
+    double period      = 1.0;
+    bool cumulative    = false;
+
+    bool parse(int argc, char *argv[])
+    {
+        // set some defaults
+        const char *optstring = "hu:c:p:a";
+        struct option long_opts[] = {
+            { "help",             no_argument, 0, 'h' },
+            { "zcm-url",    required_argument, 0, 'u' },
+            { "channel",    required_argument, 0, 'c' },
+            { "period",     required_argument, 0, 'p' },
+            { "cumulative",       no_argument, 0, 'a' },
+            { 0, 0, 0, 0 }
+        };
+
+        int c;
+        while ((c = getopt_long (argc, argv, optstring, long_opts, 0)) >= 0) {
+            switch (c) {
+                case 'u': zcmurl     = optarg;       break;
+                case 'c': chan       = optarg;       break;
+                case 'p': period     = atof(optarg); break;
+                case 'a': cumulative = true;         break;
+                case 'h': default: usage(); return false;
+            };
+        }
+
+        if (period <= 0) {
+            fprintf(stderr, "The report period must be positive\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    void usage()
+    {
+        fprintf(stderr, "usage: zcm-latency [options]\n"
+                "\n"
+                "    ZCM latency utility.  Subscribes to channels on a ZCM transport and\n"
+                "    periodically reports the distribution of publish-to-receive and\n"
+                "    publish-to-callback latency on each channel.\n"
+                "\n"
+                "    Only messages sent by publishers whose url sets 'timestamps=true'\n"
+                "    carry a publish time; other messages are only counted. Latency across\n"
+                "    hosts is only meaningful if their clocks are synchronized.\n"
+                "\n"
+                "Example:\n"
+                "    zcm-latency -u udpm://239.255.76.67:7667?ttl=0\n"
+                "\n"
+                "Options:\n"
+                "\n"
+                "  -h, --help                 Shows this help text and exits\n"
+                "  -u, --zcm-url=URL          Listen for messages on the specified ZCM URL\n"
+                "  -c, --channel=CHAN         Channel string to pass to zcm_subscribe.\n"
+                "                             (default: \".*\")\n"
+                "  -p, --period=SECONDS       Report period (default: 1)\n"
+                "  -a, --cumulative           Don't reset the statistics after each report\n"
+                "\n");
+    }
+};
+
+struct Latency
+{
+    struct ChannelStats
+    {
+        uint64_t msgs = 0;
+        uint64_t unstamped = 0;
+        uint64_t skewed = 0; // received "before" they were published
+        uint64_t maxUs = 0;
+        zcm_stats_hist_t toRecv;
+        zcm_stats_hist_t toCallback;
+
+        ChannelStats()
+        {
+            memset(&toRecv, 0, sizeof(toRecv));
+            memset(&toCallback, 0, sizeof(toCallback));
+        }
+    };
+
+    Args args;
+    zcm_t *zcm = nullptr;
+    zcm_sub_t *sub = nullptr;
+
+    // Protects 'channels', which is written by the zcm handle thread
+    mutex mut;
+    map<string, ChannelStats> channels;
+
+    ~Latency()
+    {
+        if (zcm) {
+            if (sub) zcm_unsubscribe(zcm, sub);
+            zcm_destroy(zcm);
+        }
+    }
+
+    bool init(int argc, char *argv[])
+    {
+        if (!args.parse(argc, argv))
+            return false;
+
+        zcm = zcm_create(args.zcmurl);
+        if (!zcm) {
+            fprintf(stderr, "Couldn't initialize ZCM! Try providing a URL with the "
+                            "-u opt or setting the ZCM_DEFAULT_URL envvar\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    static void record(zcm_stats_hist_t *h, uint64_t us)
+    {
+        uint64_t ns = us * 1000;
+        h->count++;
+        h->sum_ns += ns;
+        h->buckets[zcm_stats_bucket(ns)]++;
+    }
+
+    static void handler(const zcm_recv_buf_t *rbuf, const char *channel, void *usr)
+    { ((Latency*)usr)->handler_(rbuf, channel); }
+
+    void handler_(const zcm_recv_buf_t *rbuf, const char *channel)
+    {
+        int64_t now = TimeUtil::utime();
+
+        unique_lock<mutex> lk(mut);
+        ChannelStats& cs = channels[channel];
+        cs.msgs++;
+
+        if (rbuf->pub_utime == 0) {
+            cs.unstamped++;
+            return;
+        }
+
+        int64_t toRecv = rbuf->recv_utime - rbuf->pub_utime;
+        int64_t toCallback = now - rbuf->pub_utime;
+        if (toRecv < 0 || toCallback < 0) {
+            cs.skewed++;
+            return;
+        }
+
+        record(&cs.toRecv, toRecv);
+        record(&cs.toCallback, toCallback);
+        if ((uint64_t)toCallback > cs.maxUs)
+            cs.maxUs = toCallback;
+    }
+
+    static double us(uint64_t ns) { return ns / 1e3; }
+
+    void report()
+    {
+        unique_lock<mutex> lk(mut);
+
+        printf("%-24s %8s %8s %10s %10s %10s %10s %10s %10s\n", "channel", "msgs", "nostamp",
+               "recv p50", "recv p99", "cb p50", "cb p90", "cb p99", "cb max");
+        for (auto& it : channels) {
+            auto& cs = it.second;
+            printf("%-24s %8" PRIu64 " %8" PRIu64 " %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                   it.first.c_str(), cs.msgs, cs.unstamped,
+                   us(zcm_stats_percentile(&cs.toRecv, 0.5)),
+                   us(zcm_stats_percentile(&cs.toRecv, 0.99)),
+                   us(zcm_stats_percentile(&cs.toCallback, 0.5)),
+                   us(zcm_stats_percentile(&cs.toCallback, 0.9)),
+                   us(zcm_stats_percentile(&cs.toCallback, 0.99)),
+                   (double)cs.maxUs);
+            if (cs.skewed)
+                printf("    %" PRIu64 " messages were received before they were published, "
+                       "check the clocks\n", cs.skewed);
+        }
+        printf("(latencies in microseconds, percentiles are lower bucket bounds)\n\n");
+        fflush(stdout);
+
+        if (!args.cumulative)
+            channels.clear();
+    }
+
+    void run()
+    {
+        sub = zcm_subscribe(zcm, args.chan.c_str(), &handler, this);
+        zcm_start(zcm);
+
+        uint64_t periodUs = args.period * 1e6;
+        uint64_t next = TimeUtil::monoUtime() + periodUs;
+        while (!done) {
+            usleep(10000);
+            if (TimeUtil::monoUtime() < next) continue;
+            report();
+            next += periodUs;
+        }
+
+        zcm_stop(zcm);
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    Latency latency;
+    if (!latency.init(argc, argv)) return 1;
+
+    signal(SIGINT,  sighandler);
+    signal(SIGQUIT, sighandler);
+    signal(SIGTERM, sighandler);
+
+    latency.run();
+
+    return 0;
+}
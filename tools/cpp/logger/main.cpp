@@ -4,7 +4,6 @@
 #include <cassert>
 #include <unistd.h>
 #include <cinttypes>
-#include <regex>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -26,6 +25,7 @@
 
 #include "util/FileUtil.hpp"
 #include "util/TimeUtil.hpp"
+#include "util/ChannelFilter.hpp"
 #include "util/Types.hpp"
 
 using namespace std;
@@ -235,8 +235,8 @@ struct Logger
 
     int next_increment_num          = 0;
 
-    // variables for inverted matching (e.g., logging all but some channels)
-    regex invert_regex;
+    // for inverted matching (e.g., logging all but some channels)
+    ChannelFilter invertFilter;
 
     // these members controlled by writing
     size_t nevents                  = 0;
@@ -301,10 +301,8 @@ struct Logger
             }
         }
 
-        if (args.debug) return true;
-
-        // Compile the regex if we are in invert mode
-        if (args.invert_channels) invert_regex = regex{args.chan};
+        if (args.invert_channels)
+            invertFilter.addRegex(args.chan, ChannelFilter::Verdict::DROP);
 
         return true;
     }
@@ -398,11 +396,7 @@ struct Logger
 
     void handler(const zcm::ReceiveBuffer* rbuf, const string& channel)
     {
-        if (args.invert_channels) {
-            cmatch match;
-            regex_match(channel.c_str(), match, invert_regex);
-            if (match.size() > 0) return;
-        }
+        if (args.invert_channels && !invertFilter.passes(channel)) return;
 
         vector<zcm::LogEvent*> evts;
 
@@ -505,7 +499,7 @@ struct Logger
         if (log->writeEvent(le) != 0) {
             static u64 last_spew_utime = 0;
             string reason = strerror(errno);
-            u64 now = TimeUtil::utime();
+            u64 now = TimeUtil::monoUtime();
             if (now - last_spew_utime > 500000) {
                 cerr << "zcm_eventlog_write_event: " << reason << endl;
                 last_spew_utime = now;
@@ -1,3 +1,5 @@
+#include <cinttypes>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -7,13 +9,21 @@
 #include <signal.h>
 #include <unistd.h>
 #include <limits>
-#include <unordered_map>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <time.h>
 
 #include <zcm/zcm-cpp.hpp>
 
 #include "zcm/json/json.h"
+#include "zcm/stats.h"
 
 #include "util/TimeUtil.hpp"
+#include "util/ChannelFilter.hpp"
 
 using namespace std;
 
@@ -30,10 +40,20 @@ struct Args
     double speed = 1.0;
     bool verbose = false;
     string zcmUrlOut = "";
-    string filename = "";
+    vector<string> filenames;
     string jslpFilename = "";
     zcm::Json::Value jslpRoot;
     string outfile = "";
+    uint64_t spinUs = 100;
+
+    // Playback range. Absolute log timestamps, or seconds from the start of the log
+    int64_t startUtime = 0;
+    int64_t endUtime = 0;
+    double  offsetSec = -1;
+    double  durationSec = -1;
+
+    string controlChannel = "";
+    string controlUrl = "";
 
     bool init(int argc, char *argv[])
     {
@@ -44,30 +64,65 @@ struct Args
             { "zcm-url", required_argument, 0, 'u' },
             { "jslp",    required_argument, 0, 'j' },
             { "verbose",       no_argument, 0, 'v' },
+            { "spin-us", required_argument, 0,  0  },
+            { "start-time",  required_argument, 0, 0 },
+            { "end-time",    required_argument, 0, 0 },
+            { "offset",      required_argument, 0, 0 },
+            { "duration",    required_argument, 0, 0 },
+            { "control",     required_argument, 0, 0 },
+            { "control-url", required_argument, 0, 0 },
             { 0, 0, 0, 0 }
         };
 
         int c;
-        while ((c = getopt_long(argc, argv, "ho:s:u:j:v", long_opts, 0)) >= 0) {
+        int option_index;
+        while ((c = getopt_long(argc, argv, "ho:s:u:j:v", long_opts, &option_index)) >= 0) {
             switch (c) {
                 case 'o':      outfile = string(optarg);       break;
                 case 's':        speed = strtod(optarg, NULL); break;
                 case 'u':    zcmUrlOut = string(optarg);       break;
                 case 'j': jslpFilename = string(optarg);       break;
                 case 'v':      verbose = true;                 break;
+                case 0: {
+                    string name = long_opts[option_index].name;
+                    if      (name == "spin-us")     spinUs = strtoull(optarg, NULL, 10);
+                    else if (name == "start-time")  startUtime = strtoll(optarg, NULL, 10);
+                    else if (name == "end-time")    endUtime = strtoll(optarg, NULL, 10);
+                    else if (name == "offset")      offsetSec = strtod(optarg, NULL);
+                    else if (name == "duration")    durationSec = strtod(optarg, NULL);
+                    else if (name == "control")     controlChannel = optarg;
+                    else if (name == "control-url") controlUrl = optarg;
+                    break;
+                }
                 case 'h': default: usage(); return false;
             };
         }
 
-        if (optind != argc - 1) {
+        if (optind >= argc) {
             cerr << "Please specify a logfile" << endl;
             usage();
             return false;
         }
 
-        filename = string(argv[optind]);
+        for (int i = optind; i < argc; ++i)
+            filenames.push_back(argv[i]);
+
+        if (startUtime != 0 && offsetSec >= 0) {
+            cerr << "Please specify only one of --start-time and --offset" << endl;
+            return false;
+        }
+
+        if (endUtime != 0 && durationSec >= 0) {
+            cerr << "Please specify only one of --end-time and --duration" << endl;
+            return false;
+        }
 
-        ifstream jslpFile { jslpFilename != "" ? jslpFilename : filename + ".jslp" };
+        if (controlChannel != "" && outfile != "") {
+            cerr << "A control channel can't be used when writing to a file" << endl;
+            return false;
+        }
+
+        ifstream jslpFile { jslpFilename != "" ? jslpFilename : filenames[0] + ".jslp" };
         if (jslpFile.good()) {
             zcm::Json::Reader reader;
             if (!reader.parse(jslpFile, jslpRoot, false)) {
@@ -77,11 +132,10 @@ struct Args
                 }
                 return false;
             }
-            if (outfile != "") speed = 0;
             cerr << "Found jslp file. Filtering output." << endl;
         } else if (jslpFilename == "") {
             cerr << "No jslp file specified" << endl;
-            if (outfile != "") {
+            if (outfile != "" && filenames.size() == 1) {
                 cerr << "Output file specified, but no jslp filter metafile found." << endl;
                 return false;
             }
@@ -90,6 +144,7 @@ struct Args
             return false;
         }
 
+        if (outfile != "") speed = 0;
         if (speed == 0) speed = std::numeric_limits<decltype(speed)>::infinity();
 
         return true;
@@ -97,10 +152,11 @@ struct Args
 
     void usage()
     {
-        cerr << "usage: zcm-logplayer [options] [FILE]" << endl
+        cerr << "usage: zcm-logplayer [options] FILE [FILE...]" << endl
              << "" << endl
              << "    Reads packets from an ZCM log file and publishes them to a " << endl
-             << "    ZCM transport." << endl
+             << "    ZCM transport. If several log files are given, their events are" << endl
+             << "    merged in timestamp order." << endl
              << "" << endl
              << "Options:" << endl
              << "" << endl
@@ -108,21 +164,280 @@ struct Args
              << "  -u, --zcm-url=URL      Play logged messages on the specified ZCM URL." << endl
              << "  -o, --output=filename  Instead of broadcasting over zcm, log directly " << endl
              << "                         to a file. Enabling this, ignores the" << endl
-             << "                         \"--speed\" option" << endl
+             << "                         \"--speed\" option. With several input logs" << endl
+             << "                         this merges them into one." << endl
              << "  -j, --jslp=filename    Use this jslp meta file. " << endl
              << "                         If unspecified, zcm-logplayer looks for a file " << endl
-             << "                         with the same filename as the input log and " << endl
+             << "                         with the same filename as the (first) input log and " << endl
              << "                         a .jslp suffix" << endl
              << "  -v, --verbose          Print information about each packet." << endl
+             << "      --spin-us=NUM      Busy wait for the last NUM microseconds before each" << endl
+             << "                         message instead of sleeping, for more precise pacing." << endl
+             << "                         Default is 100, 0 never busy waits." << endl
+             << "      --start-time=UTIME Start playback at this log timestamp (microseconds)," << endl
+             << "                         seeking straight to it instead of reading the log" << endl
+             << "                         up to it." << endl
+             << "      --end-time=UTIME   Stop playback after this log timestamp." << endl
+             << "      --offset=SEC       Start playback SEC seconds after the start of the log." << endl
+             << "      --duration=SEC     Stop playback SEC seconds after it started." << endl
+             << "      --control=CHAN     Listen for playback commands on this channel. Each" << endl
+             << "                         message is a plain text command: \"pause\", \"resume\"" << endl
+             << "                         or \"seek SEC\" (seconds from the start of the log)." << endl
+             << "      --control-url=URL  Listen for commands on this ZCM URL instead of the" << endl
+             << "                         playback url." << endl
              << "  -h, --help             Shows some help text and exits." << endl
              << endl;
     }
 };
 
+// Reads the log ahead of playback on its own thread, so disk reads never delay
+// a publish. Holds copies of up to maxEvents events or maxBytes of data
+struct Prefetcher
+{
+    struct Event
+    {
+        zcm::LogEvent le;
+        vector<char>  buf;
+        Prefetcher   *owner;
+    };
+
+    zcm::LogFile *log;
+    size_t        maxEvents;
+    size_t        maxBytes;
+
+    mutex              mut;
+    condition_variable cond;
+    deque<Event*>      queue;
+    vector<Event*>     spare;
+    size_t             bytes = 0;
+    bool               eof = false;
+    bool               stopping = false;
+    thread             reader;
+
+    // Requested by seek(), carried out by the reader thread
+    bool               seekPending = false;
+    int64_t            seekUtime = 0;
+    uint64_t           generation = 0;
+
+    Prefetcher(zcm::LogFile *log, size_t maxEvents = 4096, size_t maxBytes = 64 << 20) :
+        log(log), maxEvents(maxEvents), maxBytes(maxBytes)
+    {
+        reader = thread(&Prefetcher::run, this);
+    }
+
+    ~Prefetcher()
+    {
+        stop();
+        for (auto *ev : queue) delete ev;
+        for (auto *ev : spare) delete ev;
+    }
+
+    void stop()
+    {
+        {
+            unique_lock<mutex> lk(mut);
+            stopping = true;
+        }
+        cond.notify_all();
+        if (reader.joinable()) reader.join();
+    }
+
+    // Returns nullptr at the end of the log. The event stays valid until it is
+    // passed back to release()
+    Event *next()
+    {
+        unique_lock<mutex> lk(mut);
+        cond.wait(lk, [&]{ return !queue.empty() || eof || stopping; });
+        if (queue.empty()) return nullptr;
+        Event *ev = queue.front();
+        queue.pop_front();
+        bytes -= ev->buf.size();
+        lk.unlock();
+        cond.notify_all();
+        return ev;
+    }
+
+    void release(Event *ev)
+    {
+        unique_lock<mutex> lk(mut);
+        spare.push_back(ev);
+    }
+
+    // Drops the events read so far. next() continues from the first event at or
+    // after 'utime'
+    void seek(int64_t utime)
+    {
+        {
+            unique_lock<mutex> lk(mut);
+            for (auto *ev : queue) spare.push_back(ev);
+            queue.clear();
+            bytes = 0;
+            eof = false;
+            seekPending = true;
+            seekUtime = utime;
+            generation++;
+        }
+        cond.notify_all();
+    }
+
+  private:
+    // Events before this are skipped after a seek
+    int64_t skipBeforeUtime = INT64_MIN;
+
+    // Moves the log to the last event before 'utime' without reading up to it
+    void seekLog(int64_t utime)
+    {
+        skipBeforeUtime = utime;
+
+        if (log->seekToTimestamp(utime) == 0) {
+            // The bisection stops at an event next to the target, which may be
+            // after it, so back up to an event before it
+            const zcm::LogEvent *le;
+            while ((le = log->readPrevEvent()) && le->timestamp >= utime);
+            if (le) return;
+        }
+
+        // Either the target is before the first event, or the bisection gave up
+        // near the end of the log
+        fseeko(log->getFilePtr(), 0, SEEK_SET);
+    }
+
+    void run()
+    {
+        unique_lock<mutex> lk(mut);
+        while (true) {
+            cond.wait(lk, [&]{
+                return stopping || seekPending ||
+                       (!eof && (queue.empty() ||
+                                 (queue.size() < maxEvents && bytes < maxBytes)));
+            });
+            if (stopping) break;
+
+            if (seekPending) {
+                seekPending = false;
+                int64_t utime = seekUtime;
+                lk.unlock();
+                seekLog(utime);
+                lk.lock();
+                continue;
+            }
+
+            uint64_t gen = generation;
+
+            Event *ev;
+            if (spare.empty()) {
+                ev = new Event();
+                ev->owner = this;
+            } else {
+                ev = spare.back();
+                spare.pop_back();
+            }
+            lk.unlock();
+
+            const zcm::LogEvent *le;
+            do {
+                le = log->readNextEvent();
+            } while (le && le->timestamp < skipBeforeUtime);
+            skipBeforeUtime = INT64_MIN;
+
+            if (le) {
+                ev->le = *le;
+                ev->buf.assign(le->data, le->data + le->datalen);
+                ev->le.data = ev->buf.data();
+            }
+
+            lk.lock();
+            if (!le || gen != generation) {
+                spare.push_back(ev);
+                if (gen != generation) continue;
+                eof = true;
+                cond.notify_all();
+                continue;
+            }
+            queue.push_back(ev);
+            bytes += ev->buf.size();
+            cond.notify_all();
+        }
+    }
+};
+
+// Merges the events of several logs into one stream in timestamp order, by
+// keeping the next event of each log in a heap
+struct LogMerger
+{
+    vector<Prefetcher*> logs;
+
+    struct Head
+    {
+        Prefetcher::Event *ev;
+        size_t             log;
+
+        // Ties go to the log given first on the command line
+        bool operator<(const Head& o) const
+        {
+            if (ev->le.timestamp != o.ev->le.timestamp)
+                return ev->le.timestamp > o.ev->le.timestamp;
+            return log > o.log;
+        }
+    };
+    vector<Head> heap;
+
+    LogMerger(const vector<zcm::LogFile*>& files)
+    {
+        // The read ahead budget is shared between the logs
+        size_t maxBytes = max((size_t)(64 << 20) / files.size(), (size_t)(1 << 20));
+        for (auto *f : files)
+            logs.push_back(new Prefetcher(f, 4096, maxBytes));
+        for (size_t i = 0; i < logs.size(); ++i)
+            pushNext(i);
+    }
+
+    ~LogMerger()
+    {
+        for (auto& h : heap) h.ev->owner->release(h.ev);
+        for (auto *p : logs) delete p;
+    }
+
+    // Returns nullptr once every log has ended. Pass the event back to release()
+    Prefetcher::Event *next()
+    {
+        if (heap.empty()) return nullptr;
+        pop_heap(heap.begin(), heap.end());
+        Head h = heap.back();
+        heap.pop_back();
+        pushNext(h.log);
+        return h.ev;
+    }
+
+    void release(Prefetcher::Event *ev) { ev->owner->release(ev); }
+
+    // Timestamp of the event next() would return, or INT64_MAX at the end
+    int64_t peekUtime() const
+    { return heap.empty() ? INT64_MAX : heap.front().ev->le.timestamp; }
+
+    void seek(int64_t utime)
+    {
+        for (auto& h : heap) release(h.ev);
+        heap.clear();
+        for (auto *p : logs) p->seek(utime);
+        for (size_t i = 0; i < logs.size(); ++i)
+            pushNext(i);
+    }
+
+  private:
+    void pushNext(size_t log)
+    {
+        Prefetcher::Event *ev = logs[log]->next();
+        if (!ev) return;
+        heap.push_back({ ev, log });
+        push_heap(heap.begin(), heap.end());
+    }
+};
+
 struct LogPlayer
 {
     Args args;
-    zcm::LogFile *zcmIn  = nullptr;
+    vector<zcm::LogFile*> logsIn;
     zcm::ZCM     *zcmOut = nullptr;
     zcm::LogFile *logOut = nullptr;
 
@@ -139,14 +454,26 @@ struct LogPlayer
     enum class FilterMode { WHITELIST, BLACKLIST, SPECIFIED, NUM_MODES };
     FilterMode filterMode;
 
-    unordered_map<string, bool> channelMap;
+    ChannelFilter filter;
+
+    // Commands from the control channel, written by zcmCtrl's handle thread and
+    // applied by the playback loop
+    zcm::ZCM   *zcmCtrl = nullptr;
+    mutex       ctrlMut;
+    atomic_bool ctrlPending {false};
+    bool        ctrlPaused = false;
+    double      ctrlSeekSec = -1;
+
+    // Timestamp of the first event of the log(s)
+    int64_t logStartUtime = 0;
 
     LogPlayer() { }
 
     ~LogPlayer()
     {
+        if (zcmCtrl) { zcmCtrl->stop(); delete zcmCtrl; }
         if (logOut) { logOut->close(); delete logOut; }
-        if (zcmIn)  { delete zcmIn;                   }
+        for (auto *l : logsIn) delete l;
         if (zcmOut) { delete zcmOut;                  }
     }
 
@@ -155,10 +482,12 @@ struct LogPlayer
         if (!args.init(argc, argv))
             return false;
 
-        zcmIn = new zcm::LogFile(args.filename, "r");
-        if (!zcmIn->good()) {
-            cerr << "Error: Failed to open '" << args.filename << "'" << endl;
-            return false;
+        for (auto& filename : args.filenames) {
+            logsIn.push_back(new zcm::LogFile(filename, "r"));
+            if (!logsIn.back()->good()) {
+                cerr << "Error: Failed to open '" << filename << "'" << endl;
+                return false;
+            }
         }
 
         if (args.outfile == "") {
@@ -169,6 +498,16 @@ struct LogPlayer
             }
 
             cout << "Using playback speed " << args.speed << endl;
+
+            if (args.controlChannel != "") {
+                zcmCtrl = new zcm::ZCM(args.controlUrl != "" ? args.controlUrl
+                                                             : args.zcmUrlOut);
+                if (!zcmCtrl->good()) {
+                    cerr << "Error: Failed to create control ZCM" << endl;
+                    return false;
+                }
+                zcmCtrl->subscribe(args.controlChannel, &controlHandler, this);
+            }
         } else {
             logOut = new zcm::LogFile(args.outfile, "w");
             if (!logOut->good()) {
@@ -241,15 +580,20 @@ struct LogPlayer
                 return false;
             }
 
+            if (filterMode == FilterMode::WHITELIST)
+                filter.setDefault(ChannelFilter::Verdict::DROP);
+            else if (filterMode == FilterMode::SPECIFIED)
+                filter.setDefault(ChannelFilter::Verdict::UNSPECIFIED);
+
             auto newChannel = [&] (string channel) {
+                bool pass = filterMode != FilterMode::BLACKLIST;
                 if (filterMode == FilterMode::SPECIFIED)
-                    channelMap[channel] = args.jslpRoot["FILTER"]["channels"][channel].asBool();
-                else
-                    channelMap[channel] = true;
+                    pass = args.jslpRoot["FILTER"]["channels"][channel].asBool();
+                filter.addChannel(channel, pass ? ChannelFilter::Verdict::PASS
+                                                : ChannelFilter::Verdict::DROP);
 
                 if (args.verbose)
-                    cout << channel << " : "
-                         << (channelMap[channel] ? "true" : "false") << endl;
+                    cout << channel << " : " << (pass ? "true" : "false") << endl;
             };
 
             if (args.jslpRoot["FILTER"]["channels"].isArray()) {
@@ -264,52 +608,174 @@ struct LogPlayer
         return true;
     }
 
+    // Sleeps until the monotonic time 'deadlineNs'. The last spinUs are spent
+    // polling the clock instead, since waking up from a sleep can take tens of
+    // microseconds. Sleeps are capped so that signals are noticed promptly
+    bool waitUntil(uint64_t deadlineNs)
+    {
+        uint64_t spinNs = args.spinUs * 1000;
+        while (!done && !ctrlPending) {
+            uint64_t now = TimeUtil::monoNtime();
+            if (now + spinNs >= deadlineNs) break;
+            uint64_t wake = min(deadlineNs - spinNs, now + 100000000);
+            timespec ts;
+            ts.tv_sec = wake / 1000000000;
+            ts.tv_nsec = wake % 1000000000;
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        }
+        while (!done && !ctrlPending && TimeUtil::monoNtime() < deadlineNs);
+        return !done && !ctrlPending;
+    }
+
+    static void controlHandler(const zcm::ReceiveBuffer* rbuf, const string& channel, void* usr)
+    {
+        LogPlayer *lp = (LogPlayer*)usr;
+        istringstream ss(string(rbuf->data, rbuf->data_size));
+        string cmd;
+        ss >> cmd;
+
+        unique_lock<mutex> lk(lp->ctrlMut);
+        if (cmd == "pause") {
+            lp->ctrlPaused = true;
+        } else if (cmd == "resume") {
+            lp->ctrlPaused = false;
+        } else if (cmd == "seek") {
+            double sec;
+            if (!(ss >> sec) || sec < 0) {
+                cerr << "Ignoring bad control command: " << ss.str() << endl;
+                return;
+            }
+            lp->ctrlSeekSec = sec;
+        } else {
+            cerr << "Ignoring unknown control command: " << ss.str() << endl;
+            return;
+        }
+        lp->ctrlPending = true;
+    }
+
+    // Applies the pending control commands, and blocks while paused.
+    // Returns true if the logs were moved by a seek
+    bool applyControl(LogMerger& logs, bool& paused)
+    {
+        bool seeked = false;
+        paused = false;
+        while (!done) {
+            double seekSec;
+            bool p;
+            {
+                unique_lock<mutex> lk(ctrlMut);
+                ctrlPending = false;
+                seekSec = ctrlSeekSec;
+                ctrlSeekSec = -1;
+                p = ctrlPaused;
+            }
+
+            if (seekSec >= 0) {
+                cout << "Seeking to " << seekSec << "s" << endl;
+                logs.seek(logStartUtime + seekSec * 1e6);
+                seeked = true;
+            }
+
+            if (!p) break;
+            if (!paused) cout << "Paused" << endl;
+            paused = true;
+            usleep(10000);
+        }
+        return seeked;
+    }
+
+    // Publishes the event, waiting for room in the send queue rather than losing
+    // the message when the transport can't keep up. Returns the zcm error code
+    int publish(const zcm::LogEvent *le, bool& blocked)
+    {
+        blocked = false;
+        useconds_t backoffUs = 10;
+        while (true) {
+            if (zcmOut->publish(le->channel, le->data, le->datalen) == 0) return ZCM_EOK;
+            int ret = zcmOut->err();
+            if (ret != ZCM_EAGAIN || done) return ret;
+            blocked = true;
+            usleep(backoffUs);
+            backoffUs = min(backoffUs * 2, (useconds_t)1000);
+        }
+    }
+
+    // Returns true if the event passes the jslp filter. Sets err if the filter
+    // can't decide
+    bool passesFilter(const zcm::LogEvent *le, int& err)
+    {
+        if (!filtering) return true;
+
+        assert(filterType == FilterType::CHANNELS && "Fatal error.");
+
+        switch (filter.verdict(le->channel)) {
+            case ChannelFilter::Verdict::PASS: return true;
+            case ChannelFilter::Verdict::DROP: return false;
+            case ChannelFilter::Verdict::UNSPECIFIED:
+                cerr << "jslp file does not specify filtering behavior "
+                     << "for channel: " << le->channel << endl;
+                err = 1;
+                return false;
+        }
+        return false;
+    }
+
     int run()
     {
         int err = 0;
 
         uint64_t firstMsgUtime = UINT64_MAX;
-        uint64_t lastMsgUtime = 0;
-        uint64_t lastDispatchUtime = 0;
         bool startedPub = false;
 
         if (startMode == StartMode::NUM_MODES) startedPub = true;
 
+        // Every message is scheduled against the time the first published message
+        // went out, so errors in one wait never carry over to the next
+        bool paced = args.speed != numeric_limits<decltype(args.speed)>::infinity();
+        int64_t  anchorMsgUtime = 0;
+        uint64_t anchorNs = 0;
+        bool     anchored = false;
+
+        // How late each publish was, relative to its deadline
+        zcm_stats_hist_t lateness;
+        memset(&lateness, 0, sizeof(lateness));
+        uint64_t maxLateNs = 0;
+
+        // Throughput, reported every second when playing as fast as possible
+        uint64_t nPublished = 0, nBytes = 0, nBlocked = 0, nFailed = 0;
+        uint64_t startNs = 0, lastReportNs = 0;
+        uint64_t lastReportPublished = 0, lastReportBytes = 0;
+
+        LogMerger logs(logsIn);
+
+        logStartUtime = logs.peekUtime();
+        int64_t startUtime = args.startUtime;
+        if (args.offsetSec >= 0)
+            startUtime = logStartUtime + args.offsetSec * 1e6;
+        if (startUtime > logStartUtime) {
+            logs.seek(startUtime);
+        } else {
+            startUtime = logStartUtime;
+        }
+
+        int64_t endUtime = args.endUtime;
+        if (args.durationSec >= 0)
+            endUtime = startUtime + args.durationSec * 1e6;
+
+        if (zcmCtrl) zcmCtrl->start();
+
         while (!done) {
-            const zcm::LogEvent* le = zcmIn->readNextEvent();
-            if (!le) {
+            Prefetcher::Event *ev = logs.next();
+            if (!ev || (endUtime != 0 && ev->le.timestamp > endUtime)) {
+                if (ev) logs.release(ev);
                 done = true;
                 continue;
             }
-
-            uint64_t now = TimeUtil::utime();
-
-            if (lastMsgUtime == 0)
-                lastMsgUtime = le->timestamp;
-
-            if (lastDispatchUtime == 0)
-                lastDispatchUtime = now;
+            const zcm::LogEvent* le = &ev->le;
 
             if (firstMsgUtime == UINT64_MAX)
                 firstMsgUtime = (uint64_t) le->timestamp;
 
-            uint64_t localDiff = now - lastDispatchUtime;
-            uint64_t logDiff = (uint64_t) le->timestamp - lastMsgUtime;
-            uint64_t logDiffSpeed = logDiff / args.speed;
-            uint64_t diff = logDiffSpeed > localDiff ? logDiffSpeed - localDiff
-                                                     : 0;
-            // TODO: this doesn't reproduce the input frequency perfectly but that is likely
-            //       due to the difficulty of accurately timing events with the OS scheduler
-            //       active. If it becomes an issue in the future, we could devote more time
-            //       to improving the loop timing accuracy.
-            //       Note that this inaccuracy does not apply if you are filting a log into
-            //       a different log via a jslp file because the log times are preserved.
-            //       Possible resource: http://www.tldp.org/HOWTO/IO-Port-Programming-4.html
-            timespec delay;
-            delay.tv_sec = (long int) diff / 1000000;
-            delay.tv_nsec = (long int) (diff - (delay.tv_sec * 1000000)) * 1000;
-            if (diff > 3 && startedPub) nanosleep(&delay, nullptr);
-
             if (!startedPub) {
                 if (startMode == StartMode::CHANNEL) {
                     if (le->channel == startChan)
@@ -320,46 +786,122 @@ struct LogPlayer
                 }
             }
 
-            auto publish = [&](){
-                if (args.verbose)
-                    printf("%.3f Channel %-20s size %d\n", le->timestamp / 1e6,
-                           le->channel.c_str(), le->datalen);
-
-                if (args.outfile == "")
-                    zcmOut->publish(le->channel, le->data, le->datalen);
-                else
-                    logOut->writeEvent(le);
-            };
+            if (!startedPub || !passesFilter(le, err)) {
+                if (err) done = true;
+                logs.release(ev);
+                continue;
+            }
 
-            if (startedPub) {
-                if (!filtering) {
-                    publish();
-                } else {
-                    if (filterType == FilterType::CHANNELS) {
-                        if (filterMode == FilterMode::WHITELIST) {
-                            if (channelMap.count(le->channel) > 0) publish();
-                        } else if (filterMode == FilterMode::BLACKLIST) {
-                            if (channelMap.count(le->channel) == 0) publish();
-                        } else if (filterMode == FilterMode::SPECIFIED) {
-                            if (channelMap.count(le->channel) == 0) {
-                                cerr << "jslp file does not specify filtering behavior "
-                                     << "for channel: " << le->channel << endl;
-                                done = true;
-                                err = 1;
-                                continue;
-                            }
-                            if (channelMap[le->channel]) publish();
-                        } else {
-                            assert(false && "Fatal error.");
-                        }
-                    } else {
-                        assert(false && "Fatal error.");
+            // Wait for the message's deadline, applying control commands as they
+            // come in. After a pause or seek, the schedule restarts from the next
+            // message played
+            bool skip = false;
+            uint64_t deadlineNs = 0;
+            while (true) {
+                if (ctrlPending) {
+                    bool paused;
+                    if (applyControl(logs, paused)) {
+                        anchored = false;
+                        skip = true;
+                        break;
                     }
+                    if (paused) anchored = false;
                 }
+
+                if (!anchored) {
+                    anchored = true;
+                    anchorMsgUtime = le->timestamp;
+                    anchorNs = TimeUtil::monoNtime();
+                }
+
+                if (!paced) break;
+
+                int64_t logDiff = le->timestamp - anchorMsgUtime;
+                deadlineNs = anchorNs;
+                if (logDiff > 0) deadlineNs += logDiff * 1000 / args.speed;
+                if (waitUntil(deadlineNs)) break;
+                if (done) {
+                    skip = true;
+                    break;
+                }
+            }
+            if (skip) {
+                logs.release(ev);
+                continue;
+            }
+
+            if (paced) {
+                uint64_t now = TimeUtil::monoNtime();
+                uint64_t late = now > deadlineNs ? now - deadlineNs : 0;
+                lateness.count++;
+                lateness.sum_ns += late;
+                lateness.buckets[zcm_stats_bucket(late)]++;
+                if (late > maxLateNs) maxLateNs = late;
+            }
+
+            if (args.verbose)
+                printf("%.3f Channel %-20s size %d\n", le->timestamp / 1e6,
+                       le->channel.c_str(), le->datalen);
+
+            if (args.outfile == "") {
+                bool blocked;
+                int ret = publish(le, blocked);
+                if (blocked) nBlocked++;
+                if (ret != ZCM_EOK && !done) {
+                    cerr << "Failed to publish on " << le->channel << ": "
+                         << zcmOut->strerrno(ret) << endl;
+                    nFailed++;
+                }
+            } else if (logOut->writeEvent(le) != 0) {
+                cerr << "Failed to write to " << args.outfile << ": "
+                     << strerror(errno) << endl;
+                done = true;
+                err = 1;
+            }
+
+            nPublished++;
+            nBytes += le->datalen;
+
+            uint64_t now = TimeUtil::monoNtime();
+            if (startNs == 0) startNs = lastReportNs = now;
+            if (!paced && !args.verbose && now - lastReportNs > 1000000000) {
+                double dt = (now - lastReportNs) / 1e9;
+                printf("Replayed %" PRIu64 " messages ( %" PRIu64 " MB )  |  "
+                       "msgs/s: %10.1f  |  MB/s: %8.2f\n",
+                       nPublished, nBytes >> 20,
+                       (nPublished - lastReportPublished) / dt,
+                       (nBytes - lastReportBytes) / dt / 1048576);
+                fflush(stdout);
+                lastReportNs = now;
+                lastReportPublished = nPublished;
+                lastReportBytes = nBytes;
             }
 
-            lastDispatchUtime = TimeUtil::utime();
-            lastMsgUtime = le->timestamp;
+            logs.release(ev);
+        }
+
+        // Don't lose whatever is still waiting in the send queue
+        if (zcmOut) zcmOut->flush();
+
+        if (nPublished > 0) {
+            double dt = (TimeUtil::monoNtime() - startNs) / 1e9;
+            printf("Replayed %" PRIu64 " messages ( %.1f MB ) in %.3f s  |  "
+                   "msgs/s: %.1f  |  MB/s: %.2f\n", nPublished, nBytes / 1048576.0, dt,
+                   dt > 0 ? nPublished / dt : 0, dt > 0 ? nBytes / dt / 1048576 : 0);
+            if (nBlocked > 0)
+                printf("%" PRIu64 " messages waited for the transport to catch up\n",
+                       nBlocked);
+            if (nFailed > 0)
+                printf("%" PRIu64 " messages could not be published\n", nFailed);
+        }
+
+        if (paced && lateness.count > 0) {
+            printf("Published %" PRIu64 " messages. Lateness (us): mean %.1f, "
+                   "p50 %.1f, p99 %.1f, max %.1f\n", lateness.count,
+                   lateness.sum_ns / 1e3 / lateness.count,
+                   zcm_stats_percentile(&lateness, 0.5) / 1e3,
+                   zcm_stats_percentile(&lateness, 0.99) / 1e3,
+                   maxLateNs / 1e3);
         }
 
         return err;
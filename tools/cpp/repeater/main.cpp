@@ -155,7 +155,7 @@ struct Repeater
                 return;
         }
 
-        zcm_publish(zcmDest, channel, rbuf->data, rbuf->data_size);
+        zcm_forward(zcmDest, channel, rbuf);
     }
 
     void run()
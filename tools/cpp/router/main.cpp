@@ -0,0 +1,566 @@
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <regex>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <signal.h>
+
+#include <getopt.h>
+
+#include "zcm/zcm-cpp.hpp"
+#include "zcm/zcm_coretypes.h"
+
+#include "util/TranscoderPluginDb.hpp"
+#include "util/TimeUtil.hpp"
+#include "util/TokenBucket.hpp"
+
+using namespace std;
+
+static atomic_int done {0};
+
+static void sighandler(int signal)
+{
+    done++;
+    if (done == 3) exit(1);
+}
+
+struct Args
+{
+    string config = "";
+    string plugin_path = "";
+    bool   debug = false;
+
+    bool parse(int argc, char *argv[])
+    {
+        // set some defaults
+        const char *optstring = "hc:p:d";
+        struct option long_opts[] = {
+            { "help",              no_argument, 0,  'h' },
+            { "config",      required_argument, 0,  'c' },
+            { "plugin-path", required_argument, 0,  'p' },
+            { "debug",             no_argument, 0,  'd' },
+            { 0, 0, 0, 0 }
+        };
+
+        int c;
+        while ((c = getopt_long(argc, argv, optstring, long_opts, 0)) >= 0) {
+            switch (c) {
+                case 'c': config = optarg; break;
+                case 'p': plugin_path = optarg; break;
+                case 'd': debug = true; break;
+                case 'h': default: usage(); return false;
+            };
+        }
+
+        if (config == "") {
+            cerr << "Please specify a routing table with the -c option" << endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void usage()
+    {
+        cerr << "usage: zcm-router [options]" << endl
+             << "" << endl
+             << "    ZCM router utility. Republishes channels between any number of ZCM" << endl
+             << "    transports according to a routing table. Each destination has its own" << endl
+             << "    thread and bounded queue, so a slow transport never holds up the others." << endl
+             << "" << endl
+             << "Example:" << endl
+             << "    zcm-router -c routes.txt" << endl
+             << "" << endl
+             << "Options:" << endl
+             << "" << endl
+             << "  -h, --help                 Shows this help text and exits" << endl
+             << "  -c, --config=FILE          Routing table to load" << endl
+             << "  -p, --plugin-path=path     Path to shared library containing transcoder plugins" << endl
+             << "  -d, --debug                Print the routes as they are resolved and the" << endl
+             << "                             per-destination counts on exit" << endl
+             << "" << endl
+             << "Routing table:" << endl
+             << "" << endl
+             << "    One entry per line, '#' starts a comment." << endl
+             << "" << endl
+             << "    endpoint NAME URL [queue=N] [bandwidth=BPS]" << endl
+             << "        Declares a transport. 'queue' bounds the messages waiting to be" << endl
+             << "        published on it (default 64); when full, the oldest is dropped." << endl
+             << "        'bandwidth' limits the bytes per second published on it." << endl
+             << "" << endl
+             << "    route SRC CHANNEL DST[,DST...] [prefix=P] [rate=HZ] [decimation=N]" << endl
+             << "        Republishes the channels of endpoint SRC that match the regex CHANNEL" << endl
+             << "        on each DST, prefixed by P, at most HZ times per second per channel" << endl
+             << "        and skipping N messages out of every N+1. For each destination," << endl
+             << "        the first route that matches a channel is used." << endl
+             << "" << endl
+             << "    Ex:" << endl
+             << "        endpoint lan   udpm://239.255.76.67:7667?ttl=0" << endl
+             << "        endpoint radio serial:///dev/ttyUSB0?baud=57600 queue=16 bandwidth=5000" << endl
+             << "        route    lan   POSE|STATUS_.* radio prefix=LAN_ rate=5" << endl
+             << "        route    radio .*             lan" << endl
+             << "" << endl << endl;
+    }
+};
+
+struct Router
+{
+    Args args;
+
+    static TranscoderPluginDb* pluginDb;
+    static vector<zcm::TranscoderPlugin*> plugins;
+
+    // One transport. Messages routed to it are queued by the sources' handle
+    // threads and published by its own worker thread
+    struct Endpoint
+    {
+        struct OutMsg
+        {
+            string       channel;
+            vector<char> data;
+        };
+
+        string    name;
+        string    url;
+        zcm::ZCM *zcm = nullptr;
+        size_t    maxQueue = 64;
+        double    bytesPerSec = 0;
+
+        mutex              mut;
+        condition_variable cond;
+        deque<OutMsg>      queue;
+        vector<vector<char>> spare; // buffers of sent messages, reused by push()
+        bool               stopping = false;
+        thread             worker;
+
+        uint64_t  nSent = 0;
+        uint64_t  nDropped = 0;
+
+        ~Endpoint() { if (zcm) delete zcm; }
+
+        void push(const string& channel, const char *data, size_t len)
+        {
+            unique_lock<mutex> lk(mut);
+            if (queue.size() >= maxQueue) {
+                spare.push_back(move(queue.front().data));
+                queue.pop_front();
+                nDropped++;
+            }
+            queue.emplace_back();
+            OutMsg& msg = queue.back();
+            msg.channel = channel;
+            if (!spare.empty()) {
+                msg.data = move(spare.back());
+                spare.pop_back();
+            }
+            msg.data.assign(data, data + len);
+            lk.unlock();
+            cond.notify_one();
+        }
+
+        // Publishes the message, waiting for room in the transport's send queue
+        // rather than losing it when the transport can't keep up. Meanwhile new
+        // messages pile up in our own queue, which drops the oldest when full.
+        // Returns the zcm error code
+        int publish(const OutMsg& msg)
+        {
+            useconds_t backoffUs = 10;
+            while (true) {
+                if (zcm->publish(msg.channel, msg.data.data(), msg.data.size()) == ZCM_EOK)
+                    return ZCM_EOK;
+                int ret = zcm->err();
+                if (ret != ZCM_EAGAIN) return ret;
+
+                unique_lock<mutex> lk(mut);
+                if (cond.wait_for(lk, chrono::microseconds(backoffUs), [&]{ return stopping; }))
+                    return ret;
+                backoffUs = min(backoffUs * 2, (useconds_t)1000);
+            }
+        }
+
+        void run()
+        {
+            TokenBucket bucket(bytesPerSec, TimeUtil::monoUtime());
+
+            unique_lock<mutex> lk(mut);
+            while (true) {
+                cond.wait(lk, [&]{ return stopping || !queue.empty(); });
+                if (stopping) break;
+
+                OutMsg msg = move(queue.front());
+                queue.pop_front();
+                lk.unlock();
+
+                while (true) {
+                    bucket.refill(TimeUtil::monoUtime());
+                    if (bucket.allows(msg.data.size())) break;
+                    usleep(bucket.waitUs(msg.data.size()));
+                }
+
+                int ret = publish(msg);
+                if (ret == ZCM_EOK) bucket.spend(msg.data.size());
+
+                lk.lock();
+                if (ret == ZCM_EOK) nSent++;
+                else                nDropped++;
+                spare.push_back(move(msg.data));
+            }
+        }
+
+        void start() { worker = thread(&Endpoint::run, this); }
+
+        void stop()
+        {
+            if (!worker.joinable()) return;
+            {
+                unique_lock<mutex> lk(mut);
+                stopping = true;
+            }
+            cond.notify_all();
+            worker.join();
+        }
+    };
+
+    struct Target
+    {
+        Endpoint *dest = nullptr;
+        string    prefix = "";
+        uint64_t  intervalUs = 0;
+        int       decimation = 0;
+    };
+
+    struct Route
+    {
+        string         pattern;
+        regex          channel;
+        vector<Target> targets;
+    };
+
+    // Where one channel of a source goes, resolved from the routes the first
+    // time the channel is seen
+    struct ChannelRoute
+    {
+        const Target *target;
+        string        outChannel;
+        int           nSkipped = 0;
+        uint64_t      lastSendUs = 0;
+    };
+
+    // Only touched by the source endpoint's handle thread
+    struct SourceInfo
+    {
+        Endpoint     *src = nullptr;
+        vector<Route> routes;
+        unordered_map<string, vector<ChannelRoute>> channels;
+        bool          debug = false;
+
+        vector<ChannelRoute>& resolve(const string& channel)
+        {
+            auto it = channels.find(channel);
+            if (it != channels.end()) return it->second;
+
+            vector<ChannelRoute>& ret = channels[channel];
+            for (auto& r : routes) {
+                if (!regex_match(channel, r.channel)) continue;
+                for (auto& t : r.targets) {
+                    bool seen = false;
+                    for (auto& cr : ret) seen |= cr.target->dest == t.dest;
+                    if (seen) continue;
+
+                    ChannelRoute cr;
+                    cr.target = &t;
+                    cr.outChannel = t.prefix + channel;
+                    if (cr.outChannel.size() > ZCM_CHANNEL_MAXLEN) {
+                        cerr << "Not routing " << channel << " from " << src->name
+                             << " to " << t.dest->name << ": " << cr.outChannel
+                             << " is too long" << endl;
+                        continue;
+                    }
+                    if (debug)
+                        cout << "Routing " << channel << " from " << src->name << " to "
+                             << t.dest->name << " as " << cr.outChannel << endl;
+                    ret.push_back(move(cr));
+                }
+            }
+            return ret;
+        }
+
+        void route(const string& channel, const char *data, size_t len)
+        {
+            uint64_t now = 0;
+            for (auto& cr : resolve(channel)) {
+                const Target& t = *cr.target;
+                if (cr.nSkipped++ != t.decimation) continue;
+                cr.nSkipped = 0;
+                if (t.intervalUs > 0) {
+                    if (now == 0) now = TimeUtil::monoUtime();
+                    if (cr.lastSendUs != 0 && now - cr.lastSendUs < t.intervalUs) continue;
+                    cr.lastSendUs = now;
+                }
+                t.dest->push(cr.outChannel, data, len);
+            }
+        }
+    };
+
+    // Endpoints and sources are never added to after the table is loaded
+    deque<Endpoint>    endpoints;
+    deque<SourceInfo>  sources;
+
+    Router() {}
+
+    ~Router()
+    {
+        endpoints.clear();
+        if (pluginDb) { delete pluginDb; pluginDb = nullptr; }
+    }
+
+    Endpoint *findEndpoint(const string& name)
+    {
+        for (auto& ep : endpoints)
+            if (ep.name == name) return &ep;
+        return nullptr;
+    }
+
+    SourceInfo *sourceFor(Endpoint *src)
+    {
+        for (auto& si : sources)
+            if (si.src == src) return &si;
+        sources.emplace_back();
+        sources.back().src = src;
+        sources.back().debug = args.debug;
+        return &sources.back();
+    }
+
+    // Splits "key=value" options, returns false on a malformed one
+    static bool parseOptions(istringstream& ss, unordered_map<string, string>& opts)
+    {
+        string tok;
+        while (ss >> tok) {
+            size_t eq = tok.find('=');
+            if (eq == string::npos || eq == 0) return false;
+            opts[tok.substr(0, eq)] = tok.substr(eq + 1);
+        }
+        return true;
+    }
+
+    bool loadTable()
+    {
+        ifstream file(args.config);
+        if (!file.good()) {
+            cerr << "Unable to open routing table " << args.config << endl;
+            return false;
+        }
+
+        string line;
+        size_t lineno = 0;
+        while (getline(file, line)) {
+            lineno++;
+            size_t hash = line.find('#');
+            if (hash != string::npos) line.resize(hash);
+
+            istringstream ss(line);
+            string kind;
+            if (!(ss >> kind)) continue;
+
+            auto fail = [&](const string& why) {
+                cerr << args.config << ":" << lineno << ": " << why << endl;
+                return false;
+            };
+
+            unordered_map<string, string> opts;
+            if (kind == "endpoint") {
+                string name, url;
+                if (!(ss >> name >> url)) return fail("expected 'endpoint NAME URL'");
+                if (findEndpoint(name)) return fail("duplicate endpoint " + name);
+                if (!parseOptions(ss, opts)) return fail("malformed option");
+
+                endpoints.emplace_back();
+                Endpoint& ep = endpoints.back();
+                ep.name = name;
+                ep.url = url;
+                for (auto& o : opts) {
+                    if      (o.first == "queue")     ep.maxQueue = atoi(o.second.c_str());
+                    else if (o.first == "bandwidth") ep.bytesPerSec = atof(o.second.c_str());
+                    else return fail("unknown endpoint option " + o.first);
+                }
+                if (ep.maxQueue == 0) return fail("queue must be at least 1");
+
+            } else if (kind == "route") {
+                string srcName, pattern, dsts;
+                if (!(ss >> srcName >> pattern >> dsts))
+                    return fail("expected 'route SRC CHANNEL DST[,DST...]'");
+                if (!parseOptions(ss, opts)) return fail("malformed option");
+
+                Endpoint *src = findEndpoint(srcName);
+                if (!src) return fail("unknown endpoint " + srcName);
+
+                Route r;
+                r.pattern = pattern;
+                try {
+                    r.channel = regex(pattern);
+                } catch (const regex_error&) {
+                    return fail("bad channel regex " + pattern);
+                }
+
+                Target proto;
+                for (auto& o : opts) {
+                    if (o.first == "prefix") {
+                        proto.prefix = o.second;
+                    } else if (o.first == "rate") {
+                        double rate = atof(o.second.c_str());
+                        proto.intervalUs = rate > 0 ? 1e6 / rate : 0;
+                    } else if (o.first == "decimation") {
+                        proto.decimation = atoi(o.second.c_str());
+                    } else {
+                        return fail("unknown route option " + o.first);
+                    }
+                }
+
+                istringstream dss(dsts);
+                string dstName;
+                while (getline(dss, dstName, ',')) {
+                    Endpoint *dest = findEndpoint(dstName);
+                    if (!dest) return fail("unknown endpoint " + dstName);
+                    if (dest == src && proto.prefix == "")
+                        return fail("routing " + srcName + " onto itself needs a prefix");
+                    r.targets.push_back(proto);
+                    r.targets.back().dest = dest;
+                }
+
+                sourceFor(src)->routes.push_back(move(r));
+
+            } else {
+                return fail("unknown entry " + kind);
+            }
+        }
+
+        if (sources.empty()) {
+            cerr << "No routes in " << args.config << endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool init(int argc, char *argv[])
+    {
+        if (!args.parse(argc, argv))
+            return false;
+
+        if (!loadTable())
+            return false;
+
+        for (auto& ep : endpoints) {
+            ep.zcm = new zcm::ZCM(ep.url);
+            if (!ep.zcm->good()) {
+                cerr << "Couldn't initialize ZCM network for endpoint " << ep.name
+                     << "! Please check its transport url." << endl << endl;
+                return false;
+            }
+        }
+
+        assert(pluginDb == nullptr);
+        // Load plugins from path if specified
+        if (args.plugin_path != "") {
+            pluginDb = new TranscoderPluginDb(args.plugin_path, args.debug);
+            vector<const zcm::TranscoderPlugin*> dbPlugins = pluginDb->getPlugins();
+            if (dbPlugins.empty()) {
+                cerr << "Couldn't find any plugins. Aborting." << endl;
+                return false;
+            }
+            vector<string> dbPluginNames = pluginDb->getPluginNames();
+            for (size_t i = 0; i < dbPlugins.size(); ++i) {
+                plugins.push_back((zcm::TranscoderPlugin*) dbPlugins[i]);
+                if (args.debug) cout << "Loaded plugin: " << dbPluginNames[i] << endl;
+            }
+        }
+
+        return true;
+    }
+
+    static void handler(const zcm::ReceiveBuffer* rbuf, const string& channel, void* usr)
+    {
+        SourceInfo* info = (SourceInfo*)usr;
+
+        if (plugins.empty()) {
+            info->route(channel, rbuf->data, rbuf->data_size);
+            return;
+        }
+
+        vector<const zcm::LogEvent*> evts;
+
+        zcm::LogEvent le;
+        le.timestamp = rbuf->recv_utime;
+        le.channel   = channel;
+        le.datalen   = rbuf->data_size;
+        le.data      = rbuf->data;
+
+        int64_t msg_hash;
+        __int64_t_decode_array(le.data, 0, 8, &msg_hash, 1);
+
+        for (auto& p : plugins) {
+            vector<const zcm::LogEvent*> pevts =
+                p->transcodeEvent((uint64_t) msg_hash, &le);
+            evts.insert(evts.end(), pevts.begin(), pevts.end());
+        }
+
+        if (evts.empty()) evts.push_back(&le);
+
+        // Transcoded events are routed by their own channel
+        for (auto* evt : evts) {
+            if (!evt) continue;
+            info->route(evt->channel, evt->data, evt->datalen);
+        }
+    }
+
+    void run()
+    {
+        for (auto& si : sources)
+            si.src->zcm->subscribe(".*", &handler, &si);
+
+        for (auto& ep : endpoints) ep.start();
+        for (auto& ep : endpoints) ep.zcm->start();
+
+        while (!done) usleep(1e6);
+
+        for (auto& ep : endpoints) ep.zcm->stop();
+        for (auto& ep : endpoints) ep.stop();
+        for (auto& ep : endpoints) ep.zcm->flush();
+
+        if (args.debug) {
+            for (auto& ep : endpoints)
+                cout << ep.name << ": sent " << ep.nSent << ", dropped "
+                     << ep.nDropped << ", " << ep.queue.size() << " left in queue" << endl;
+        }
+    }
+};
+
+TranscoderPluginDb* Router::pluginDb = nullptr;
+vector<zcm::TranscoderPlugin*> Router::plugins = {};
+
+int main(int argc, char *argv[])
+{
+    Router router{};
+    if (!router.init(argc, argv)) return 1;
+
+    // Register signal handlers
+    signal(SIGINT, sighandler);
+    signal(SIGQUIT, sighandler);
+    signal(SIGTERM, sighandler);
+
+    router.run();
+
+    cerr << "Router exiting" << endl;
+
+    return 0;
+}
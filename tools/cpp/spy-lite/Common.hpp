@@ -3,6 +3,7 @@
 // ZCM Headers
 #include "zcm/zcm.h"
 #include "zcm/zcm_coretypes.h"
+#include "zcm/stats.h"
 #include "util/Types.hpp"
 #include "util/StringUtil.hpp"
 #include "util/TimeUtil.hpp"
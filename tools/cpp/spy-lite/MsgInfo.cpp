@@ -1,6 +1,7 @@
 #include "MsgInfo.hpp"
 #include "Debug.hpp"
 
+#include <cstring>
 #include <limits>
 
 MsgInfo::MsgInfo(TypeDb& db, const char *channel) : db(db), channel(channel) {}
@@ -33,6 +34,8 @@ void MsgInfo::decViewDepth()
 
 void MsgInfo::display()
 {
+    decodeLatest();
+
     const char *name = NULL;
     i64 hash = 0;
     if (metadata) {
@@ -71,34 +74,161 @@ void MsgInfo::ensureHash(i64 h)
     }
 }
 
-u64 MsgInfo::latestUtime()
+void MsgInfo::addMessage(u64 utime, const zcm_recv_buf_t *rbuf)
 {
-    return queue.last();
+    u64 n = num_msgs.load(std::memory_order_relaxed) + 1;
+
+    {
+        unique_lock<mutex> lk(raw_mut);
+        raw.assign(rbuf->data, rbuf->data + rbuf->data_size);
+        raw_num = n;
+    }
+
+    recordStats(utime, rbuf->data_size);
+
+    last_utime.store(utime, std::memory_order_relaxed);
+    num_msgs.store(n, std::memory_order_release);
 }
 
-u64 MsgInfo::oldestUtime()
+// Only the zcm thread writes these, so a load and a store is enough
+static inline void add(std::atomic<u64>& a, u64 v)
 {
-    return queue.first();
+    a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
 }
 
-void MsgInfo::removeOld()
+static inline void setMin(std::atomic<u64>& a, u64 v)
 {
-    u64 oldest_allowed = TimeUtil::utime() - QUEUE_PERIOD;
-    while (!queue.isEmpty() && queue.first() < oldest_allowed)
-        queue.dequeue();
+    if (v < a.load(std::memory_order_relaxed)) a.store(v, std::memory_order_relaxed);
 }
 
-void MsgInfo::addMessage(u64 utime, const zcm_recv_buf_t *rbuf)
+static inline void setMax(std::atomic<u64>& a, u64 v)
 {
-    if (queue.isFull())
-        queue.dequeue();
-    queue.enqueue(utime);
+    if (v > a.load(std::memory_order_relaxed)) a.store(v, std::memory_order_relaxed);
+}
 
-    num_msgs++;
+void MsgInfo::recordStats(u64 utime, u64 size)
+{
+    u64 sec = utime / SLOT_PERIOD;
+    Slot& slot = slots[sec % NUM_SLOTS];
+    if (slot.sec.load(std::memory_order_relaxed) != sec) {
+        slot.sec.store(SLOT_CLEARING, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (auto *a : { &slot.msgs, &slot.bytes, &slot.gaps, &slot.interval_sum,
+                         &slot.max_interval, &slot.max_size })
+            a->store(0, std::memory_order_relaxed);
+        slot.min_interval.store(UINT64_MAX, std::memory_order_relaxed);
+        slot.min_size.store(UINT64_MAX, std::memory_order_relaxed);
+        for (int b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b) {
+            slot.interval_hist[b].store(0, std::memory_order_relaxed);
+            slot.size_hist[b].store(0, std::memory_order_relaxed);
+        }
+        slot.sec.store(sec, std::memory_order_release);
+    }
+
+    add(slot.msgs, 1);
+    add(slot.bytes, size);
+    add(num_bytes, size);
+    add(slot.size_hist[zcm_stats_bucket(size)], 1);
+    setMin(slot.min_size, size);
+    setMax(slot.max_size, size);
+
+    u64 prev = last_utime.load(std::memory_order_relaxed);
+    if (prev == 0)
+        return;
+
+    u64 interval = (utime - prev) * 1000;
+    add(slot.interval_sum, interval);
+    add(slot.interval_hist[zcm_stats_bucket(interval)], 1);
+    setMin(slot.min_interval, interval);
+    setMax(slot.max_interval, interval);
+
+    // A gap is an interval much longer than the channel's usual period, counted as
+    // the number of messages that would have fit in it. This assumes the channel
+    // is published periodically, so it is only an estimate of the drops
+    static constexpr u64 GAP_WARMUP = 16;
+    static constexpr double GAP_FACTOR = 1.5;
+    if (num_msgs.load(std::memory_order_relaxed) > GAP_WARMUP && mean_interval > 0 &&
+        interval > GAP_FACTOR * mean_interval) {
+        u64 missed = (u64)(interval / mean_interval + 0.5) - 1;
+        add(slot.gaps, missed);
+        add(num_gaps, missed);
+        // Don't let a gap stretch the estimated period
+        interval = mean_interval;
+    }
+    if (mean_interval == 0)
+        mean_interval = interval;
+    else
+        mean_interval += ((double)interval - mean_interval) / GAP_WARMUP;
+}
+
+// Sums the slots of the seconds within the last HZ_PERIOD. A slot that the zcm
+// thread started clearing while it was being copied is skipped
+void MsgInfo::getStats(Stats& st)
+{
+    st = Stats();
+    memset(&st.intervals, 0, sizeof(st.intervals));
+    memset(&st.sizes, 0, sizeof(st.sizes));
+    st.min_interval = st.min_size = UINT64_MAX;
+
+    u64 nowSec = TimeUtil::monoUtime() / SLOT_PERIOD;
+    for (auto& slot : slots) {
+        u64 sec = slot.sec.load(std::memory_order_acquire);
+        if (sec == SLOT_CLEARING || sec + NUM_SLOTS <= nowSec)
+            continue;
+
+        Stats s;
+        s.msgs = slot.msgs.load(std::memory_order_relaxed);
+        s.bytes = slot.bytes.load(std::memory_order_relaxed);
+        s.gaps = slot.gaps.load(std::memory_order_relaxed);
+        s.intervals.sum_ns = slot.interval_sum.load(std::memory_order_relaxed);
+        s.min_interval = slot.min_interval.load(std::memory_order_relaxed);
+        s.max_interval = slot.max_interval.load(std::memory_order_relaxed);
+        s.min_size = slot.min_size.load(std::memory_order_relaxed);
+        s.max_size = slot.max_size.load(std::memory_order_relaxed);
+        for (int b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b) {
+            s.intervals.buckets[b] = slot.interval_hist[b].load(std::memory_order_relaxed);
+            s.sizes.buckets[b] = slot.size_hist[b].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sec.load(std::memory_order_relaxed) != sec)
+            continue;
+
+        st.msgs += s.msgs;
+        st.bytes += s.bytes;
+        st.gaps += s.gaps;
+        st.intervals.sum_ns += s.intervals.sum_ns;
+        st.sizes.sum_ns += s.bytes;
+        st.min_interval = std::min(st.min_interval, s.min_interval);
+        st.max_interval = std::max(st.max_interval, s.max_interval);
+        st.min_size = std::min(st.min_size, s.min_size);
+        st.max_size = std::max(st.max_size, s.max_size);
+        for (int b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b) {
+            st.intervals.count += s.intervals.buckets[b];
+            st.intervals.buckets[b] += s.intervals.buckets[b];
+            st.sizes.count += s.sizes.buckets[b];
+            st.sizes.buckets[b] += s.sizes.buckets[b];
+        }
+    }
+
+    if (st.intervals.count == 0) st.min_interval = 0;
+    if (st.msgs == 0) st.min_size = 0;
+}
+
+// Decodes the latest message, if it hasn't been already
+void MsgInfo::decodeLatest()
+{
+    {
+        unique_lock<mutex> lk(raw_mut);
+        if (raw_num == decoded_num)
+            return;
+        decode_buf.swap(raw);
+        decoded_num = raw_num;
+    }
 
     /* decode the data */
     i64 hash = 0;
-    __int64_t_decode_array(rbuf->data, 0, rbuf->data_size, &hash, 1);
+    __int64_t_decode_array(decode_buf.data(), 0, decode_buf.size(), &hash, 1);
     ensureHash(hash);
 
     if (metadata) {
@@ -111,25 +241,47 @@ void MsgInfo::addMessage(u64 utime, const zcm_recv_buf_t *rbuf)
         }
 
         // actually decode it
-        metadata->info->decode(rbuf->data, 0, rbuf->data_size, last_msg);
+        metadata->info->decode(decode_buf.data(), 0, decode_buf.size(), last_msg);
 
         DEBUG(1, "INFO: successful decode on %s\n", channel.c_str());
     }
 }
 
-float MsgInfo::getHertz()
+// The message and byte rates over the last HZ_PERIOD, from the arrival times of
+// the first and last messages received in it. The counters are sampled on every
+// call, so no per message history is needed. The oldest sample kept is the
+// newest one taken at least HZ_PERIOD ago, so callers that sample less often
+// than that still get a rate
+MsgInfo::Rates MsgInfo::getRates()
 {
-    removeOld();
-    if (queue.isEmpty())
-        return 0.0;
-
-    int sz = queue.getSize();
-    if (sz < 2) return 0.0;
-    u64 oldest = oldestUtime();
-    u64 latest = latestUtime();
-    u64 dt = latest - oldest;
-    if (dt == 0.0)
-        return std::numeric_limits<float>::infinity();
-
-    return (float) (sz - 1) / ((float) dt / 1000000.0);
+    Rates r;
+    Sample s;
+    s.num_msgs = getNumMsgs();
+    s.num_bytes = num_bytes.load(std::memory_order_relaxed);
+    s.last_utime = last_utime.load(std::memory_order_relaxed);
+    u64 now = s.taken_utime = TimeUtil::monoUtime();
+    if (s.num_msgs == 0)
+        return r;
+
+    samples.push_back(s);
+    while (samples.size() > 2 && samples[1].taken_utime + HZ_PERIOD <= now)
+        samples.pop_front();
+
+    if (now - s.last_utime > HZ_PERIOD)
+        return r;
+
+    const Sample& oldest = samples.front();
+    u64 n = s.num_msgs - oldest.num_msgs;
+    if (n == 0)
+        return r;
+    u64 dt = s.last_utime - oldest.last_utime;
+    if (dt == 0) {
+        r.hz = r.mbps = std::numeric_limits<float>::infinity();
+        return r;
+    }
+
+    float sec = (float) dt / 1000000.0;
+    r.hz = (float) n / sec;
+    r.mbps = (float) (s.num_bytes - oldest.num_bytes) / sec / 1e6;
+    return r;
 }
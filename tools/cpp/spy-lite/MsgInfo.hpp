@@ -1,21 +1,61 @@
 #pragma once
 #include "Common.hpp"
 #include "util/TypeDb.hpp"
-#include "ExpiringQueue.hpp"
 #include "MsgDisplay.hpp"
 
+#include <atomic>
+#include <deque>
+
+// addMessage() is called by the zcm thread for every message, and only counts it,
+// updates its arrival statistics and keeps a copy of its raw bytes. Everything
+// else is called by the display threads, which decode the latest message only
+// when it is shown
 class MsgInfo
 {
-    static constexpr size_t QUEUE_SIZE = 400;
-    static constexpr size_t QUEUE_PERIOD = 4*1000*1000;
+    static constexpr u64 HZ_PERIOD = 4*1000*1000;
+    static constexpr u64 SLOT_PERIOD = 1000*1000;
+    static constexpr size_t NUM_SLOTS = HZ_PERIOD / SLOT_PERIOD;
 
 public:
+    static constexpr u64 STATS_PERIOD = HZ_PERIOD;
+
+    struct Rates
+    {
+        float hz = 0;
+        float mbps = 0; // megabytes per second
+    };
+
+    // Arrival statistics over the last HZ_PERIOD. Intervals are in nanoseconds
+    // and sizes in bytes; the histograms use the buckets of zcm/stats.h
+    struct Stats
+    {
+        u64 msgs = 0;
+        u64 bytes = 0;
+        u64 gaps = 0;
+        u64 min_interval = 0, max_interval = 0;
+        u64 min_size = 0, max_size = 0;
+        zcm_stats_hist_t intervals;
+        zcm_stats_hist_t sizes;
+
+        // Percentiles are the lower bound of their bucket, clamped to the
+        // observed range
+        u64 intervalPercentile(double p) const
+        { return clamp(zcm_stats_percentile(&intervals, p), min_interval, max_interval); }
+        u64 sizePercentile(double p) const
+        { return clamp(zcm_stats_percentile(&sizes, p), min_size, max_size); }
+
+      private:
+        static u64 clamp(u64 v, u64 lo, u64 hi) { return v < lo ? lo : v > hi ? hi : v; }
+    };
+
     MsgInfo(TypeDb& db, const char *channel);
     ~MsgInfo();
 
     void addMessage(u64 utime, const zcm_recv_buf_t *rbuf);
-    float getHertz();
-    u64 getNumMsgs() { return num_msgs; }
+    Rates getRates();
+    void getStats(Stats& st);
+    u64 getNumMsgs() { return num_msgs.load(std::memory_order_acquire); }
+    u64 getNumGaps() { return num_gaps.load(std::memory_order_relaxed); }
 
     size_t getViewDepth();
     void incViewDepth(size_t viewid);
@@ -25,18 +65,58 @@ public:
 
 private:
     void ensureHash(i64 hash);
-    u64 latestUtime();
-    u64 oldestUtime();
-    void removeOld();
+    void decodeLatest();
+    void recordStats(u64 utime, u64 size);
 
 private:
     TypeDb& db;
     string channel;
 
-    ExpiringQueue<u64, QUEUE_SIZE> queue;
-    i64 hash = 0;
-    u64 num_msgs = 0;
+    // Written by the zcm thread only
+    std::atomic<u64> num_msgs {0};
+    std::atomic<u64> last_utime {0};
+    std::atomic<u64> num_bytes {0};
+    std::atomic<u64> num_gaps {0};
+
+    // One second of arrival statistics per slot, in a ring indexed by the second.
+    // The zcm thread clears a slot when it moves into a new second, setting 'sec'
+    // to SLOT_CLEARING meanwhile, so readers can tell a slot that was reused
+    // while they were copying it
+    static constexpr u64 SLOT_CLEARING = ~(u64)0;
+    struct Slot
+    {
+        std::atomic<u64> sec {SLOT_CLEARING};
+        std::atomic<u64> msgs, bytes, gaps;
+        std::atomic<u64> interval_sum;
+        std::atomic<u64> min_interval, max_interval;
+        std::atomic<u64> min_size, max_size;
+        std::atomic<u64> interval_hist[ZCM_STATS_HIST_BUCKETS];
+        std::atomic<u64> size_hist[ZCM_STATS_HIST_BUCKETS];
+    };
+    Slot slots[NUM_SLOTS];
+
+    // The zcm thread's running estimate of the channel's period, for gap detection
+    double mean_interval = 0;
 
+    // The latest message and its number. The display thread swaps it out, so
+    // the zcm thread never waits for more than that
+    mutex raw_mut;
+    vector<char> raw;
+    u64 raw_num = 0;
+
+    // Display threads only
+    struct Sample
+    {
+        u64 num_msgs;
+        u64 num_bytes;
+        u64 last_utime;
+        u64 taken_utime;
+    };
+    std::deque<Sample> samples;
+
+    vector<char> decode_buf;
+    u64 decoded_num = 0;
+    i64 hash = 0;
     void *last_msg = NULL;
     const TypeMetadata *metadata = NULL;
     MsgDisplayState disp_state;
@@ -1,5 +1,8 @@
+#include <cerrno>
+#include <cstring>
 #include <getopt.h>
 
+#include "zcm/json/json.h"
 #include "util/TypeDb.hpp"
 
 #include "Common.hpp"
@@ -14,7 +17,7 @@
 static volatile bool quit = false;
 
 enum class DisplayMode {
-    Overview, Decode,
+    Overview, Decode, Stats, Timing,
 };
 
 struct SpyInfo
@@ -45,18 +48,33 @@ struct SpyInfo
         return index < names.size();
     }
 
+    // Called on the zcm thread. Only a new channel takes 'mut', so the display
+    // never holds up message dispatch
     void addMessage(const char *channel, const zcm_recv_buf_t *rbuf)
     {
-        unique_lock<mutex> lk(mut);
-
-        MsgInfo *minfo = minfomap[channel];
-        if (minfo == NULL) {
+        // Only this thread uses 'channels', so it is searched without a lock
+        chanKey.assign(channel);
+        MsgInfo *minfo;
+        auto it = channels.find(chanKey);
+        if (it != channels.end()) {
+            minfo = it->second;
+        } else {
             minfo = new MsgInfo(typedb, channel);
+            channels[chanKey] = minfo;
+
+            unique_lock<mutex> lk(mut);
             names.push_back(channel);
             std::sort(begin(names), end(names));
             minfomap[channel] = minfo;
         }
-        minfo->addMessage(TimeUtil::utime(), rbuf);
+        minfo->addMessage(TimeUtil::monoUtime(), rbuf);
+
+        if (strcmp(channel, ZCM_STATS_CHANNEL) == 0) {
+            unique_lock<mutex> lk(mut);
+            stats.resize(ZCM_STATS_MAX_CHANNELS);
+            int n = zcm_stats_decode(rbuf->data, rbuf->data_size, stats.data(), stats.size());
+            stats.resize(n > 0 ? n : 0);
+        }
     }
 
     void display()
@@ -67,6 +85,12 @@ struct SpyInfo
             case DisplayMode::Overview: {
                 displayOverview();
             } break;
+            case DisplayMode::Stats: {
+                displayStats();
+            } break;
+            case DisplayMode::Timing: {
+                displayTiming();
+            } break;
             case DisplayMode::Decode: {
                 decode_msg_info->display();
 
@@ -84,8 +108,10 @@ struct SpyInfo
 
     void displayOverview()
     {
-        printf("         %-28s\t%12s\t%8s\n", "Channel", "Num Messages", "Hz (ave)");
-        printf("   ----------------------------------------------------------------\n");
+        printf("         %-28s\t%12s\t%8s\t%8s\t%8s\n",
+               "Channel", "Num Messages", "Hz (ave)", "MB/s", "Gaps");
+        printf("   ------------------------------------------------------------------"
+               "----------------------\n");
 
         DEBUG(5, "start-loop\n");
 
@@ -93,8 +119,10 @@ struct SpyInfo
             auto& channel = names[i];
             MsgInfo **minfo = lookup(minfomap, channel);
             assert(minfo != NULL);
-            float hz = (*minfo)->getHertz();
-            printf("   %3zu)  %-28s\t%9" PRIu64 "\t%7.2f\n", i, channel.c_str(), (*minfo)->getNumMsgs(), hz);
+            MsgInfo::Rates r = (*minfo)->getRates();
+            printf("   %3zu)  %-28s\t%9" PRIu64 "\t%7.2f\t%8.3f\t%8" PRIu64 "\n",
+                   i, channel.c_str(), (*minfo)->getNumMsgs(), r.hz, r.mbps,
+                   (*minfo)->getNumGaps());
         }
 
         printf("\n");
@@ -107,9 +135,163 @@ struct SpyInfo
         }
     }
 
+    // Shows the last message on ZCM_STATS_CHANNEL: the statistics of whichever
+    // process most recently published them
+    void displayStats()
+    {
+        static const char *histNames[ZCM_STATS_NUM_HISTS] = {
+            "pub->send", "send", "recv->disp", "callback"
+        };
+
+        printf("         Latencies from %s as p50/p99 in us (Esc to go back)\n\n",
+               ZCM_STATS_CHANNEL);
+        printf("   %-24s %9s %9s", "Channel", "Pub Msgs", "Recv Msgs");
+        for (auto name : histNames)
+            printf(" %15s", name);
+        printf("\n");
+        printf("   ----------------------------------------------------------------"
+               "----------------------------------------------\n");
+
+        for (auto& c : stats) {
+            printf("   %-24s %9" PRIu64 " %9" PRIu64, c.channel, c.pub_msgs, c.recv_msgs);
+            for (int h = 0; h < ZCM_STATS_NUM_HISTS; ++h) {
+                if (c.hists[h].count == 0) {
+                    printf(" %15s", "-");
+                    continue;
+                }
+                char buf[32];
+                snprintf(buf, sizeof(buf), "%.1f/%.1f",
+                         zcm_stats_percentile(&c.hists[h], 0.5) / 1e3,
+                         zcm_stats_percentile(&c.hists[h], 0.99) / 1e3);
+                printf(" %15s", buf);
+            }
+            printf("\n");
+        }
+        if (stats.empty())
+            printf("   No statistics received. Run with ZCM_STATS_PERIOD set on a zcm\n"
+                   "   configured with --use-stats to publish them\n");
+    }
+
+    // Shows the distribution of the interval between messages and of their sizes
+    // on each channel, over the same window as the rates
+    void displayTiming()
+    {
+        printf("         Arrival statistics over the last %" PRIu64 " seconds "
+               "(Esc to go back)\n\n", MsgInfo::STATS_PERIOD / 1000000);
+        printf("   %-28s %8s %6s %33s %20s\n", "", "", "",
+               "interval min/p50/p99/max (ms)", "size min/p50/max (B)");
+        printf("   %-28s %8s %6s\n", "Channel", "Msgs", "Gaps");
+        printf("   ------------------------------------------------------------------"
+               "----------------------------------\n");
+
+        MsgInfo::Stats st;
+        for (auto& channel : names) {
+            MsgInfo **minfo = lookup(minfomap, channel);
+            assert(minfo != NULL);
+            (*minfo)->getStats(st);
+            printf("   %-28s %8" PRIu64 " %6" PRIu64, channel.c_str(), st.msgs, st.gaps);
+            if (st.intervals.count == 0) {
+                printf(" %33s", "-");
+            } else {
+                char buf[64];
+                snprintf(buf, sizeof(buf), "%.2f/%.2f/%.2f/%.2f",
+                         st.min_interval / 1e6,
+                         st.intervalPercentile(0.5) / 1e6,
+                         st.intervalPercentile(0.99) / 1e6,
+                         st.max_interval / 1e6);
+                printf(" %33s", buf);
+            }
+            if (st.msgs == 0) {
+                printf(" %20s\n", "-");
+            } else {
+                char buf[64];
+                snprintf(buf, sizeof(buf), "%" PRIu64 "/%" PRIu64 "/%" PRIu64,
+                         st.min_size, st.sizePercentile(0.5), st.max_size);
+                printf(" %20s\n", buf);
+            }
+        }
+        printf("\n   Percentiles are approximate. Gaps assume a periodic channel\n");
+    }
+
+    // Writes the rates and arrival statistics of every channel as CSV rows or
+    // as one JSON object per call
+    void exportStats(FILE *f, bool json)
+    {
+        unique_lock<mutex> lk(mut);
+
+        u64 utime = TimeUtil::utime();
+        zcm::Json::Value root;
+        root["utime"] = (zcm::Json::UInt64) utime;
+        root["channels"] = zcm::Json::Value(zcm::Json::objectValue);
+
+        MsgInfo::Stats st;
+        for (auto& channel : names) {
+            MsgInfo *minfo = minfomap[channel];
+            MsgInfo::Rates r = minfo->getRates();
+            minfo->getStats(st);
+            u64 ivl[4] = {
+                st.min_interval / 1000,
+                st.intervalPercentile(0.5) / 1000,
+                st.intervalPercentile(0.99) / 1000,
+                st.max_interval / 1000,
+            };
+            u64 sz[3] = { st.min_size, st.sizePercentile(0.5), st.max_size };
+
+            if (!json) {
+                fprintf(f, "%" PRIu64 ",%s,%" PRIu64 ",%" PRIu64 ",%.3f,%.6f,"
+                        "%" PRIu64 ",%" PRIu64 ",%" PRIu64 ","
+                        "%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ","
+                        "%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+                        utime, channel.c_str(), minfo->getNumMsgs(), minfo->getNumGaps(),
+                        r.hz, r.mbps, st.msgs, st.bytes, st.gaps,
+                        ivl[0], ivl[1], ivl[2], ivl[3], sz[0], sz[1], sz[2]);
+                continue;
+            }
+
+            zcm::Json::Value& c = root["channels"][channel];
+            c["msgs"]            = (zcm::Json::UInt64) minfo->getNumMsgs();
+            c["gaps"]            = (zcm::Json::UInt64) minfo->getNumGaps();
+            c["hz"]              = r.hz;
+            c["mbps"]            = r.mbps;
+            c["window_msgs"]     = (zcm::Json::UInt64) st.msgs;
+            c["window_bytes"]    = (zcm::Json::UInt64) st.bytes;
+            c["window_gaps"]     = (zcm::Json::UInt64) st.gaps;
+            c["interval_min_us"] = (zcm::Json::UInt64) ivl[0];
+            c["interval_p50_us"] = (zcm::Json::UInt64) ivl[1];
+            c["interval_p99_us"] = (zcm::Json::UInt64) ivl[2];
+            c["interval_max_us"] = (zcm::Json::UInt64) ivl[3];
+            c["size_min"]        = (zcm::Json::UInt64) sz[0];
+            c["size_p50"]        = (zcm::Json::UInt64) sz[1];
+            c["size_max"]        = (zcm::Json::UInt64) sz[2];
+        }
+
+        if (json) {
+            zcm::Json::FastWriter w;
+            fputs(w.write(root).c_str(), f);
+        }
+        fflush(f);
+    }
+
+    static void exportHeader(FILE *f)
+    {
+        fprintf(f, "utime,channel,msgs,gaps,hz,mbps,window_msgs,window_bytes,window_gaps,"
+                   "interval_min_us,interval_p50_us,interval_p99_us,interval_max_us,"
+                   "size_min,size_p50,size_max\n");
+    }
+
+    void handleKeyboardStats(char ch)
+    {
+        if (ch == ESCAPE_KEY)
+            mode = DisplayMode::Overview;
+    }
+
     void handleKeyboardOverview(char ch)
     {
-        if (ch == '-') {
+        if (ch == 's' && !is_selecting) {
+            mode = DisplayMode::Stats;
+        } else if (ch == 't' && !is_selecting) {
+            mode = DisplayMode::Timing;
+        } else if (ch == '-') {
             is_selecting = true;
             decode_index = -1;
         } else if ('0' <= ch && ch <= '9') {
@@ -212,15 +394,24 @@ struct SpyInfo
         switch (mode) {
             case DisplayMode::Overview: handleKeyboardOverview(ch); break;
             case DisplayMode::Decode:   handleKeyboardDecode(ch);  break;
+            case DisplayMode::Stats:    handleKeyboardStats(ch);   break;
+            case DisplayMode::Timing:   handleKeyboardStats(ch);   break;
             default:
                 DEBUG(1, "INFO: unrecognized keyboard mode: %d\n", (int)mode);
         }
     }
 
 private:
+    // Guarded by 'mut'
     vector<string>                  names;
     unordered_map<string, MsgInfo*> minfomap;
+
+    // The same MsgInfos, for the zcm thread only
+    unordered_map<string, MsgInfo*> channels;
+    string                          chanKey;
+
     TypeDb typedb;
+    vector<zcm_channel_stats_t> stats;
 
     mutex mut;
 
@@ -338,29 +529,50 @@ struct Args
     const char *zcmurl = nullptr;
     const char *zcmtypes_path = nullptr;
     bool debug = false;
+    const char *export_path = nullptr;
+    bool json = false;
+    double interval = 1.0;
 
     bool parse(int argc, char *argv[])
     {
         // set some defaults
-        const char *optstring = "hu:p:d";
+        const char *optstring = "hu:p:de:f:i:";
         struct option long_opts[] = {
             { "help",            no_argument, 0, 'h' },
             { "zcm-url",   required_argument, 0, 'u' },
             { "type-path", required_argument, 0, 'p' },
             { "debug",           no_argument, 0, 'd' },
+            { "export",    required_argument, 0, 'e' },
+            { "format",    required_argument, 0, 'f' },
+            { "interval",  required_argument, 0, 'i' },
             { 0, 0, 0, 0 }
         };
 
+        string format = "csv";
         int c;
         while ((c = getopt_long (argc, argv, optstring, long_opts, 0)) >= 0) {
             switch (c) {
-                case 'u': zcmurl        = optarg; break;
-                case 'd': debug         = true;   break;
-                case 'p': zcmtypes_path = optarg; break;
+                case 'u': zcmurl        = optarg;       break;
+                case 'd': debug         = true;         break;
+                case 'p': zcmtypes_path = optarg;       break;
+                case 'e': export_path   = optarg;       break;
+                case 'f': format        = optarg;       break;
+                case 'i': interval      = atof(optarg); break;
                 case 'h': default: usage(); return false;
             };
         }
 
+        if (format != "csv" && format != "json") {
+            fprintf(stderr, "Unknown export format '%s', use csv or json\n", format.c_str());
+            return false;
+        }
+        json = format == "json";
+
+        if (interval <= 0) {
+            fprintf(stderr, "The export interval must be positive\n");
+            return false;
+        }
+
         return true;
     }
 
@@ -379,7 +591,18 @@ struct Args
                 "  -u, --zcm-url=URL          Log messages on the specified ZCM URL\n"
                 "  -p, --type-path=PATH       Path to a shared library containing the zcmtypes\n"
                 "  -d, --debug                Run a dry run to ensure proper spy setup\n"
-                "\n");
+                "  -e, --export=FILE          Don't show the terminal display, instead write\n"
+                "                             the statistics of every channel to FILE\n"
+                "                             (\"-\" for stdout) until interrupted. No type\n"
+                "                             path is needed in this mode\n"
+                "  -f, --format=FMT           Export format: csv (default) or json, one\n"
+                "                             object per line\n"
+                "  -i, --interval=SECONDS     Export interval (default: 1)\n"
+                "\n"
+                "Press 's' in the channel overview to show the latency statistics\n"
+                "published on the %s channel (see zcm/stats.h), and 't' to show the\n"
+                "interval and size distributions of the received messages\n"
+                "\n", ZCM_STATS_CHANNEL);
     }
 };
 
@@ -395,6 +618,8 @@ int main(int argc, char *argv[])
 
     // Get path to zcmtypes.so from args if defined; otherwise from $ZCM_SPY_LITE_PATH
     const char *spy_lite_path = args.zcmtypes_path ? args.zcmtypes_path : getenv("ZCM_SPY_LITE_PATH");
+    if (spy_lite_path == NULL && args.export_path)
+        spy_lite_path = "";
     if (debug)
         printf("zcm_spy_lite_path='%s'\n", spy_lite_path);
     if (spy_lite_path == NULL) {
@@ -411,6 +636,17 @@ int main(int argc, char *argv[])
     signal(SIGQUIT, sighandler);
     signal(SIGTERM, sighandler);
 
+    FILE *exportFile = NULL;
+    if (args.export_path) {
+        exportFile = strcmp(args.export_path, "-") == 0 ? stdout : fopen(args.export_path, "w");
+        if (!exportFile) {
+            fprintf(stderr, "Couldn't open %s: %s\n", args.export_path, strerror(errno));
+            return 1;
+        }
+        if (!args.json)
+            SpyInfo::exportHeader(exportFile);
+    }
+
     // configure stdout buffering: use FULL buffering to avoid flickering
     setvbuf(stdout, NULL, _IOFBF, 2048);
 
@@ -424,13 +660,27 @@ int main(int argc, char *argv[])
     zcm_subscribe(zcm, ".*", handler_all_zcm, &spy);
     zcm_start(zcm);
 
-    thread printThread {printThreadFunc, &spy};
+    if (exportFile) {
+        u64 periodUs = args.interval * 1e6;
+        u64 next = TimeUtil::monoUtime() + periodUs;
+        while (!quit) {
+            usleep(10000);
+            if (TimeUtil::monoUtime() < next) continue;
+            spy.exportStats(exportFile, args.json);
+            next += periodUs;
+        }
+        if (exportFile != stdout)
+            fclose(exportFile);
+    } else {
+        thread printThread {printThreadFunc, &spy};
+
+        // use this thread as the keyboard thread
+        keyboard_thread_func(&spy);
 
-    // use this thread as the keyboard thread
-    keyboard_thread_func(&spy);
+        printThread.join();
+    }
 
     // cleanup
-    printThread.join();
     zcm_stop(zcm);
     zcm_destroy(zcm);
 
@@ -0,0 +1,79 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <regex>
+#include <unordered_map>
+
+// Decides which channels pass, from exact channel names and channel regexes.
+// The rules are only evaluated the first time a channel is seen: the verdict is
+// cached, so every later lookup costs a single hash probe. Not thread safe.
+class ChannelFilter
+{
+  public:
+    enum class Verdict { PASS, DROP, UNSPECIFIED };
+
+    ChannelFilter(Verdict dflt = Verdict::PASS) : dflt(dflt) {}
+
+    // Exact names are checked first, then the regexes in the order they were added
+    void addChannel(const std::string& channel, Verdict v)
+    {
+        exact[channel] = v;
+        cache.clear();
+    }
+
+    // A regex must match the whole channel, as in zcm_subscribe().
+    // Throws std::regex_error if 're' is invalid
+    void addRegex(const std::string& re, Verdict v)
+    {
+        // Consecutive regexes with the same verdict are matched as one alternation
+        if (!regexes.empty() && regexes.back().verdict == v) {
+            regexes.back().pattern += "|(?:" + re + ")";
+        } else {
+            regexes.emplace_back();
+            regexes.back().pattern = "(?:" + re + ")";
+            regexes.back().verdict = v;
+        }
+        regexes.back().re = std::regex(regexes.back().pattern);
+        cache.clear();
+    }
+
+    // The verdict of channels that no rule matches
+    void setDefault(Verdict v)
+    {
+        dflt = v;
+        cache.clear();
+    }
+
+    Verdict verdict(const std::string& channel)
+    {
+        auto it = cache.find(channel);
+        if (it != cache.end()) return it->second;
+        Verdict v = evaluate(channel);
+        cache.emplace(channel, v);
+        return v;
+    }
+
+    bool passes(const std::string& channel) { return verdict(channel) == Verdict::PASS; }
+
+  private:
+    struct Regex
+    {
+        std::string pattern;
+        std::regex  re;
+        Verdict     verdict;
+    };
+
+    Verdict evaluate(const std::string& channel) const
+    {
+        auto it = exact.find(channel);
+        if (it != exact.end()) return it->second;
+        for (auto& r : regexes)
+            if (std::regex_match(channel, r.re)) return r.verdict;
+        return dflt;
+    }
+
+    Verdict dflt;
+    std::unordered_map<std::string, Verdict> exact;
+    std::vector<Regex> regexes;
+    std::unordered_map<std::string, Verdict> cache;
+};
@@ -1,13 +1,26 @@
 #pragma once
-#include <sys/time.h>
+#include <time.h>
 #include "util/Types.hpp"
 
+// Note: clock_gettime() on CLOCK_REALTIME and CLOCK_MONOTONIC is serviced by the vDSO
+//       on Linux, so none of these enter the kernel.
 namespace TimeUtil
 {
-    static u64 utime()
+    static inline u64 clockNs(clockid_t clk)
     {
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        return (u64)tv.tv_sec * 1000000 + tv.tv_usec;
+        struct timespec ts;
+        clock_gettime(clk, &ts);
+        return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
     }
+
+    // Wall clock time since the epoch. This is what message and log timestamps use,
+    // but it jumps when the system clock is stepped, so never use it to measure or
+    // pace intervals.
+    static inline u64 ntime() { return clockNs(CLOCK_REALTIME); }
+    static inline u64 utime() { return ntime() / 1000; }
+
+    // Time since an arbitrary point that only ever moves forward at a steady rate.
+    // Use this for timeouts, rates and playback pacing.
+    static inline u64 monoNtime() { return clockNs(CLOCK_MONOTONIC); }
+    static inline u64 monoUtime() { return monoNtime() / 1000; }
 }
@@ -0,0 +1,55 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Limits the bytes per second sent through it. The bucket holds at most one
+// second of budget. A message larger than that can still go out once the bucket
+// is full, leaving it in debt. Times are in microseconds of any monotonic clock.
+// Not thread safe.
+class TokenBucket
+{
+  public:
+    // A rate of 0 or less means unlimited
+    TokenBucket(double bytesPerSec = 0, uint64_t nowUs = 0) { reset(bytesPerSec, nowUs); }
+
+    // Sets the rate and starts over with a full bucket
+    void reset(double bytesPerSec, uint64_t nowUs)
+    {
+        rate = bytesPerSec;
+        tokens = bytesPerSec;
+        lastRefillUs = nowUs;
+    }
+
+    bool limited() const { return rate > 0; }
+
+    double bytesPerSec() const { return rate; }
+
+    void refill(uint64_t nowUs)
+    {
+        if (rate <= 0) return;
+        if (nowUs > lastRefillUs) tokens += (nowUs - lastRefillUs) / 1e6 * rate;
+        if (tokens > rate) tokens = rate;
+        lastRefillUs = nowUs;
+    }
+
+    // Whether 'len' bytes may go out now. Call refill() first
+    bool allows(size_t len) const
+    { return rate <= 0 || tokens >= len || tokens >= rate; }
+
+    // Microseconds until allows(len) becomes true, if nothing else is spent
+    uint64_t waitUs(size_t len) const
+    {
+        if (allows(len)) return 0;
+        double need = std::min((double)len, rate) - tokens;
+        return need / rate * 1e6 + 1;
+    }
+
+    // Charges 'len' bytes that were sent
+    void spend(size_t len) { if (rate > 0) tokens -= len; }
+
+  private:
+    double   rate = 0;
+    double   tokens = 0;
+    uint64_t lastRefillUs = 0;
+};
@@ -2,7 +2,9 @@
 #include "zcm/zcm_private.h"
 #include "zcm/blocking.h"
 #include "zcm/transport.h"
+#include "zcm/stats_private.h"
 #include "zcm/util/threadsafe_queue.hpp"
+#include "zcm/util/buffer_pool.hpp"
 #include "zcm/util/debug.h"
 
 #include "util/TimeUtil.hpp"
@@ -24,29 +26,68 @@ using namespace std;
 
 #define RECV_TIMEOUT 100
 
+// Copies a channel name into a buffer of ZCM_CHANNEL_MAXLEN+1 bytes
+static void copyChannel(char *dst, const char *channel)
+{
+    size_t len = strnlen(channel, ZCM_CHANNEL_MAXLEN);
+    memcpy(dst, channel, len);
+    dst[len] = '\0';
+}
+
 // A C++ class that manages a zcm_msg_t*
+// Note: the payload memory is borrowed from (and returned to) a BufferPool so
+//       that steady state message traffic does not allocate
 struct Msg
 {
     zcm_msg_t msg;
+    char channel[ZCM_CHANNEL_MAXLEN + 1];
+    BufferPool& pool;
+    size_t cap;
+    uint64_t queuedNs = 0; // when the message entered its queue, if USING_STATS
 
     // NOTE: copy the provided data into this object
-    Msg(uint64_t utime, const char *channel, size_t len, const char *buf)
+    Msg(BufferPool& pool, uint64_t utime, const char *channel, size_t len, const char *buf)
+        : pool(pool)
     {
         msg.utime = utime;
-        msg.channel = strdup(channel);
+        copyChannel(this->channel, channel);
+        msg.channel = this->channel;
         msg.len = len;
-        msg.buf = (char*)malloc(len);
+        msg.buf = pool.get(len, cap);
         memcpy(msg.buf, buf, len);
+        msg.pub_utime = 0;
+        msg.seqno = 0;
+#ifdef USING_STATS
+        queuedNs = zcm_stats_now();
+#endif
+    }
+
+    Msg(BufferPool& pool, zcm_msg_t *msg)
+        : Msg(pool, msg->utime, msg->channel, msg->len, msg->buf)
+    {
+        this->msg.pub_utime = msg->pub_utime;
+        this->msg.seqno = msg->seqno;
     }
 
-    Msg(zcm_msg_t *msg) : Msg(msg->utime, msg->channel, msg->len, msg->buf) {}
+    // NOTE: take ownership of 'buf', a buffer of capacity 'cap' that came from 'pool'
+    Msg(BufferPool& pool, uint64_t utime, const char *channel, size_t len, char *buf, size_t cap)
+        : pool(pool), cap(cap)
+    {
+        msg.utime = utime;
+        copyChannel(this->channel, channel);
+        msg.channel = this->channel;
+        msg.len = len;
+        msg.buf = buf;
+        msg.pub_utime = 0;
+        msg.seqno = 0;
+#ifdef USING_STATS
+        queuedNs = zcm_stats_now();
+#endif
+    }
 
     ~Msg()
     {
-        if (msg.channel)
-            free((void*)msg.channel);
-        if (msg.buf)
-            free((void*)msg.buf);
+        pool.put(msg.buf, cap);
         memset(&msg, 0, sizeof(msg));
     }
 
@@ -55,6 +96,15 @@ struct Msg
         return &msg;
     }
 
+    // Gives up ownership of the payload buffer, which came from 'pool'
+    char *release(size_t& cap)
+    {
+        char *buf = msg.buf;
+        cap = this->cap;
+        msg.buf = nullptr;
+        return buf;
+    }
+
   private:
     // Disable all copying and moving
     Msg(const Msg& other) = delete;
@@ -92,19 +142,29 @@ struct zcm_blocking
     void stop();
 
     int publish(const string& channel, const char *data, uint32_t len);
+    int publishReserve(const string& channel, uint32_t len, char **buf);
+    int publishCommit(void *buf);
+    int publishAbort(void *buf);
+    int forward(const string& channel, const zcm_recv_buf_t *rbuf);
     zcm_sub_t *subscribe(const string& channel, zcm_msg_handler_t cb, void *usr, bool block);
     int unsubscribe(zcm_sub_t *sub, bool block);
     int handle();
     void flush();
+    int getStats(zcm_channel_stats_t *out, int max);
 
 private:
+    void startSendThread();
     void sendThreadFunc();
     void recvThreadFunc();
     void handleThreadFunc();
 
-    void dispatchMsg(zcm_msg_t *msg);
+    void dispatchMsg(Msg *m, zcm_stats_channel_t *sc);
+    void invokeCallback(zcm_sub_t *sub, zcm_recv_buf_t *rbuf, const char *channel,
+                        zcm_stats_channel_t *sc);
     int handleOneMessage();
 
+    void statsThreadFunc();
+
     bool deleteSubEntry(zcm_sub_t *sub, size_t nentriesleft);
     bool deleteFromSubList(SubList& slist, zcm_sub_t *sub);
 
@@ -137,21 +197,67 @@ private:
     std::atomic<bool> handleRunning {false}; // operates on the recvQueue
 
     static constexpr size_t QUEUE_SIZE = 16;
+    // Note: each queue can hold at most QUEUE_SIZE-1 messages, plus one that is in flight
+    BufferPool sendPool {QUEUE_SIZE};
+    BufferPool recvPool {QUEUE_SIZE};
     ThreadsafeQueue<Msg> sendQueue {QUEUE_SIZE};
     ThreadsafeQueue<Msg> recvQueue {QUEUE_SIZE};
 
+    // Buffers handed out by publishReserve() that have not been committed yet
+    // Note: these are protected by pubmut
+    struct Reservation
+    {
+        char    *buf;
+        size_t   cap;
+        uint32_t len;
+        char     channel[ZCM_CHANNEL_MAXLEN + 1];
+    };
+    vector<Reservation> reservations;
+
     mutex pubmut;
     mutex submut;
+
+    // The message being dispatched, the subscriptions it matched, and whether the
+    // callback currently running is the last of them. Only used by the dispatch thread
+    Msg *dispatching = nullptr;
+    SubList dispatchSubs;
+    bool dispatchingLast = false;
+
+    // Note: stats stays null unless zcm is built with USING_STATS
+    zcm_stats_t *stats = nullptr;
+    thread statsThread;
+    mutex statsmut;
+    condition_variable statsCond;
+    bool statsRunning = false;
 };
 
-zcm_blocking_t::zcm_blocking(zcm_t *z, zcm_trans_t *zt_)
+zcm_blocking_t::zcm_blocking(zcm_t *z_, zcm_trans_t *zt_)
 {
+    z = z_;
     zt = zt_;
     mtu = zcm_trans_get_mtu(zt);
+
+#ifdef USING_STATS
+    stats = zcm_stats_create(mtu);
+    if (zcm_stats_period(stats) > 0) {
+        statsRunning = true;
+        statsThread = thread{&zcm_blocking::statsThreadFunc, this};
+    }
+#endif
 }
 
 zcm_blocking_t::~zcm_blocking()
 {
+    // Shutdown the stats publisher first, since it publishes through the send thread
+    if (statsThread.joinable()) {
+        {
+            unique_lock<mutex> lk(statsmut);
+            statsRunning = false;
+        }
+        statsCond.notify_all();
+        statsThread.join();
+    }
+
     // Shutdown all threads
     stop();
 
@@ -168,6 +274,12 @@ zcm_blocking_t::~zcm_blocking()
         delete (regex *) sub->regexobj;
         delete sub;
     }
+
+    // Reclaim any buffers that the user never committed
+    for (auto& r : reservations)
+        sendPool.put(r.buf, r.cap);
+
+    if (stats) zcm_stats_destroy(stats);
 }
 
 void zcm_blocking_t::run()
@@ -243,11 +355,7 @@ int zcm_blocking_t::publish(const string& channel, const char *data, uint32_t le
 
     unique_lock<mutex> lk(pubmut);
 
-    // If needed: spawn the send thread
-    if (!sendRunning) {
-        sendRunning = true;
-        sendThread = thread{&zcm_blocking::sendThreadFunc, this};
-    }
+    startSendThread();
 
     // TODO: publish should allow dropping of old messages
     if (!sendQueue.hasFreeSpace()) {
@@ -256,8 +364,131 @@ int zcm_blocking_t::publish(const string& channel, const char *data, uint32_t le
     }
 
     // Note: push only fails if it was forcefully woken up, which means zcm is shutting down
-    bool success = sendQueue.push(TimeUtil::utime(), channel.c_str(), len, data);
-    return success ? ZCM_EOK : ZCM_EINTR;
+    bool success = sendQueue.push(sendPool, TimeUtil::utime(), channel.c_str(), len, data);
+    if (!success) return ZCM_EINTR;
+#ifdef USING_STATS
+    zcm_stats_count_publish(zcm_stats_lookup(stats, channel.c_str()), len);
+#endif
+    return ZCM_EOK;
+}
+
+// Note: the reserved buffer comes from the same pool as the sendQueue entries, so
+// on commit it is handed to the send thread as-is, without another copy
+int zcm_blocking_t::publishReserve(const string& channel, uint32_t len, char **buf)
+{
+    // Check the validity of the request
+    if (len > mtu) return ZCM_EINVALID;
+    if (channel.size() > ZCM_CHANNEL_MAXLEN) return ZCM_EINVALID;
+
+    Reservation r;
+    r.buf = sendPool.get(len, r.cap);
+    r.len = len;
+    copyChannel(r.channel, channel.c_str());
+
+    unique_lock<mutex> lk(pubmut);
+    reservations.push_back(r);
+
+    *buf = r.buf;
+    return ZCM_EOK;
+}
+
+int zcm_blocking_t::publishCommit(void *buf)
+{
+    unique_lock<mutex> lk(pubmut);
+
+    size_t i = 0;
+    while (i < reservations.size() && reservations[i].buf != buf) ++i;
+    if (i == reservations.size()) {
+        ZCM_DEBUG("publishCommit() called with a buffer that was not reserved");
+        return ZCM_EINVALID;
+    }
+
+    startSendThread();
+
+    // Note: the reservation is kept so that the user can retry the commit
+    if (!sendQueue.hasFreeSpace()) {
+        ZCM_DEBUG("sendQueue has no free space");
+        return ZCM_EAGAIN;
+    }
+
+    Reservation r = reservations[i];
+    reservations[i] = reservations.back();
+    reservations.pop_back();
+
+    // Note: push only fails if it was forcefully woken up, which means zcm is shutting down
+    bool success = sendQueue.push(sendPool, TimeUtil::utime(), r.channel, r.len, r.buf, r.cap);
+    if (!success) {
+        sendPool.put(r.buf, r.cap);
+        return ZCM_EINTR;
+    }
+#ifdef USING_STATS
+    zcm_stats_count_publish(zcm_stats_lookup(stats, r.channel), r.len);
+#endif
+    return ZCM_EOK;
+}
+
+int zcm_blocking_t::publishAbort(void *buf)
+{
+    unique_lock<mutex> lk(pubmut);
+
+    for (size_t i = 0; i < reservations.size(); ++i) {
+        if (reservations[i].buf == buf) {
+            sendPool.put(reservations[i].buf, reservations[i].cap);
+            reservations[i] = reservations.back();
+            reservations.pop_back();
+            return ZCM_EOK;
+        }
+    }
+
+    ZCM_DEBUG("publishAbort() called with a buffer that was not reserved");
+    return ZCM_EINVALID;
+}
+
+// Note: a received message can only be handed over by the last callback it is
+// dispatched to, since earlier callbacks would leave later ones without the data.
+// The receive pool gets a spare buffer from our send pool in exchange, so both
+// stay stocked when forwarding in steady state.
+int zcm_blocking_t::forward(const string& channel, const zcm_recv_buf_t *rbuf)
+{
+    zcm_blocking *src = nullptr;
+    if (rbuf->zcm && rbuf->zcm->type == ZCM_BLOCKING)
+        src = (zcm_blocking*)rbuf->zcm->impl;
+    if (!src || !src->dispatchingLast || !src->dispatching ||
+        src->dispatching->get()->buf != rbuf->data)
+        return publish(channel, rbuf->data, rbuf->data_size);
+
+    // Check the validity of the request
+    if (rbuf->data_size > mtu) return ZCM_EINVALID;
+    if (channel.size() > ZCM_CHANNEL_MAXLEN) return ZCM_EINVALID;
+
+    unique_lock<mutex> lk(pubmut);
+
+    startSendThread();
+
+    if (!sendQueue.hasFreeSpace()) {
+        ZCM_DEBUG("sendQueue has no free space");
+        return ZCM_EAGAIN;
+    }
+
+    size_t cap;
+    char *buf = src->dispatching->release(cap);
+    src->dispatchingLast = false;
+
+    size_t spareCap;
+    char *spare = sendPool.take(spareCap);
+    if (spare) src->recvPool.put(spare, spareCap);
+
+    // Note: push only fails if it was forcefully woken up, which means zcm is shutting down
+    bool success = sendQueue.push(sendPool, TimeUtil::utime(), channel.c_str(),
+                                  (size_t)rbuf->data_size, buf, cap);
+    if (!success) {
+        sendPool.put(buf, cap);
+        return ZCM_EINTR;
+    }
+#ifdef USING_STATS
+    zcm_stats_count_publish(zcm_stats_lookup(stats, channel.c_str()), rbuf->data_size);
+#endif
+    return ZCM_EOK;
 }
 
 // Note: We use a lock on subscribe() to make sure it can be
@@ -361,6 +592,16 @@ void zcm_blocking_t::flush()
     sendQueue.waitForEmpty();
 }
 
+// Note: must be called with pubmut held
+void zcm_blocking_t::startSendThread()
+{
+    // If needed: spawn the send thread
+    if (!sendRunning) {
+        sendRunning = true;
+        sendThread = thread{&zcm_blocking::sendThreadFunc, this};
+    }
+}
+
 void zcm_blocking_t::sendThreadFunc()
 {
     while (sendRunning) {
@@ -371,7 +612,15 @@ void zcm_blocking_t::sendThreadFunc()
             continue;
 
         zcm_msg_t *msg = m->get();
+#ifdef USING_STATS
+        zcm_stats_channel_t *sc = zcm_stats_lookup(stats, msg->channel);
+        uint64_t start = zcm_stats_now();
+        zcm_stats_record(sc, ZCM_STATS_PUBLISH_TO_SEND, start - m->queuedNs);
+#endif
         int ret = zcm_trans_sendmsg(zt, *msg);
+#ifdef USING_STATS
+        zcm_stats_record(sc, ZCM_STATS_SEND, zcm_stats_now() - start);
+#endif
         if (ret != ZCM_EOK)
             ZCM_DEBUG("zcm_trans_sendmsg() failed to return EOK.. dropping the msg!");
         sendQueue.pop();
@@ -382,6 +631,8 @@ void zcm_blocking_t::recvThreadFunc()
 {
     while (recvRunning) {
         zcm_msg_t msg;
+        msg.pub_utime = 0;
+        msg.seqno = 0;
         int rc = zcm_trans_recvmsg(zt, &msg, RECV_TIMEOUT);
         if (rc == ZCM_EOK) {
             bool success;
@@ -390,7 +641,7 @@ void zcm_blocking_t::recvThreadFunc()
                 //       need to re-check the running condition; however, if we are still
                 //       running, we want to still push the same message, necessitating the
                 //       addition conditional on running.
-                success = recvQueue.push(&msg);
+                success = recvQueue.push(recvPool, &msg);
             } while(!success && recvRunning);
         }
     }
@@ -412,13 +663,28 @@ void zcm_blocking_t::handleThreadFunc()
     recvThread.join();
 }
 
-void zcm_blocking_t::dispatchMsg(zcm_msg_t *msg)
+void zcm_blocking_t::invokeCallback(zcm_sub_t *sub, zcm_recv_buf_t *rbuf,
+                                    const char *channel, zcm_stats_channel_t *sc)
 {
+#ifdef USING_STATS
+    uint64_t start = zcm_stats_now();
+    sub->callback(rbuf, channel, sub->usr);
+    zcm_stats_record(sc, ZCM_STATS_CALLBACK, zcm_stats_now() - start);
+#else
+    sub->callback(rbuf, channel, sub->usr);
+#endif
+}
+
+void zcm_blocking_t::dispatchMsg(Msg *m, zcm_stats_channel_t *sc)
+{
+    zcm_msg_t *msg = m->get();
     zcm_recv_buf_t rbuf;
     rbuf.recv_utime = msg->utime;
     rbuf.zcm = z;
     rbuf.data = (char*)msg->buf;
     rbuf.data_size = msg->len;
+    rbuf.pub_utime = msg->pub_utime;
+    rbuf.seqno = msg->seqno;
 
     // Note: We use a lock on dispatch to ensure there is not
     // a race on modifying and reading the 'subs' container.
@@ -427,21 +693,29 @@ void zcm_blocking_t::dispatchMsg(zcm_msg_t *msg)
     {
         unique_lock<mutex> lk(submut);
 
+        // Note: the matching subscriptions are gathered first so that we know which
+        //       callback is the last one (see forward())
+        dispatchSubs.clear();
+
         // dispatch to a non regex channel
         auto it = subs.find(msg->channel);
-        if (it != subs.end()) {
-            for (zcm_sub_t *sub : it->second) {
-                sub->callback(&rbuf, msg->channel, sub->usr);
-            }
-        }
+        if (it != subs.end())
+            dispatchSubs.insert(dispatchSubs.end(), it->second.begin(), it->second.end());
 
         // dispatch to any regex channels
         for (zcm_sub_t *sub : subRegex) {
             regex *r = (regex *)sub->regexobj;
-            if (regex_match(msg->channel, *r)) {
-                sub->callback(&rbuf, msg->channel, sub->usr);
-            }
+            if (regex_match(msg->channel, *r))
+                dispatchSubs.push_back(sub);
+        }
+
+        dispatching = m;
+        for (size_t i = 0; i < dispatchSubs.size(); ++i) {
+            dispatchingLast = i + 1 == dispatchSubs.size();
+            invokeCallback(dispatchSubs[i], &rbuf, msg->channel, sc);
         }
+        dispatching = nullptr;
+        dispatchingLast = false;
     }
 }
 
@@ -453,11 +727,39 @@ int zcm_blocking_t::handleOneMessage()
     if (m == nullptr)
         return -1;
 
-    dispatchMsg(m->get());
+    zcm_stats_channel_t *sc = nullptr;
+#ifdef USING_STATS
+    sc = zcm_stats_lookup(stats, m->get()->channel);
+    zcm_stats_count_recv(sc, m->get()->len);
+    zcm_stats_record(sc, ZCM_STATS_RECV_TO_DISPATCH, zcm_stats_now() - m->queuedNs);
+#endif
+
+    dispatchMsg(m, sc);
     recvQueue.pop();
     return 0;
 }
 
+// Periodically publishes the statistics on ZCM_STATS_CHANNEL
+void zcm_blocking_t::statsThreadFunc()
+{
+    auto period = chrono::duration<double>(zcm_stats_period(stats));
+    unique_lock<mutex> lk(statsmut);
+    while (statsRunning) {
+        statsCond.wait_for(lk, period);
+        if (!statsRunning) break;
+
+        const char *buf;
+        int len = zcm_stats_poll_publish(stats, &buf);
+        if (len > 0 && publish(ZCM_STATS_CHANNEL, buf, len) != ZCM_EOK)
+            ZCM_DEBUG("failed to publish the zcm statistics");
+    }
+}
+
+int zcm_blocking_t::getStats(zcm_channel_stats_t *out, int max)
+{
+    return stats ? zcm_stats_get(stats, out, max) : -1;
+}
+
 bool zcm_blocking_t::deleteSubEntry(zcm_sub_t *sub, size_t nentriesleft)
 {
     int rc = ZCM_EOK;
@@ -506,6 +808,27 @@ int zcm_blocking_publish(zcm_blocking_t *zcm, const char *channel, const char *d
     return zcm->publish(channel, data, len);
 }
 
+int zcm_blocking_publish_reserve(zcm_blocking_t *zcm, const char *channel,
+                                 uint32_t len, char **buf)
+{
+    return zcm->publishReserve(channel, len, buf);
+}
+
+int zcm_blocking_publish_commit(zcm_blocking_t *zcm, void *buf)
+{
+    return zcm->publishCommit(buf);
+}
+
+int zcm_blocking_publish_abort(zcm_blocking_t *zcm, void *buf)
+{
+    return zcm->publishAbort(buf);
+}
+
+int zcm_blocking_forward(zcm_blocking_t *zcm, const char *channel, const zcm_recv_buf_t *rbuf)
+{
+    return zcm->forward(channel, rbuf);
+}
+
 zcm_sub_t *zcm_blocking_subscribe(zcm_blocking_t *zcm, const char *channel,
                                   zcm_msg_handler_t cb, void *usr)
 {
@@ -553,4 +876,9 @@ int zcm_blocking_handle(zcm_blocking_t *zcm)
     return zcm->handle();
 }
 
+int zcm_blocking_get_stats(zcm_blocking_t *zcm, zcm_channel_stats_t *stats, int max)
+{
+    return zcm->getStats(stats, max);
+}
+
 }
@@ -3,6 +3,7 @@
 
 #include "zcm/zcm.h"
 #include "zcm/transport.h"
+#include "zcm/stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,6 +15,12 @@ void            zcm_blocking_destroy(zcm_blocking_t *zcm);
 
 int        zcm_blocking_publish(zcm_blocking_t *zcm, const char *channel, const char *data,
                                 uint32_t len);
+int        zcm_blocking_publish_reserve(zcm_blocking_t *zcm, const char *channel,
+                                        uint32_t len, char **buf);
+int        zcm_blocking_publish_commit(zcm_blocking_t *zcm, void *buf);
+int        zcm_blocking_publish_abort(zcm_blocking_t *zcm, void *buf);
+int        zcm_blocking_forward(zcm_blocking_t *zcm, const char *channel,
+                                const zcm_recv_buf_t *rbuf);
 
 zcm_sub_t *zcm_blocking_subscribe(zcm_blocking_t *zcm, const char *channel,
                                   zcm_msg_handler_t cb, void *usr);
@@ -30,6 +37,8 @@ void   zcm_blocking_start(zcm_blocking_t *zcm);
 void   zcm_blocking_stop(zcm_blocking_t *zcm);
 int    zcm_blocking_handle(zcm_blocking_t *zcm);
 
+int    zcm_blocking_get_stats(zcm_blocking_t *zcm, zcm_channel_stats_t *stats, int max);
+
 #ifdef __cplusplus
 }
 #endif
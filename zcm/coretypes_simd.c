@@ -0,0 +1,91 @@
+#include <stdint.h>
+
+/* The SIMD byte reversal kernels behind zcm_coretypes.h when it is compiled with
+   ZCM_SIMD. They live here so that the intrinsics headers stay out of the public
+   header, which is also used from C and embedded code */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ZCM_SIMD_X86
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ZCM_SIMD_NEON
+#endif
+
+int __zcm_swap_simd(uint8_t *dst, const uint8_t *src, int nbytes, int width);
+
+#ifdef ZCM_SIMD_X86
+enum { SIMD_UNKNOWN = 0, SIMD_NONE, SIMD_SSSE3, SIMD_AVX2 };
+
+__attribute__((target("ssse3")))
+static int swap_ssse3(uint8_t *dst, const uint8_t *src, int nbytes, const uint8_t *shuf)
+{
+    int i = 0;
+    __m128i mask = _mm_loadu_si128((const __m128i*) shuf);
+    for (; i + 16 <= nbytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + i));
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int swap_avx2(uint8_t *dst, const uint8_t *src, int nbytes, const uint8_t *shuf)
+{
+    int i = 0;
+    /* Note: vpshufb shuffles within each 128 bit lane, so the same mask is used for both */
+    __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) shuf));
+    for (; i + 32 <= nbytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + i));
+        _mm256_storeu_si256((__m256i*) (dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+/* The cpu doesn't change under us, so it is only asked once. Racing first callers
+   all store the same answer */
+static int simdLevel(void)
+{
+    static int level = SIMD_UNKNOWN;
+    int l = __atomic_load_n(&level, __ATOMIC_RELAXED);
+    if (l == SIMD_UNKNOWN) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))       l = SIMD_AVX2;
+        else if (__builtin_cpu_supports("ssse3")) l = SIMD_SSSE3;
+        else                                      l = SIMD_NONE;
+        __atomic_store_n(&level, l, __ATOMIC_RELAXED);
+    }
+    return l;
+}
+#endif
+
+/* Reverses the bytes of as many whole vectors of 'width' byte elements as possible.
+   Returns the number of bytes processed (possibly 0) */
+int __zcm_swap_simd(uint8_t *dst, const uint8_t *src, int nbytes, int width)
+{
+#if defined(ZCM_SIMD_X86)
+    static const uint8_t shuf[3][16] = {
+        { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+        { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+        { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+    };
+    const uint8_t *mask = shuf[width == 2 ? 0 : width == 4 ? 1 : 2];
+    switch (simdLevel()) {
+        case SIMD_AVX2:  return swap_avx2(dst, src, nbytes, mask);
+        case SIMD_SSSE3: return swap_ssse3(dst, src, nbytes, mask);
+        default:         return 0;
+    }
+#elif defined(ZCM_SIMD_NEON)
+    int i = 0;
+    for (; i + 16 <= nbytes; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        if (width == 2)      v = vrev16q_u8(v);
+        else if (width == 4) v = vrev32q_u8(v);
+        else                 v = vrev64q_u8(v);
+        vst1q_u8(dst + i, v);
+    }
+    return i;
+#else
+    (void)dst; (void)src; (void)nbytes; (void)width;
+    return 0;
+#endif
+}
@@ -19,6 +19,8 @@ var recvBuf = StructType({
     zcm:   voidRef,
     data:  charRef,
     len:   ref.types.uint32,
+    pubUtime: ref.types.int64,
+    seqno: ref.types.uint32,
 });
 var recvBufRef = ref.refType(recvBuf);
 
@@ -5,6 +5,9 @@
 #include <cstdint>
 #include <string>
 #include <deque>
+#include <vector>
+#include <memory>
+#include <iterator>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -15,6 +18,8 @@
 #include <stdarg.h>
 #include <functional>
 #include <tuple>
+#include <array>
+#include <queue>
 #include <type_traits>
 
 #include <zcm/zcm-cpp.hpp>
@@ -47,15 +52,58 @@ class Tracker
   protected:
     virtual uint64_t getMsgUtime(const T* msg) const { return UINT64_MAX; }
 
-    // The returned value must be "new" in all cases
+    // The returned value must be "new" in all cases.
+    // By default, types generated with `zcm-gen --cpp-lerp` are interpolated with
+    // their T::lerp(). Other types return whichever message is nearest utimeTarget
     virtual T* interpolate(uint64_t utimeTarget,
                            const T* A, uint64_t utimeA,
                            const T* B, uint64_t utimeB) const
     {
-        return utimeTarget - utimeA < utimeB - utimeTarget ? new T(*A) : new T(*B);
+        if (!hasLerp<T>::present)
+            return utimeTarget - utimeA < utimeB - utimeTarget ? new T(*A) : new T(*B);
+        T* ret = new T();
+        interpolateInto(utimeTarget, A, utimeA, B, utimeB, *ret);
+        return ret;
+    }
+
+    // Same as interpolate(), but writes into an existing message instead of
+    // allocating one. This is what get(utime, out) uses, so types that override
+    // interpolate() should override this as well
+    virtual void interpolateInto(uint64_t utimeTarget,
+                                 const T* A, uint64_t utimeA,
+                                 const T* B, uint64_t utimeB, T& out) const
+    {
+        lerpOrNearest(utimeTarget, A, utimeA, B, utimeB, out,
+                      std::integral_constant<bool, hasLerp<T>::present>());
     }
 
   private:
+    // True if T has the static lerp() emitted by `zcm-gen --cpp-lerp`
+    template <typename F> struct hasLerp {
+        typedef void (*LerpFn)(const F&, const F&, double, F&);
+
+        template<typename C> static char (&f(typename std::enable_if<
+            std::is_same<decltype(&C::lerp), LerpFn>::value>::type*))[1];
+        template<typename C> static char (&f(...))[2];
+
+        static constexpr bool present = sizeof(f<F>(0)) == 1;
+    };
+
+    void lerpOrNearest(uint64_t utimeTarget,
+                       const T* A, uint64_t utimeA,
+                       const T* B, uint64_t utimeB, T& out, std::true_type) const
+    {
+        double alpha = (double)(utimeTarget - utimeA) / (double)(utimeB - utimeA);
+        T::lerp(*A, *B, alpha, out);
+    }
+
+    void lerpOrNearest(uint64_t utimeTarget,
+                       const T* A, uint64_t utimeA,
+                       const T* B, uint64_t utimeB, T& out, std::false_type) const
+    {
+        out = utimeTarget - utimeA < utimeB - utimeTarget ? *A : *B;
+    }
+
     // *****************************************************************************
     // Insanely hacky trick to determine at compile time if a zcmtype has a
     // field called "utime"
@@ -84,6 +132,8 @@ class Tracker
         MsgWithUtime(const F& msg, uint64_t utime) : F(msg) {}
         MsgWithUtime(const MsgWithUtime& msg) : F(msg) {}
         virtual ~MsgWithUtime() {}
+        // Reuses this message's memory (eg vector capacities) for a new message
+        void set(const F& msg, uint64_t utime) { F::operator=(msg); }
     };
 
     template<typename F>
@@ -92,10 +142,19 @@ class Tracker
         MsgWithUtime(const F& msg, uint64_t utime) : F(msg), utime(utime) {}
         MsgWithUtime(const MsgWithUtime& msg) : F(msg), utime(msg.utime) {}
         virtual ~MsgWithUtime() {}
+        // Reuses this message's memory (eg vector capacities) for a new message
+        void set(const F& msg, uint64_t utime) { F::operator=(msg); this->utime = utime; }
     };
 
     typedef MsgWithUtime<T, hasUtime<T>::present> MsgType;
 
+  public:
+    // Kept for code that collects messages for the range based get(). Messages are
+    // no longer stored in one of these, so begin() and end() are RingIterators
+    // rather than ContainerType iterators
+    typedef std::deque<MsgType*> ContainerType;
+
+  private:
     // *****************************************************************************
 
     uint64_t maxTimeErr_us;
@@ -103,17 +162,33 @@ class Tracker
     // This is only to be used for the callback thread func
     bool done = false;
 
-  public:
-    typedef std::deque<MsgType*> ContainerType;
+    // Messages are refcounted so that readers can take a reference to a message
+    // while holding bufLock only for as long as it takes to find it. All copying
+    // and interpolating then happens outside of the lock, so readers never hold up
+    // the receive thread. A message that drops out of the buffer while no reader
+    // holds it is recycled for a future message.
+    struct Entry
+    {
+        uint64_t utime;
+        std::shared_ptr<MsgType> msg;
+    };
+
+    // Fixed capacity ring of the tracked messages, kept sorted by utime.
+    // The oldest message lives at index 'head'
+    std::vector<Entry> ring;
+    size_t head = 0;
+    size_t count = 0;
+    std::vector<std::shared_ptr<MsgType>> freeMsgs;
+    static constexpr size_t maxFreeMsgs = 4;
 
-  private:
-    ContainerType buf;
     uint64_t lastHostUtime = UINT64_MAX;
+    // utime of the most recently received message, which needn't be the greatest
+    uint64_t lastMsgUtime = UINT64_MAX;
     size_t bufMax;
-    typedef std::recursive_mutex BufLockType;
+    typedef std::mutex BufLockType;
     mutable BufLockType bufLock;
 
-    BufLockType callbackLock;
+    std::recursive_mutex callbackLock;
     std::condition_variable_any callbackCv;
     MsgType* callbackMsg = nullptr;
     std::thread *thr = nullptr;
@@ -125,7 +200,7 @@ class Tracker
 
     void callbackThreadFunc()
     {
-        std::unique_lock<BufLockType> lk(callbackLock);
+        std::unique_lock<std::recursive_mutex> lk(callbackLock);
         while (!done) {
             callbackCv.wait(lk, [&](){ return callbackMsg || done; });
             if (done) return;
@@ -136,28 +211,200 @@ class Tracker
         }
     }
 
+    // All of the below require bufLock to be held (or the tracker to not be shared)
+    inline Entry& entryAt(size_t i) { return ring[(head + i) % bufMax]; }
+    inline const Entry& entryAt(size_t i) const { return ring[(head + i) % bufMax]; }
+
+    // Index of the first message with a utime greater than 'utime'
+    size_t upperBound(uint64_t utime) const
+    {
+        size_t lo = 0, hi = count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (entryAt(mid).utime <= utime) lo = mid + 1;
+            else                             hi = mid;
+        }
+        return lo;
+    }
+
+    // Index of the first message with a utime no less than 'utime'
+    size_t lowerBound(uint64_t utime) const
+    {
+        size_t lo = 0, hi = count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (entryAt(mid).utime < utime) lo = mid + 1;
+            else                            hi = mid;
+        }
+        return lo;
+    }
+
+    void recycle(std::shared_ptr<MsgType>& msg)
+    {
+        if (msg.use_count() == 1 && freeMsgs.size() < maxFreeMsgs) {
+            // The last reader may have let go of the message on another thread.
+            // Pairs with the release done by that reader's decrement
+            std::atomic_thread_fence(std::memory_order_acquire);
+            freeMsgs.push_back(std::move(msg));
+        }
+        msg.reset();
+    }
+
+    void eraseAt(size_t idx)
+    {
+        recycle(entryAt(idx).msg);
+        for (size_t i = idx; i + 1 < count; ++i)
+            std::swap(entryAt(i), entryAt(i + 1));
+        --count;
+    }
+
+    void insert(uint64_t utime, std::shared_ptr<MsgType>&& msg)
+    {
+        if (count == bufMax) {
+            // A message older than everything in a full buffer means time jumped
+            // backwards (eg someone seeked in a log), so start over
+            if (utime < entryAt(0).utime) {
+                while (count > 0) eraseAt(count - 1);
+            } else {
+                recycle(entryAt(0).msg);
+                head = (head + 1) % bufMax;
+                --count;
+            }
+        }
+
+        // Messages almost always arrive in order, making this an append
+        size_t idx = count;
+        if (count > 0 && entryAt(count - 1).utime > utime)
+            idx = upperBound(utime);
+        ++count;
+        for (size_t i = count - 1; i > idx; --i)
+            std::swap(entryAt(i), entryAt(i - 1));
+        entryAt(idx).utime = utime;
+        entryAt(idx).msg = std::move(msg);
+    }
+
+    // Finds the messages bracketing utime. Either may be null
+    void bracket(uint64_t utime,
+                 std::shared_ptr<MsgType>& m0, uint64_t& m0Utime,
+                 std::shared_ptr<MsgType>& m1, uint64_t& m1Utime) const
+    {
+        std::unique_lock<BufLockType> lk(bufLock);
+        size_t idx = upperBound(utime);
+        if (idx > 0) {
+            m0 = entryAt(idx - 1).msg;
+            m0Utime = entryAt(idx - 1).utime;
+        }
+        if (m0 && m0Utime == utime) {
+            m1 = m0;
+            m1Utime = m0Utime;
+        } else if (idx < count) {
+            m1 = entryAt(idx).msg;
+            m1Utime = entryAt(idx).utime;
+        }
+    }
+
+    // Finds the messages within maxTimeErr_us of utime that bracket it. If both
+    // are found and differ, the message at utime has to be interpolated from
+    // them. Otherwise, the message at utime (if any) is returned through m0
+    void bracketNear(uint64_t utime,
+                     std::shared_ptr<MsgType>& m0, uint64_t& m0Utime,
+                     std::shared_ptr<MsgType>& m1, uint64_t& m1Utime) const
+    {
+        m0Utime = 0;
+        m1Utime = UINT64_MAX;
+        bracket(utime, m0, m0Utime, m1, m1Utime);
+
+        if (m0 && utime - m0Utime > maxTimeErr_us) m0.reset();
+        if (m1 && m1Utime - utime > maxTimeErr_us) m1.reset();
+
+        if (m0 && m1 && m0Utime != m1Utime) return;
+        if (!m0) m0 = std::move(m1);
+        m1.reset();
+    }
+
+    // Returns the buffered message at utime. If the message has to be interpolated,
+    // the new message is returned through 'interp' instead
+    std::shared_ptr<MsgType> getAt(uint64_t utime, T*& interp) const
+    {
+        std::shared_ptr<MsgType> m0, m1;
+        uint64_t m0Utime, m1Utime;
+        bracketNear(utime, m0, m0Utime, m1, m1Utime);
+        interp = nullptr;
+
+        if (m1) {
+            interp = interpolate(utime, m0.get(), m0Utime, m1.get(), m1Utime);
+            return nullptr;
+        }
+        return m0;
+    }
+
   public:
     ///////////////////////////////
     //// Iterator Defn and Ops ////
     ///////////////////////////////
 
-    typedef typename ContainerType::              iterator               iterator;
-    typedef typename ContainerType::        const_iterator         const_iterator;
-    typedef typename ContainerType::      reverse_iterator       reverse_iterator;
-    typedef typename ContainerType::const_reverse_iterator const_reverse_iterator;
+    // Iterates over the buffered messages in utime order.
+    // Note: iterating is not thread safe
+    template <bool Const>
+    class RingIterator
+    {
+        friend class Tracker;
+        typedef typename std::conditional<Const, const Tracker, Tracker>::type Owner;
+        Owner* t;
+        size_t i;
+
+      public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef MsgType*                        value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef MsgType* const*                 pointer;
+        typedef MsgType*                        reference;
+
+        RingIterator(Owner* t = nullptr, size_t i = 0) : t(t), i(i) {}
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        RingIterator(const RingIterator<false>& o) : t(o.t), i(o.i) {}
+
+        MsgType* operator*() const { return t->entryAt(i).msg.get(); }
+        MsgType* operator[](difference_type n) const { return *(*this + n); }
+
+        RingIterator& operator++() { ++i; return *this; }
+        RingIterator& operator--() { --i; return *this; }
+        RingIterator operator++(int) { RingIterator r = *this; ++i; return r; }
+        RingIterator operator--(int) { RingIterator r = *this; --i; return r; }
+        RingIterator& operator+=(difference_type n) { i += n; return *this; }
+        RingIterator& operator-=(difference_type n) { i -= n; return *this; }
+        RingIterator operator+(difference_type n) const { return RingIterator(t, i + n); }
+        RingIterator operator-(difference_type n) const { return RingIterator(t, i - n); }
+        difference_type operator-(const RingIterator& o) const
+        { return (difference_type)i - (difference_type)o.i; }
+
+        bool operator==(const RingIterator& o) const { return i == o.i; }
+        bool operator!=(const RingIterator& o) const { return i != o.i; }
+        bool operator< (const RingIterator& o) const { return i <  o.i; }
+        bool operator> (const RingIterator& o) const { return i >  o.i; }
+        bool operator<=(const RingIterator& o) const { return i <= o.i; }
+        bool operator>=(const RingIterator& o) const { return i >= o.i; }
+
+        template <bool C> friend class RingIterator;
+    };
+
+    typedef RingIterator<false>                         iterator;
+    typedef RingIterator<true>                    const_iterator;
+    typedef std::reverse_iterator<iterator>             reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    inline                iterator  begin()       { return buf.  begin(); }
-    inline          const_iterator cbegin() const { return buf. cbegin(); }
-    inline                iterator    end()       { return buf.    end(); }
-    inline          const_iterator   cend() const { return buf.   cend(); }
+    inline                iterator  begin()       { return       iterator(this, 0); }
+    inline          const_iterator cbegin() const { return const_iterator(this, 0); }
+    inline                iterator    end()       { return       iterator(this, count); }
+    inline          const_iterator   cend() const { return const_iterator(this, count); }
 
-    inline       reverse_iterator  rbegin()       { return buf. rbegin(); }
-    inline const_reverse_iterator crbegin() const { return buf.crbegin(); }
-    inline       reverse_iterator    rend()       { return buf.   rend(); }
-    inline const_reverse_iterator   crend() const { return buf.  crend(); }
+    inline       reverse_iterator  rbegin()       { return       reverse_iterator(end()); }
+    inline const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+    inline       reverse_iterator    rend()       { return       reverse_iterator(begin()); }
+    inline const_reverse_iterator   crend() const { return const_reverse_iterator(cbegin()); }
 
-    template <typename IterType>
-    inline IterType erase(IterType iter) { return buf.erase(iter); }
+    // The erased message is owned (and freed or recycled) by the tracker
+    inline iterator erase(iterator iter) { eraseAt(iter.i); return iter; }
 
     uint64_t getMsgUtime(const MsgType* msg) const
     {
@@ -185,6 +432,7 @@ class Tracker
 
         bufMax = maxMsgs;
         assert(maxMsgs > 0 && "Cannot allocate a tracker to track 0 messages");
+        ring.resize(bufMax);
 
         if (onMsg) thr = new std::thread(&Tracker<T>::callbackThreadFunc, this);
     }
@@ -193,7 +441,7 @@ class Tracker
     {
         if (thr) {
             {
-                std::unique_lock<BufLockType> lk(callbackLock);
+                std::unique_lock<std::recursive_mutex> lk(callbackLock);
                 done = true;
                 callbackCv.notify_all();
             }
@@ -201,33 +449,62 @@ class Tracker
             delete thr;
             if (callbackMsg) delete callbackMsg;
         }
-
-        std::unique_lock<BufLockType> lk(bufLock);
-        while (!buf.empty()) {
-            MsgType* tmp = buf.front();
-            delete tmp;
-            buf.pop_front();
-        }
     }
 
     // You must free the memory returned here. This may return nullptr
     T* get() const
     {
-        T* ret = nullptr;
-
-        {
-            std::unique_lock<BufLockType> lk(bufLock);
-            if (!buf.empty()) ret = new T(*buf.back());
-        }
-
-        return ret;
+        std::shared_ptr<const T> ret = getShared();
+        return ret ? new T(*ret) : nullptr;
     }
 
     // Same semantics as get()
     T* get(uint64_t utime) const
+    {
+        T* interp;
+        std::shared_ptr<MsgType> ret = getAt(utime, interp);
+        if (interp) return interp;
+        return ret ? new T(*ret) : nullptr;
+    }
+
+    // Same as get(utime), but writes the message into 'out' instead of allocating
+    // a new one, so out's memory can be reused across calls.
+    // Returns false (leaving out untouched) if there is no message near utime
+    bool get(uint64_t utime, T& out) const
+    {
+        std::shared_ptr<MsgType> m0, m1;
+        uint64_t m0Utime, m1Utime;
+        bracketNear(utime, m0, m0Utime, m1, m1Utime);
+
+        if (m1) interpolateInto(utime, m0.get(), m0Utime, m1.get(), m1Utime, out);
+        else if (m0) out = *m0;
+        else return false;
+        return true;
+    }
+
+    // Same as get(), except that the message is not copied. The returned message
+    // is immutable and is kept alive for as long as you hold onto it.
+    // Like get(), this is the most recently received message, even if it arrived
+    // out of order. Once that message is gone from the buffer, this is the one
+    // with the greatest utime instead. This may return nullptr
+    std::shared_ptr<const T> getShared() const
     {
         std::unique_lock<BufLockType> lk(bufLock);
-        return get(utime, buf.begin(), buf.end(), &lk);
+        if (count == 0) return nullptr;
+        // Among equal utimes, the most recently received message is the last one
+        size_t idx = upperBound(lastMsgUtime);
+        if (idx > 0 && entryAt(idx - 1).utime == lastMsgUtime)
+            return entryAt(idx - 1).msg;
+        return entryAt(count - 1).msg;
+    }
+
+    // Same as get(utime), without copying the message unless it had to be interpolated
+    std::shared_ptr<const T> getShared(uint64_t utime) const
+    {
+        T* interp;
+        std::shared_ptr<MsgType> ret = getAt(utime, interp);
+        if (interp) return std::shared_ptr<const T>(interp);
+        return ret;
     }
 
     // TODO: Should consider how to allow the user to ask for an extrapolated
@@ -248,10 +525,8 @@ class Tracker
         const MsgType* _m0 = nullptr;
         const MsgType* _m1 = nullptr;
 
-        // The reason why we do a linear search is to support the ability
-        // to skip around in logs. We want to support messages with
-        // non-monitonically increasing utimes and this is the easiest way.
-        // This can be made much faster if needed
+        // Arbitrary user ranges are not necessarily sorted, so this is a linear search.
+        // get(utime) searches the tracker's own (sorted) buffer much faster
         for (auto iter = first; iter != last; ++iter) {
             // Note: This is unsafe unless we rely on the static assert at the beginning of
             //       the function
@@ -307,41 +582,34 @@ class Tracker
     // This search is inclusive and can't return a message outside [A,B]
     std::vector<T*> getRange(uint64_t utimeA, uint64_t utimeB) const
     {
-        std::unique_lock<BufLockType> lk(bufLock);
-
-        // See reason for linear search given in the get() function
+        std::vector<std::shared_ptr<const T>> shared = getRangeShared(utimeA, utimeB);
         std::vector<T*> ret;
-        for (const MsgType* m : buf) {
-            uint64_t mUtime = getMsgUtime(m);
-            if (utimeA <= mUtime && mUtime <= utimeB)
-                ret.push_back(new T(*m));
-        }
+        ret.reserve(shared.size());
+        for (auto& m : shared) ret.push_back(new T(*m));
         return ret;
     }
 
-    size_t expireBefore(uint64_t utime)
+    // Same as getRange(), without copying the messages
+    std::vector<std::shared_ptr<const T>> getRangeShared(uint64_t utimeA, uint64_t utimeB) const
     {
-        size_t ret = 0;
+        std::vector<std::shared_ptr<const T>> ret;
         std::unique_lock<BufLockType> lk(bufLock);
+        if (utimeA > utimeB) return ret;
+        size_t end = upperBound(utimeB);
+        for (size_t i = lowerBound(utimeA); i < end; ++i)
+            ret.push_back(entryAt(i).msg);
+        return ret;
+    }
 
-        // Expire things that are too old
-        while (!buf.empty()) {
-            if (getMsgUtime(buf.front()) >= utime) break;
-            delete buf.front();
-            buf.pop_front();
-            ++ret;
-        }
-
-        for (auto iter = buf.begin(); iter != buf.end();) {
-            if (getMsgUtime(*iter) < utime) {
-                delete *iter;
-                iter = buf.erase(iter);
-                ++ret;
-            } else {
-                ++iter;
-            }
+    size_t expireBefore(uint64_t utime)
+    {
+        std::unique_lock<BufLockType> lk(bufLock);
+        size_t ret = lowerBound(utime);
+        for (size_t i = 0; i < ret; ++i) {
+            recycle(entryAt(0).msg);
+            head = (head + 1) % bufMax;
+            --count;
         }
-
         return ret;
     }
 
@@ -350,18 +618,24 @@ class Tracker
     // Returns utime of message
     virtual uint64_t newMsg(const T* _msg, uint64_t hostUtime = UINT64_MAX)
     {
-        MsgType* tmp = new MsgType(*_msg, hostUtime);
-        uint64_t tmpUtime = getMsgUtime(tmp);
+        // Copy the message into a recycled one outside of the lock where possible
+        std::shared_ptr<MsgType> tmp;
+        {
+            std::unique_lock<BufLockType> lk(bufLock);
+            if (!freeMsgs.empty()) {
+                tmp = std::move(freeMsgs.back());
+                freeMsgs.pop_back();
+            }
+        }
+        if (tmp) tmp->set(*_msg, hostUtime);
+        else     tmp = std::make_shared<MsgType>(*_msg, hostUtime);
+        uint64_t tmpUtime = getMsgUtime(tmp.get());
 
         {
             std::unique_lock<BufLockType> lk(bufLock);
 
-            // Expire due to buffer being full
-            if (buf.size() == bufMax) {
-                MsgType* tmp = buf.front();
-                delete tmp;
-                buf.pop_front();
-            }
+            insert(tmpUtime, std::move(tmp));
+            lastMsgUtime = tmpUtime;
 
             // Run the filter for jitter and frequency
             if (lastHostUtime != UINT64_MAX) {
@@ -385,7 +659,6 @@ class Tracker
             }
 
             lastHostUtime = hostUtime;
-            buf.push_back(tmp);
         }
 
         // Dispatch to callback
@@ -412,7 +685,7 @@ class Tracker
     {
         {
             std::unique_lock<BufLockType> lk(bufLock);
-            if (!buf.empty()) return lastHostUtime;
+            if (count > 0) return lastHostUtime;
         }
         return UINT64_MAX;
     }
@@ -499,8 +772,8 @@ class MessageTracker : public virtual Tracker<T>
 // not a later message, this class will wait until a message of type Type2Tracker::ZcmType is
 // received that is no earlier than the message of Type1Tracker::ZcmType.
 //
-// TODO: Make a SynchronizedTracker class that this class uses.
-//       Similar to MessageTracker and Tracker above
+// See SynchronizedTracker below to synchronize more than two streams by
+// approximate time instead.
 //
 template <typename Type1Tracker, typename Type2Tracker>
 class SynchronizedMessageDispatcher
@@ -562,8 +835,14 @@ class SynchronizedMessageDispatcher
             auto msg2 = t2.get(utime);
             if (msg2) {
                 onSynchronizedMsg(msg, msg2, usr);
-                delete *t1.rbegin();
-                t1.erase(t1.rbegin().base());
+                // msg went into t1 at its utime, which is only the end of the buffer if it
+                // arrived in order. Among equal utimes it is the last one
+                for (auto it1 = t1.end(); it1 != t1.begin();) {
+                    --it1;
+                    uint64_t u = t1.getMsgUtime(*it1);
+                    if (u == utime) { t1.erase(it1); break; }
+                    if (u < utime) break;
+                }
             }
         }
     }
@@ -575,7 +854,6 @@ class SynchronizedMessageDispatcher
                 auto msg2 = t2.get(t1.getMsgUtime(*it));
                 if (msg2) {
                     onSynchronizedMsg(*it, msg2, usr);
-                    delete *it;
                     it = t1.erase(it);
                     continue;
                 }
@@ -609,6 +887,213 @@ class SynchronizedMessageDispatcher
     friend class ::MessageTrackerTest;
 };
 
+// This class synchronizes N streams of messages, one per tracker type. Whenever
+// every stream has a message within 'slop' seconds of each other, the callback is
+// called with one message from each stream (in the order the trackers are listed).
+//
+// If you're interested in the details, here they are:
+//
+// Each stream keeps a utime-sorted queue of messages that have not been matched
+// yet. Two heaps track the earliest and the latest of the stream queue heads. Once
+// every stream has a pending message, the heads are emitted as a tuple if they
+// span no more than 'slop'. Otherwise, the earliest head can never be matched
+// (every other stream has already moved past it) so it is dropped. Each message
+// is therefore pushed and popped from the heaps a constant number of times,
+// making this O(log N) per message.
+//
+// At most 'queueSize' unmatched messages are kept per stream, after which the
+// oldest one is dropped. Set a drop callback to be told about dropped messages.
+//
+// Each tracker type must be an extension of MessageTracker<ZcmType> with a
+// constructor taking (zcm::ZCM*, channel, maxTimeErr, maxMsgs), so the messages
+// are also available through the usual Tracker interface.
+template <typename... Trackers>
+class SynchronizedTracker
+{
+  public:
+    static constexpr size_t N = sizeof...(Trackers);
+
+    typedef std::function<void(std::shared_ptr<const typename Trackers::ZcmType>...,
+                               void*)> callback;
+
+    typedef std::function<void(size_t stream, uint64_t utime, void*)> dropCallback;
+
+  private:
+    template <size_t...> struct Indices {};
+    template <size_t I, size_t... Is>
+    struct MakeIndices : MakeIndices<I - 1, I - 1, Is...> {};
+    template <size_t... Is>
+    struct MakeIndices<0, Is...> { typedef Indices<Is...> type; };
+
+    template <size_t I, typename TrackerType>
+    class StreamTracker : public TrackerType
+    {
+      private:
+        SynchronizedTracker* st;
+
+      public:
+        uint64_t handle(const zcm::ReceiveBuffer* rbuf, const std::string& chan,
+                        const typename TrackerType::ZcmType* _msg) override
+        {
+            uint64_t utime = TrackerType::handle(rbuf, chan, _msg);
+            st->process(I, utime, this->getShared(utime));
+            return utime;
+        }
+
+        StreamTracker(zcm::ZCM* zcmLocal, const std::string& channel,
+                      double maxTimeErr, size_t maxMsgs, SynchronizedTracker* st) :
+            Tracker<typename TrackerType::ZcmType>(maxTimeErr, maxMsgs),
+            TrackerType(zcmLocal, channel, maxTimeErr, maxMsgs), st(st)
+        {}
+    };
+
+    template <typename Is> struct Streams;
+    template <size_t... Is>
+    struct Streams<Indices<Is...>>
+    {
+        typedef std::tuple<std::unique_ptr<StreamTracker<Is, Trackers>>...> type;
+    };
+
+    struct Pending
+    {
+        uint64_t utime;
+        std::shared_ptr<const void> msg;
+    };
+
+    typedef std::pair<uint64_t, size_t> HeapEntry;
+
+    typename Streams<typename MakeIndices<N>::type>::type trackers;
+
+    std::array<std::deque<Pending>, N> pending;
+    size_t numNonEmpty = 0;
+    // Lazy heaps of stream queue heads: an entry is stale once that head is gone
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> earliest;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::less<HeapEntry>> latest;
+
+    uint64_t slop_us;
+    size_t queueSize;
+    callback onSynchronizedMsgs;
+    dropCallback onDrop;
+    void* usr;
+
+    bool isHead(const HeapEntry& e) const
+    {
+        return !pending[e.second].empty() && pending[e.second].front().utime == e.first;
+    }
+
+    void pushHead(size_t stream)
+    {
+        if (pending[stream].empty()) return;
+
+        // Stale entries at the bottom of a heap never surface on their own
+        if (earliest.size() > 4 * N + 16 || latest.size() > 4 * N + 16) {
+            earliest = decltype(earliest)();
+            latest = decltype(latest)();
+            for (size_t i = 0; i < N; ++i) {
+                if (i == stream || pending[i].empty()) continue;
+                HeapEntry e(pending[i].front().utime, i);
+                earliest.push(e);
+                latest.push(e);
+            }
+        }
+
+        HeapEntry e(pending[stream].front().utime, stream);
+        earliest.push(e);
+        latest.push(e);
+    }
+
+    template <typename Heap>
+    static const HeapEntry& top(Heap& heap, const SynchronizedTracker* st)
+    {
+        while (!st->isHead(heap.top())) heap.pop();
+        return heap.top();
+    }
+
+    void popHead(size_t stream, bool dropped)
+    {
+        if (dropped && onDrop) onDrop(stream, pending[stream].front().utime, usr);
+        pending[stream].pop_front();
+        if (pending[stream].empty()) --numNonEmpty;
+        else                         pushHead(stream);
+    }
+
+    template <size_t... Is>
+    void emit(Indices<Is...>)
+    {
+        onSynchronizedMsgs(std::static_pointer_cast<const typename Trackers::ZcmType>(
+                               pending[Is].front().msg)..., usr);
+    }
+
+    void process(size_t stream, uint64_t utime, std::shared_ptr<const void> msg)
+    {
+        if (!msg) return;
+
+        auto& q = pending[stream];
+        bool wasEmpty = q.empty();
+        // Messages almost always arrive in order, making this an append
+        auto it = q.end();
+        while (it != q.begin() && std::prev(it)->utime > utime) --it;
+        bool newHead = it == q.begin();
+        q.insert(it, Pending{utime, std::move(msg)});
+        if (wasEmpty) ++numNonEmpty;
+        if (newHead) pushHead(stream);
+
+        if (q.size() > queueSize) popHead(stream, true);
+
+        while (numNonEmpty == N) {
+            HeapEntry first = top(earliest, this);
+            HeapEntry last = top(latest, this);
+            if (last.first - first.first <= slop_us) {
+                emit(typename MakeIndices<N>::type());
+                for (size_t i = 0; i < N; ++i) popHead(i, false);
+            } else {
+                popHead(first.second, true);
+            }
+        }
+    }
+
+    template <size_t... Is>
+    void makeTrackers(Indices<Is...>, zcm::ZCM* zcmLocal,
+                      const std::array<std::string, N>& channels, double slop)
+    {
+        trackers = std::make_tuple(std::unique_ptr<StreamTracker<Is, Trackers>>(
+            new StreamTracker<Is, Trackers>(zcmLocal, channels[Is], slop, queueSize, this))...);
+    }
+
+    template <typename... Ts>
+    struct AreMessageTrackers : std::true_type {};
+    template <typename T0, typename... Ts>
+    struct AreMessageTrackers<T0, Ts...> :
+        std::integral_constant<bool,
+            std::is_base_of<MessageTracker<typename T0::ZcmType>, T0>::value &&
+            AreMessageTrackers<Ts...>::value> {};
+
+    static_assert(N > 0, "Nothing to synchronize");
+    static_assert(AreMessageTrackers<Trackers...>::value,
+                  "Every tracker type must be an extension of MessageTracker<type>");
+
+  public:
+    SynchronizedTracker(zcm::ZCM* zcmLocal, const std::array<std::string, N>& channels,
+                        double slop, size_t queueSize,
+                        callback onSynchronizedMsgs, void* usr = nullptr) :
+        slop_us(slop * 1e6), queueSize(queueSize),
+        onSynchronizedMsgs(onSynchronizedMsgs), usr(usr)
+    {
+        assert(queueSize > 0 && "Cannot synchronize with a queue size of 0");
+        makeTrackers(typename MakeIndices<N>::type(), zcmLocal, channels, slop);
+    }
+
+    // Called with every message that is dropped without being matched
+    void setDropCallback(dropCallback cb) { onDrop = cb; }
+
+    // Access to the underlying tracker of stream I
+    template <size_t I>
+    typename std::tuple_element<I, std::tuple<Trackers...>>::type& getTracker()
+    { return *std::get<I>(trackers); }
+
+    friend class ::MessageTrackerTest;
+};
+
 }
 
 #undef ZCM_DEBUG
@@ -4,11 +4,23 @@
 
 #include <string.h>
 
+/* Statistics need the (C++) zcm library, so they're never available on embedded */
+#if defined(USING_STATS) && !defined(ZCM_EMBEDDED)
+#define ZCM_NONBLOCK_STATS
+#include "zcm/stats_private.h"
+#endif
+
 /* TODO remove malloc for preallocated mem and linked-lists */
 #ifndef ZCM_NONBLOCK_SUBS_MAX
 #define ZCM_NONBLOCK_SUBS_MAX 512
 #endif
 
+/* The size of the one buffer that zcm_publish_reserve() loans out. Larger
+   reservations are rejected with ZCM_EINVALID */
+#ifndef ZCM_NONBLOCK_RESERVE_MAX
+#define ZCM_NONBLOCK_RESERVE_MAX 256
+#endif
+
 struct zcm_nonblocking
 {
     zcm_t *z;
@@ -20,6 +32,16 @@ struct zcm_nonblocking
     zcm_sub_t subs[ZCM_NONBLOCK_SUBS_MAX];
     bool      subInUse[ZCM_NONBLOCK_SUBS_MAX];
     size_t    subInUseEnd;
+
+    /* The one zcm_publish_reserve() buffer, loaned out while 'reserved' is set */
+    bool      reserved;
+    uint32_t  reservedLen;
+    char      reservedChannel[ZCM_CHANNEL_MAXLEN+1];
+    char      reservedBuf[ZCM_NONBLOCK_RESERVE_MAX];
+
+#ifdef ZCM_NONBLOCK_STATS
+    zcm_stats_t *stats;
+#endif
 };
 
 static bool isRegexChannel(const char* c, size_t clen)
@@ -68,6 +90,13 @@ zcm_nonblocking_t *zcm_nonblocking_create(zcm_t *z, zcm_trans_t *zt)
         zcm->subInUse[i] = false;
 
     zcm->subInUseEnd = 0;
+
+    zcm->reserved = false;
+    zcm->reservedLen = 0;
+
+#ifdef ZCM_NONBLOCK_STATS
+    zcm->stats = zcm_stats_create(zcm_trans_get_mtu(zt));
+#endif
     return zcm;
 }
 
@@ -75,6 +104,9 @@ void zcm_nonblocking_destroy(zcm_nonblocking_t *zcm)
 {
     if (zcm) {
         if (zcm->zt) zcm_trans_destroy(zcm->zt);
+#ifdef ZCM_NONBLOCK_STATS
+        zcm_stats_destroy(zcm->stats);
+#endif
         free(zcm);
         zcm = NULL;
     }
@@ -85,10 +117,67 @@ int zcm_nonblocking_publish(zcm_nonblocking_t *z, const char *channel, const cha
 {
     zcm_msg_t msg;
 
+    msg.utime = 0;
     msg.channel = channel;
     msg.len = len;
     msg.buf = (char*)data;
+    msg.pub_utime = 0;
+    msg.seqno = 0;
+#ifdef ZCM_NONBLOCK_STATS
+    {
+        zcm_stats_channel_t *sc = zcm_stats_lookup(z->stats, channel);
+        uint64_t start = zcm_stats_now();
+        int ret = zcm_trans_sendmsg(z->zt, msg);
+        zcm_stats_record(sc, ZCM_STATS_SEND, zcm_stats_now() - start);
+        if (ret == ZCM_EOK) zcm_stats_count_publish(sc, len);
+        return ret;
+    }
+#else
     return zcm_trans_sendmsg(z->zt, msg);
+#endif
+}
+
+/* Note: nonblocking transports have no way to loan out their memory, so the
+         reserved buffer is copied into the transport on commit */
+int zcm_nonblocking_publish_reserve(zcm_nonblocking_t *zcm, const char *channel,
+                                    uint32_t len, char **buf)
+{
+    size_t clen = strlen(channel);
+    if (clen > ZCM_CHANNEL_MAXLEN) return ZCM_EINVALID;
+    if (len > zcm_trans_get_mtu(zcm->zt)) return ZCM_EINVALID;
+    if (len > ZCM_NONBLOCK_RESERVE_MAX) return ZCM_EINVALID;
+    if (zcm->reserved) return ZCM_EAGAIN;
+
+    zcm->reserved = true;
+    zcm->reservedLen = len;
+    memcpy(zcm->reservedChannel, channel, clen + 1);
+
+    *buf = zcm->reservedBuf;
+    return ZCM_EOK;
+}
+
+int zcm_nonblocking_publish_commit(zcm_nonblocking_t *zcm, void *buf)
+{
+    int ret;
+    if (!zcm->reserved || buf != zcm->reservedBuf) return ZCM_EINVALID;
+
+    ret = zcm_nonblocking_publish(zcm, zcm->reservedChannel,
+                                  zcm->reservedBuf, zcm->reservedLen);
+    /* Keep the reservation around so that the user can retry */
+    if (ret == ZCM_EAGAIN) return ret;
+
+    zcm->reserved = false;
+    zcm->reservedLen = 0;
+    return ret;
+}
+
+int zcm_nonblocking_publish_abort(zcm_nonblocking_t *zcm, void *buf)
+{
+    if (!zcm->reserved || buf != zcm->reservedBuf) return ZCM_EINVALID;
+
+    zcm->reserved = false;
+    zcm->reservedLen = 0;
+    return ZCM_EOK;
 }
 
 zcm_sub_t *zcm_nonblocking_subscribe(zcm_nonblocking_t *zcm, const char *channel,
@@ -164,11 +253,28 @@ int zcm_nonblocking_unsubscribe(zcm_nonblocking_t *zcm, zcm_sub_t *sub)
     return rc;
 }
 
+static void invoke_callback(zcm_nonblocking_t *zcm, zcm_sub_t *sub,
+                            const zcm_recv_buf_t *rbuf, const char *channel)
+{
+#ifdef ZCM_NONBLOCK_STATS
+    uint64_t start = zcm_stats_now();
+    sub->callback(rbuf, channel, sub->usr);
+    zcm_stats_record(zcm_stats_lookup(zcm->stats, channel),
+                     ZCM_STATS_CALLBACK, zcm_stats_now() - start);
+#else
+    sub->callback(rbuf, channel, sub->usr);
+#endif
+}
+
 static void dispatch_message(zcm_nonblocking_t *zcm, zcm_msg_t *msg)
 {
     zcm_recv_buf_t rbuf;
     zcm_sub_t *sub;
 
+#ifdef ZCM_NONBLOCK_STATS
+    zcm_stats_count_recv(zcm_stats_lookup(zcm->stats, msg->channel), msg->len);
+#endif
+
     size_t i;
     for (i = 0; i < zcm->subInUseEnd; ++i) {
         if (!zcm->subInUse[i]) continue;
@@ -184,9 +290,11 @@ static void dispatch_message(zcm_nonblocking_t *zcm, zcm_msg_t *msg)
                 rbuf.data = (char*)msg->buf;
                 rbuf.data_size = msg->len;
                 rbuf.recv_utime = msg->utime;
+                rbuf.pub_utime = msg->pub_utime;
+                rbuf.seqno = msg->seqno;
 
                 sub = &zcm->subs[i];
-                sub->callback(&rbuf, msg->channel, sub->usr);
+                invoke_callback(zcm, sub, &rbuf, msg->channel);
             }
         } else {
             if (strcmp(zcm->subs[i].channel, msg->channel) == 0) {
@@ -194,9 +302,11 @@ static void dispatch_message(zcm_nonblocking_t *zcm, zcm_msg_t *msg)
                 rbuf.data = (char*)msg->buf;
                 rbuf.data_size = msg->len;
                 rbuf.recv_utime = msg->utime;
+                rbuf.pub_utime = msg->pub_utime;
+                rbuf.seqno = msg->seqno;
 
                 sub = &zcm->subs[i];
-                sub->callback(&rbuf, msg->channel, sub->usr);
+                invoke_callback(zcm, sub, &rbuf, msg->channel);
             }
         }
     }
@@ -210,7 +320,17 @@ int zcm_nonblocking_handle_nonblock(zcm_nonblocking_t *zcm)
     /* Perform any required traansport-level updates */
     zcm_trans_update(zcm->zt);
 
+#ifdef ZCM_NONBLOCK_STATS
+    {
+        const char *buf;
+        int len = zcm_stats_poll_publish(zcm->stats, &buf);
+        if (len > 0) zcm_nonblocking_publish(zcm, ZCM_STATS_CHANNEL, buf, len);
+    }
+#endif
+
     /* Try to receive a messages from the transport and dispatch them */
+    msg.pub_utime = 0;
+    msg.seqno = 0;
     if ((ret = zcm_trans_recvmsg(zcm->zt, &msg, 0)) != ZCM_EOK)
         return ret;
     dispatch_message(zcm, &msg);
@@ -225,6 +345,22 @@ void zcm_nonblocking_flush(zcm_nonblocking_t* zcm)
     zcm_trans_update(zcm->zt);
 
     zcm_msg_t msg;
-    while (zcm_trans_recvmsg(zcm->zt, &msg, 0) == ZCM_EOK)
+    msg.pub_utime = 0;
+    msg.seqno = 0;
+    while (zcm_trans_recvmsg(zcm->zt, &msg, 0) == ZCM_EOK) {
         dispatch_message(zcm, &msg);
+        msg.pub_utime = 0;
+        msg.seqno = 0;
+    }
 }
+
+#ifndef ZCM_EMBEDDED
+int zcm_nonblocking_get_stats(zcm_nonblocking_t *zcm, zcm_channel_stats_t *stats, int max)
+{
+#ifdef ZCM_NONBLOCK_STATS
+    return zcm_stats_get(zcm->stats, stats, max);
+#else
+    return -1;
+#endif
+}
+#endif
@@ -3,6 +3,9 @@
 
 #include "zcm/zcm.h"
 #include "zcm/transport.h"
+#ifndef ZCM_EMBEDDED
+#include "zcm/stats.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,6 +17,10 @@ void               zcm_nonblocking_destroy(zcm_nonblocking_t *zcm);
 
 int        zcm_nonblocking_publish(zcm_nonblocking_t *zcm, const char *channel, const char *data,
                                    uint32_t len);
+int        zcm_nonblocking_publish_reserve(zcm_nonblocking_t *zcm, const char *channel,
+                                           uint32_t len, char **buf);
+int        zcm_nonblocking_publish_commit(zcm_nonblocking_t *zcm, void *buf);
+int        zcm_nonblocking_publish_abort(zcm_nonblocking_t *zcm, void *buf);
 zcm_sub_t *zcm_nonblocking_subscribe(zcm_nonblocking_t *zcm, const char *channel,
                                      zcm_msg_handler_t cb, void *usr);
 int        zcm_nonblocking_unsubscribe(zcm_nonblocking_t *zcm, zcm_sub_t *sub);
@@ -23,6 +30,10 @@ int zcm_nonblocking_handle_nonblock(zcm_nonblocking_t *zcm);
 
 void zcm_nonblocking_flush(zcm_nonblocking_t *zcm);
 
+#ifndef ZCM_EMBEDDED
+int zcm_nonblocking_get_stats(zcm_nonblocking_t *zcm, zcm_channel_stats_t *stats, int max);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,324 @@
+#include "zcm/stats.h"
+#include "zcm/stats_private.h"
+#include "zcm/zcm_coretypes.h"
+#include "util/TimeUtil.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <vector>
+using namespace std;
+
+// Identifies messages on ZCM_STATS_CHANNEL. Sits where a zcmtype's hash would be
+static const int64_t STATS_MAGIC = 0x7a636d5f73746174LL; // "zcm_stat"
+
+static_assert((ZCM_STATS_MAX_CHANNELS & (ZCM_STATS_MAX_CHANNELS - 1)) == 0,
+              "ZCM_STATS_MAX_CHANNELS must be a power of 2");
+
+// A channel's entry is claimed once, by whichever thread first sees the channel,
+// and never released. Entries are found by open addressing on the channel name,
+// so recording never takes a lock.
+struct zcm_stats_channel
+{
+    enum { EMPTY = 0, CLAIMING, READY };
+    atomic<int> state {EMPTY};
+    char channel[ZCM_CHANNEL_MAXLEN + 1];
+
+    atomic<uint64_t> pubMsgs {0};
+    atomic<uint64_t> pubBytes {0};
+    atomic<uint64_t> recvMsgs {0};
+    atomic<uint64_t> recvBytes {0};
+
+    struct Hist
+    {
+        atomic<uint64_t> count {0};
+        atomic<uint64_t> sumNs {0};
+        atomic<uint64_t> buckets[ZCM_STATS_HIST_BUCKETS];
+        Hist() { for (auto& b : buckets) b.store(0, memory_order_relaxed); }
+    } hists[ZCM_STATS_NUM_HISTS];
+};
+
+struct zcm_stats
+{
+    zcm_stats_channel channels[ZCM_STATS_MAX_CHANNELS];
+
+    double period = 0;
+    uint64_t lastPublishNs = 0;
+    vector<char> pubBuf;
+    vector<zcm_channel_stats_t> pubStats;
+};
+
+static uint32_t hashChannel(const char *channel)
+{
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (const char *c = channel; *c; ++c)
+        h = (h ^ (uint8_t)*c) * 16777619u;
+    return h;
+}
+
+static void snapshot(const zcm_stats_channel& c, zcm_channel_stats_t& out)
+{
+    strcpy(out.channel, c.channel);
+    out.pub_msgs   = c.pubMsgs.load(memory_order_relaxed);
+    out.pub_bytes  = c.pubBytes.load(memory_order_relaxed);
+    out.recv_msgs  = c.recvMsgs.load(memory_order_relaxed);
+    out.recv_bytes = c.recvBytes.load(memory_order_relaxed);
+    for (int h = 0; h < ZCM_STATS_NUM_HISTS; ++h) {
+        out.hists[h].count  = c.hists[h].count.load(memory_order_relaxed);
+        out.hists[h].sum_ns = c.hists[h].sumNs.load(memory_order_relaxed);
+        for (int b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b)
+            out.hists[h].buckets[b] = c.hists[h].buckets[b].load(memory_order_relaxed);
+    }
+}
+
+extern "C" {
+
+zcm_stats_t *zcm_stats_create(uint32_t mtu)
+{
+    zcm_stats_t *s = new zcm_stats_t();
+    const char *period = getenv("ZCM_STATS_PERIOD");
+    if (period) s->period = atof(period);
+    if (s->period > 0) {
+        s->pubBuf.resize(mtu < 65536 ? mtu : 65536);
+        s->pubStats.resize(ZCM_STATS_MAX_CHANNELS);
+    }
+    return s;
+}
+
+void zcm_stats_destroy(zcm_stats_t *s)
+{
+    delete s;
+}
+
+uint64_t zcm_stats_now(void)
+{
+    return TimeUtil::monoNtime();
+}
+
+zcm_stats_channel_t *zcm_stats_lookup(zcm_stats_t *s, const char *channel)
+{
+    uint32_t mask = ZCM_STATS_MAX_CHANNELS - 1;
+    uint32_t start = hashChannel(channel) & mask;
+    for (uint32_t i = 0; i < ZCM_STATS_MAX_CHANNELS; ++i) {
+        zcm_stats_channel& c = s->channels[(start + i) & mask];
+        int state = c.state.load(memory_order_acquire);
+        if (state == zcm_stats_channel::EMPTY &&
+            c.state.compare_exchange_strong(state, zcm_stats_channel::CLAIMING,
+                                            memory_order_acquire)) {
+            size_t len = strnlen(channel, ZCM_CHANNEL_MAXLEN);
+            memcpy(c.channel, channel, len);
+            c.channel[len] = '\0';
+            c.state.store(zcm_stats_channel::READY, memory_order_release);
+            return &c;
+        }
+        // Another thread is filling in the name of this entry, which takes no time
+        while (state == zcm_stats_channel::CLAIMING)
+            state = c.state.load(memory_order_acquire);
+        if (strncmp(c.channel, channel, ZCM_CHANNEL_MAXLEN) == 0)
+            return &c;
+    }
+    return NULL;
+}
+
+void zcm_stats_count_publish(zcm_stats_channel_t *c, uint32_t len)
+{
+    if (!c) return;
+    c->pubMsgs.fetch_add(1, memory_order_relaxed);
+    c->pubBytes.fetch_add(len, memory_order_relaxed);
+}
+
+void zcm_stats_count_recv(zcm_stats_channel_t *c, uint32_t len)
+{
+    if (!c) return;
+    c->recvMsgs.fetch_add(1, memory_order_relaxed);
+    c->recvBytes.fetch_add(len, memory_order_relaxed);
+}
+
+void zcm_stats_record(zcm_stats_channel_t *c, enum zcm_stats_hist h, uint64_t ns)
+{
+    if (!c) return;
+    auto& hist = c->hists[h];
+    hist.count.fetch_add(1, memory_order_relaxed);
+    hist.sumNs.fetch_add(ns, memory_order_relaxed);
+    hist.buckets[zcm_stats_bucket(ns)].fetch_add(1, memory_order_relaxed);
+}
+
+int zcm_stats_get(zcm_stats_t *s, zcm_channel_stats_t *stats, int max)
+{
+    int n = 0;
+    for (auto& c : s->channels) {
+        if (c.state.load(memory_order_acquire) != zcm_stats_channel::READY)
+            continue;
+        if (n < max) snapshot(c, stats[n]);
+        ++n;
+    }
+    return n;
+}
+
+double zcm_stats_period(zcm_stats_t *s)
+{
+    return s->period;
+}
+
+int zcm_stats_poll_publish(zcm_stats_t *s, const char **buf)
+{
+    if (s->period <= 0) return 0;
+    uint64_t now = zcm_stats_now();
+    if (s->lastPublishNs != 0 && now - s->lastPublishNs < s->period * 1e9) return 0;
+    s->lastPublishNs = now;
+
+    int n = zcm_stats_get(s, s->pubStats.data(), s->pubStats.size());
+    if (n > (int)s->pubStats.size()) n = s->pubStats.size();
+    *buf = s->pubBuf.data();
+    return zcm_stats_encode(s->pubStats.data(), n, s->pubBuf.data(), s->pubBuf.size());
+}
+
+int zcm_stats_bucket(uint64_t ns)
+{
+    if (ns < 2) return (int)ns;
+    int e = 63 - __builtin_clzll(ns);
+    int b = 2 * e + (int)((ns >> (e - 1)) & 1);
+    return b < ZCM_STATS_HIST_BUCKETS ? b : ZCM_STATS_HIST_BUCKETS - 1;
+}
+
+uint64_t zcm_stats_bucket_min(int bucket)
+{
+    if (bucket < 2) return bucket;
+    int e = bucket / 2;
+    return (uint64_t)(2 | (bucket & 1)) << (e - 1);
+}
+
+uint64_t zcm_stats_percentile(const zcm_stats_hist_t *hist, double p)
+{
+    uint64_t total = 0;
+    for (int b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b)
+        total += hist->buckets[b];
+    if (total == 0) return 0;
+
+    // Rank of the requested value, counting from 1
+    if (p < 0) p = 0;
+    if (p > 1) p = 1;
+    uint64_t rank = (uint64_t)(p * total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+
+    uint64_t seen = 0;
+    for (int b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b) {
+        seen += hist->buckets[b];
+        if (seen >= rank) return zcm_stats_bucket_min(b);
+    }
+    return zcm_stats_bucket_min(ZCM_STATS_HIST_BUCKETS - 1);
+}
+
+// Message format (big endian, as for zcmtypes):
+//   int64 magic, int32 nchannels, then per channel:
+//     int32 namelen, char name[namelen], int64 pub_msgs, pub_bytes, recv_msgs, recv_bytes
+//     then per histogram: int64 count, int64 sum_ns, int8 nbuckets,
+//                         nbuckets * (int8 bucket, int64 bucket count)
+// Only the non-empty buckets of a histogram are sent.
+int zcm_stats_encode(const zcm_channel_stats_t *stats, int n, void *buf, int maxlen)
+{
+    int pos = 0;
+    if (maxlen < 12) return 0;
+    pos += __int64_t_encode_array(buf, pos, maxlen - pos, &STATS_MAGIC, 1);
+    int countPos = pos;
+    int32_t count = 0;
+    pos += 4;
+
+    for (int i = 0; i < n; ++i) {
+        const zcm_channel_stats_t& c = stats[i];
+        int32_t nameLen = strnlen(c.channel, ZCM_CHANNEL_MAXLEN);
+
+        int size = 4 + nameLen + 4 * 8;
+        int8_t nbuckets[ZCM_STATS_NUM_HISTS];
+        for (int h = 0; h < ZCM_STATS_NUM_HISTS; ++h) {
+            nbuckets[h] = 0;
+            for (int b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b)
+                if (c.hists[h].buckets[b]) ++nbuckets[h];
+            size += 8 + 8 + 1 + nbuckets[h] * (1 + 8);
+        }
+        if (size > maxlen - pos) break;
+
+        pos += __int32_t_encode_array(buf, pos, maxlen - pos, &nameLen, 1);
+        pos += __byte_encode_array(buf, pos, maxlen - pos, (const uint8_t*)c.channel, nameLen);
+        int64_t counters[4] = { (int64_t)c.pub_msgs,  (int64_t)c.pub_bytes,
+                                (int64_t)c.recv_msgs, (int64_t)c.recv_bytes };
+        pos += __int64_t_encode_array(buf, pos, maxlen - pos, counters, 4);
+        for (int h = 0; h < ZCM_STATS_NUM_HISTS; ++h) {
+            const zcm_stats_hist_t& hist = c.hists[h];
+            int64_t totals[2] = { (int64_t)hist.count, (int64_t)hist.sum_ns };
+            pos += __int64_t_encode_array(buf, pos, maxlen - pos, totals, 2);
+            pos += __int8_t_encode_array(buf, pos, maxlen - pos, &nbuckets[h], 1);
+            for (int8_t b = 0; b < ZCM_STATS_HIST_BUCKETS; ++b) {
+                if (!hist.buckets[b]) continue;
+                int64_t bcount = hist.buckets[b];
+                pos += __int8_t_encode_array(buf, pos, maxlen - pos, &b, 1);
+                pos += __int64_t_encode_array(buf, pos, maxlen - pos, &bcount, 1);
+            }
+        }
+        ++count;
+    }
+
+    __int32_t_encode_array(buf, countPos, maxlen - countPos, &count, 1);
+    return pos;
+}
+
+int zcm_stats_decode(const void *buf, int len, zcm_channel_stats_t *stats, int max)
+{
+    int pos = 0, thislen;
+#define DECODE(type, dst, n) \
+    do { \
+        thislen = __##type##_decode_array(buf, pos, len - pos, dst, n); \
+        if (thislen < 0) return -1; \
+        pos += thislen; \
+    } while (0)
+
+    int64_t magic;
+    int32_t count;
+    DECODE(int64_t, &magic, 1);
+    if (magic != STATS_MAGIC) return -1;
+    DECODE(int32_t, &count, 1);
+    if (count < 0) return -1;
+
+    int i;
+    for (i = 0; i < count && i < max; ++i) {
+        zcm_channel_stats_t& c = stats[i];
+        memset(&c, 0, sizeof(c));
+
+        int32_t nameLen;
+        DECODE(int32_t, &nameLen, 1);
+        if (nameLen < 0 || nameLen > ZCM_CHANNEL_MAXLEN) return -1;
+        DECODE(byte, (uint8_t*)c.channel, nameLen);
+        c.channel[nameLen] = '\0';
+
+        int64_t counters[4];
+        DECODE(int64_t, counters, 4);
+        c.pub_msgs   = counters[0];
+        c.pub_bytes  = counters[1];
+        c.recv_msgs  = counters[2];
+        c.recv_bytes = counters[3];
+
+        for (int h = 0; h < ZCM_STATS_NUM_HISTS; ++h) {
+            zcm_stats_hist_t& hist = c.hists[h];
+            int64_t totals[2];
+            int8_t nbuckets;
+            DECODE(int64_t, totals, 2);
+            DECODE(int8_t, &nbuckets, 1);
+            hist.count  = totals[0];
+            hist.sum_ns = totals[1];
+            for (int8_t j = 0; j < nbuckets; ++j) {
+                int8_t b;
+                int64_t bcount;
+                DECODE(int8_t, &b, 1);
+                DECODE(int64_t, &bcount, 1);
+                if (b < 0 || b >= ZCM_STATS_HIST_BUCKETS) return -1;
+                hist.buckets[b] = bcount;
+            }
+        }
+    }
+#undef DECODE
+    return i;
+}
+
+}
@@ -0,0 +1,83 @@
+#ifndef _ZCM_STATS_H
+#define _ZCM_STATS_H
+
+#include "zcm/zcm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hot-path statistics. These are only collected when zcm is configured with
+   --use-stats; otherwise zcm_get_stats() always fails and nothing is measured.
+
+   Durations are kept in HDR-style log-linear histograms of nanoseconds: every
+   power of two is split into two buckets, so a value is known to within a
+   factor of 1.5. Bucket 0 and 1 hold exactly 0 and 1ns, and the last bucket
+   holds everything from ~3.2s up. All counters are updated without locks. */
+
+#define ZCM_STATS_HIST_BUCKETS 64
+#define ZCM_STATS_MAX_CHANNELS 128
+
+/* If the ZCM_STATS_PERIOD environment variable is set to a number of seconds,
+   the statistics are published on this channel at that period. See
+   zcm_stats_encode() for the message format */
+#define ZCM_STATS_CHANNEL "ZCM_STATS"
+
+enum zcm_stats_hist {
+    ZCM_STATS_PUBLISH_TO_SEND,   /* from zcm_publish() to the transport send */
+    ZCM_STATS_SEND,              /* time spent in the transport's sendmsg() */
+    ZCM_STATS_RECV_TO_DISPATCH,  /* from the transport's recvmsg() to dispatch */
+    ZCM_STATS_CALLBACK,          /* time spent in each subscription callback */
+    ZCM_STATS_NUM_HISTS
+};
+
+typedef struct zcm_stats_hist_t zcm_stats_hist_t;
+struct zcm_stats_hist_t
+{
+    uint64_t count;
+    uint64_t sum_ns;
+    uint64_t buckets[ZCM_STATS_HIST_BUCKETS];
+};
+
+typedef struct zcm_channel_stats_t zcm_channel_stats_t;
+struct zcm_channel_stats_t
+{
+    char channel[ZCM_CHANNEL_MAXLEN+1];
+    uint64_t pub_msgs;
+    uint64_t pub_bytes;
+    uint64_t recv_msgs;
+    uint64_t recv_bytes;
+    zcm_stats_hist_t hists[ZCM_STATS_NUM_HISTS];
+};
+
+/* Copies the statistics of up to 'max' channels into 'stats'.
+   Only the first ZCM_STATS_MAX_CHANNELS channels used by a zcm instance are tracked.
+   Returns the number of channels tracked (which may be more than 'max') on success,
+   and -1 if zcm was built without --use-stats
+   Does NOT set zcm errno on failure */
+int zcm_get_stats(zcm_t *zcm, zcm_channel_stats_t *stats, int max);
+
+/* Returns the histogram bucket that 'ns' falls in */
+int zcm_stats_bucket(uint64_t ns);
+
+/* Returns the smallest value that falls in 'bucket' */
+uint64_t zcm_stats_bucket_min(int bucket);
+
+/* Returns the (bucket_min of the) 'p'th percentile of a histogram, p in [0, 1].
+   Returns 0 for an empty histogram */
+uint64_t zcm_stats_percentile(const zcm_stats_hist_t *hist, double p);
+
+/* Encodes the statistics of 'n' channels into the message format published on
+   ZCM_STATS_CHANNEL. Only the channels that fit in 'maxlen' bytes are encoded.
+   Returns the number of bytes written */
+int zcm_stats_encode(const zcm_channel_stats_t *stats, int n, void *buf, int maxlen);
+
+/* Decodes up to 'max' channels from a ZCM_STATS_CHANNEL message.
+   Returns the number of channels decoded, or -1 if the message is malformed */
+int zcm_stats_decode(const void *buf, int len, zcm_channel_stats_t *stats, int max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ZCM_STATS_H */
@@ -0,0 +1,46 @@
+/* Internal interface used by the blocking and non-blocking apis to record statistics.
+   Users read them back with zcm_get_stats() from zcm/stats.h */
+#ifndef _ZCM_STATS_PRIVATE_H
+#define _ZCM_STATS_PRIVATE_H
+
+#include "zcm/stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct zcm_stats zcm_stats_t;
+typedef struct zcm_stats_channel zcm_stats_channel_t;
+
+/* 'mtu' bounds the size of the messages published on ZCM_STATS_CHANNEL */
+zcm_stats_t *zcm_stats_create(uint32_t mtu);
+void         zcm_stats_destroy(zcm_stats_t *s);
+
+/* Monotonic time in nanoseconds */
+uint64_t zcm_stats_now(void);
+
+/* Returns the entry for 'channel', creating it if needed.
+   Returns NULL if ZCM_STATS_MAX_CHANNELS are already tracked. All of the
+   recording functions below accept (and ignore) a NULL entry */
+zcm_stats_channel_t *zcm_stats_lookup(zcm_stats_t *s, const char *channel);
+
+void zcm_stats_count_publish(zcm_stats_channel_t *c, uint32_t len);
+void zcm_stats_count_recv(zcm_stats_channel_t *c, uint32_t len);
+void zcm_stats_record(zcm_stats_channel_t *c, enum zcm_stats_hist h, uint64_t ns);
+
+int zcm_stats_get(zcm_stats_t *s, zcm_channel_stats_t *stats, int max);
+
+/* Publishing period from the ZCM_STATS_PERIOD environment variable in seconds,
+   or 0 if the statistics should not be published */
+double zcm_stats_period(zcm_stats_t *s);
+
+/* If a period has elapsed since the last call that returned a message, encodes
+   the statistics into a buffer owned by 's' and returns its length. Returns 0
+   if no message is due. Not thread safe */
+int zcm_stats_poll_publish(zcm_stats_t *s, const char **buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ZCM_STATS_PRIVATE_H */
@@ -4,6 +4,7 @@
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <set>
 
 #include "cxxtest/TestSuite.h"
 
@@ -32,6 +33,19 @@ class MessageTrackerTest : public CxxTest::TestSuite
         virtual ~data_t() {}
     };
 
+    // Mirrors what `zcm-gen --cpp-lerp` emits
+    struct lerp_t {
+        uint64_t utime;
+        double pos[2];
+        virtual ~lerp_t() {}
+        static void lerp(const lerp_t& a, const lerp_t& b, double alpha, lerp_t& out)
+        {
+            out.utime = a.utime + (uint64_t)((b.utime - a.utime) * alpha + 0.5);
+            for (int i = 0; i < 2; ++i)
+                out.pos[i] = a.pos[i] + (b.pos[i] - a.pos[i]) * alpha;
+        }
+    };
+
     void testFreqStats()
     {
         constexpr size_t numMsgs = 1000;
@@ -194,6 +208,212 @@ class MessageTrackerTest : public CxxTest::TestSuite
          }
     }
 
+    void testGetTrackerInterpolatesWithLerp()
+    {
+        zcm::Tracker<lerp_t> mt(0.25, 10);
+        lerp_t a, b;
+        a.utime = 1000; a.pos[0] = 0; a.pos[1] = 10;
+        b.utime = 2000; b.pos[0] = 4; b.pos[1] = 30;
+        mt.newMsg(&a);
+        mt.newMsg(&b);
+
+        lerp_t out;
+        TS_ASSERT(mt.get(1250, out));
+        TS_ASSERT_EQUALS(out.utime, 1250);
+        TS_ASSERT_DELTA(out.pos[0], 1, 1e-9);
+        TS_ASSERT_DELTA(out.pos[1], 15, 1e-9);
+
+        lerp_t* p = mt.get(1500);
+        TS_ASSERT(p != nullptr);
+        if (p != nullptr)
+            TS_ASSERT_DELTA(p->pos[1], 20, 1e-9);
+        delete p;
+
+        TS_ASSERT(mt.get(2000, out));
+        TS_ASSERT_EQUALS(out.pos[0], 4);
+        TS_ASSERT(!mt.get(2000 + 1e6, out));
+    }
+
+    static data_t makeData(uint64_t utime, int bufInd)
+    {
+        data_t d;
+        d.utime = utime;
+        d.offset = 0;
+        d.bufInd = bufInd;
+        return d;
+    }
+
+    static vector<uint64_t> utimes(const zcm::Tracker<data_t>& mt)
+    {
+        vector<uint64_t> ret;
+        for (auto it = mt.cbegin(); it != mt.cend(); ++it) ret.push_back((*it)->utime);
+        return ret;
+    }
+
+    void testOutOfOrderInsert()
+    {
+        zcm::Tracker<data_t> mt(0.25, 10);
+        uint64_t order[] = { 10, 30, 20, 40, 25, 5, 30 };
+        for (int i = 0; i < 7; ++i) {
+            data_t d = makeData(order[i], i);
+            mt.newMsg(&d);
+        }
+        vector<uint64_t> expected = { 5, 10, 20, 25, 30, 30, 40 };
+        TS_ASSERT(utimes(mt) == expected);
+
+        // The most recently received message, not the one with the greatest utime
+        shared_ptr<const data_t> last = mt.getShared();
+        TS_ASSERT(last != nullptr);
+        if (last) TS_ASSERT_EQUALS(last->bufInd, 6);
+        data_t* copy = mt.get();
+        TS_ASSERT(copy != nullptr);
+        if (copy) TS_ASSERT_EQUALS(copy->bufInd, 6);
+        delete copy;
+
+        shared_ptr<const data_t> at = mt.getShared(25);
+        TS_ASSERT(at != nullptr);
+        if (at) TS_ASSERT_EQUALS(at->bufInd, 4);
+
+        // Once the most recent message is gone, it's the one with the greatest utime
+        mt.expireBefore(35);
+        last = mt.getShared();
+        TS_ASSERT(last != nullptr);
+        if (last) TS_ASSERT_EQUALS(last->bufInd, 3);
+    }
+
+    void testTimeJumpBackClearsFullBuffer()
+    {
+        zcm::Tracker<data_t> mt(0.25, 4);
+        for (int i = 0; i < 3; ++i) {
+            data_t d = makeData(100 + i, i);
+            mt.newMsg(&d);
+        }
+
+        // With room to spare, an old message is just sorted in
+        data_t d = makeData(50, 3);
+        mt.newMsg(&d);
+        vector<uint64_t> expected = { 50, 100, 101, 102 };
+        TS_ASSERT(utimes(mt) == expected);
+
+        // A newer message pushes out the oldest one
+        d = makeData(103, 4);
+        mt.newMsg(&d);
+        expected = { 100, 101, 102, 103 };
+        TS_ASSERT(utimes(mt) == expected);
+
+        // but one older than everything in a full buffer starts over
+        d = makeData(10, 5);
+        mt.newMsg(&d);
+        expected = { 10 };
+        TS_ASSERT(utimes(mt) == expected);
+        TS_ASSERT_EQUALS(mt.getShared()->bufInd, 5);
+    }
+
+    void testExpireBefore()
+    {
+        zcm::Tracker<data_t> mt(0.25, 10);
+        for (int i = 0; i < 10; ++i) {
+            data_t d = makeData(100 + i, i);
+            mt.newMsg(&d);
+        }
+
+        TS_ASSERT_EQUALS(mt.expireBefore(100), 0);
+        TS_ASSERT_EQUALS(mt.expireBefore(105), 5);
+        vector<uint64_t> expected = { 105, 106, 107, 108, 109 };
+        TS_ASSERT(utimes(mt) == expected);
+        TS_ASSERT_EQUALS(mt.expireBefore(105), 0);
+
+        // The freed slots are reused, wrapping around the ring
+        for (int i = 10; i < 15; ++i) {
+            data_t d = makeData(100 + i, i);
+            mt.newMsg(&d);
+        }
+        TS_ASSERT_EQUALS(utimes(mt).size(), 10);
+        TS_ASSERT_EQUALS(utimes(mt).front(), 105);
+        TS_ASSERT_EQUALS(utimes(mt).back(), 114);
+
+        TS_ASSERT_EQUALS(mt.expireBefore(1000), 10);
+        TS_ASSERT(utimes(mt).empty());
+        TS_ASSERT(mt.getShared() == nullptr);
+    }
+
+    void testSharedOutlivesEviction()
+    {
+        zcm::Tracker<data_t> mt(0.25, 2);
+        data_t d = makeData(100, 0);
+        mt.newMsg(&d);
+        shared_ptr<const data_t> held = mt.getShared(100);
+        vector<shared_ptr<const data_t>> range = mt.getRangeShared(0, 1000);
+        TS_ASSERT(held != nullptr);
+        TS_ASSERT_EQUALS(range.size(), 1);
+
+        // Push the held message out of the buffer, and keep the tracker busy long
+        // enough that it would have been recycled if it weren't held
+        for (int i = 1; i < 20; ++i) {
+            d = makeData(100 + i, i);
+            mt.newMsg(&d);
+            TS_ASSERT(mt.getShared().get() != held.get());
+        }
+        TS_ASSERT_EQUALS(mt.getRangeShared(100, 100).size(), 0);
+        TS_ASSERT_EQUALS(held->utime, 100);
+        TS_ASSERT_EQUALS(held->bufInd, 0);
+        TS_ASSERT_EQUALS(range[0].get(), held.get());
+    }
+
+    void testMessageRecycling()
+    {
+        constexpr size_t numMsgs = 4;
+        zcm::Tracker<data_t> mt(0.25, numMsgs);
+
+        // Once the buffer is full, evicted messages are reused for new ones, so
+        // only a handful of distinct messages are ever allocated
+        std::set<const data_t*> seen;
+        for (int i = 0; i < 100; ++i) {
+            data_t d = makeData(100 + i, i);
+            mt.newMsg(&d);
+            shared_ptr<const data_t> last = mt.getShared();
+            TS_ASSERT_EQUALS(last->bufInd, i);
+            seen.insert(last.get());
+        }
+        TS_ASSERT_LESS_THAN(seen.size(), numMsgs + 3);
+
+        // Clearing the buffer hands more messages back than are kept for reuse
+        data_t d = makeData(0, 100);
+        mt.newMsg(&d);
+        for (int i = 0; i < 100; ++i) {
+            d = makeData(1000 + i, i);
+            mt.newMsg(&d);
+            seen.insert(mt.getShared().get());
+            TS_ASSERT_EQUALS(mt.getShared()->bufInd, i);
+        }
+        TS_ASSERT_LESS_THAN(seen.size(), 2 * numMsgs + 3);
+    }
+
+    void testGetRangeSharedBounds()
+    {
+        zcm::Tracker<data_t> mt(0.25, 10);
+        uint64_t order[] = { 10, 20, 20, 30, 40 };
+        for (int i = 0; i < 5; ++i) {
+            data_t d = makeData(order[i], i);
+            mt.newMsg(&d);
+        }
+
+        // Both ends are inclusive, and every message at a bound is included
+        auto r = mt.getRangeShared(20, 30);
+        TS_ASSERT_EQUALS(r.size(), 3);
+        if (r.size() == 3) {
+            TS_ASSERT_EQUALS(r[0]->bufInd, 1);
+            TS_ASSERT_EQUALS(r[1]->bufInd, 2);
+            TS_ASSERT_EQUALS(r[2]->bufInd, 3);
+        }
+        TS_ASSERT_EQUALS(mt.getRangeShared(20, 20).size(), 2);
+        TS_ASSERT_EQUALS(mt.getRangeShared(21, 29).size(), 0);
+        TS_ASSERT_EQUALS(mt.getRangeShared(0, 9).size(), 0);
+        TS_ASSERT_EQUALS(mt.getRangeShared(41, 100).size(), 0);
+        TS_ASSERT_EQUALS(mt.getRangeShared(0, UINT64_MAX).size(), 5);
+        TS_ASSERT_EQUALS(mt.getRangeShared(30, 20).size(), 0);
+    }
+
     void testNoUtime()
     {
         struct test_t {
@@ -256,30 +476,116 @@ class MessageTrackerTest : public CxxTest::TestSuite
                 "", 1, 10,
                 cb);
 
+        zcm::ReceiveBuffer rbuf = {};
         std::stringstream ss;
 
         // Message type 2
         ss << "New message b: " << e1.utime; TS_TRACE(ss.str()); ss.str("");
-        smt.t2.newMsg(&e1, 0);
+        smt.t2.handle(&rbuf, "", &e1);
         ss << "New message b: " << e2.utime; TS_TRACE(ss.str()); ss.str("");
-        smt.t2.newMsg(&e2, 0);
+        smt.t2.handle(&rbuf, "", &e2);
 
         // Message type 1
         ss << "New message a: " << e3.utime; TS_TRACE(ss.str()); ss.str("");
-        smt.t1.newMsg(&e3, 0);
+        smt.t1.handle(&rbuf, "", &e3);
 
         // Message type 2
         ss << "New message b: " << e5.utime; TS_TRACE(ss.str()); ss.str("");
-        smt.t2.newMsg(&e5, 0);
+        smt.t2.handle(&rbuf, "", &e5);
         ss << "New message b: " << e6.utime; TS_TRACE(ss.str()); ss.str("");
-        smt.t2.newMsg(&e6, 0);
+        smt.t2.handle(&rbuf, "", &e6);
 
         // Message type 1
         ss << "New message a: " << e4.utime; TS_TRACE(ss.str()); ss.str("");
-        smt.t1.newMsg(&e4, 0);
+        smt.t1.handle(&rbuf, "", &e4);
         ss << "New message a: " << e7.utime; TS_TRACE(ss.str()); ss.str("");
-        smt.t2.newMsg(&e7, 0);
+        smt.t2.handle(&rbuf, "", &e7);
 
         TS_ASSERT_EQUALS(pairDetected, 2);
     }
+
+    void testSynchronizedMessageDispatcherOutOfOrder()
+    {
+        typedef zcm::MessageTracker<example_t> tracker;
+        vector<uint64_t> dispatched;
+        zcm::SynchronizedMessageDispatcher<tracker, tracker>::callback cb =
+        [&] (const example_t *a, example_t *b, void *usr) {
+            dispatched.push_back(a->utime);
+            delete b;
+        };
+
+        zcm::ZCM zcmL;
+        zcm::SynchronizedMessageDispatcher<tracker, tracker>
+            smt(&zcmL,
+                "",    10,
+                "", 1, 10,
+                cb);
+
+        // Go through handle(), as a subscription would, so the dispatcher sees the messages
+        zcm::ReceiveBuffer rbuf = {};
+        example_t e = {};
+        e.utime = 5; smt.t2.handle(&rbuf, "", &e);
+
+        // Nothing to pair this with yet, so it waits
+        e.utime = 8; smt.t1.handle(&rbuf, "", &e);
+        TS_ASSERT(dispatched.empty());
+
+        // An older message can be paired right away. It must be the one taken out
+        // of the buffer, not the pending one that has a greater utime
+        e.utime = 3; smt.t1.handle(&rbuf, "", &e);
+        TS_ASSERT_EQUALS(dispatched.size(), 1);
+
+        e.utime = 10; smt.t2.handle(&rbuf, "", &e);
+        vector<uint64_t> expected = { 3, 8 };
+        TS_ASSERT(dispatched == expected);
+    }
+
+    void testSynchronizedTracker()
+    {
+        struct other_t {
+            uint64_t utime;
+            virtual ~other_t() {}
+            int decode(void* data, int start, int max) { return 0; }
+            static const char* getTypeName() { return "other_t"; }
+        };
+
+        typedef zcm::MessageTracker<example_t> tracker1;
+        typedef zcm::MessageTracker<other_t> tracker2;
+
+        std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> matched;
+        std::vector<std::pair<size_t, uint64_t>> dropped;
+
+        zcm::SynchronizedTracker<tracker1, tracker2, tracker1> st(
+            nullptr, {{"", "", ""}}, 10e-6, 8,
+            [&] (std::shared_ptr<const example_t> a, std::shared_ptr<const other_t> b,
+                 std::shared_ptr<const example_t> c, void* usr) {
+                matched.emplace_back(a->utime, b->utime, c->utime);
+            });
+        st.setDropCallback([&] (size_t stream, uint64_t utime, void* usr) {
+            dropped.emplace_back(stream, utime);
+        });
+
+        zcm::ReceiveBuffer rbuf = {};
+        example_t e = {};
+        other_t o = {};
+
+        e.utime = 100; std::get<0>(st.trackers)->handle(&rbuf, "", &e);
+        o.utime = 103; std::get<1>(st.trackers)->handle(&rbuf, "", &o);
+        e.utime = 50;  std::get<2>(st.trackers)->handle(&rbuf, "", &e);
+        TS_ASSERT_EQUALS(matched.size(), 0);
+        TS_ASSERT_EQUALS(dropped.size(), 1);
+        TS_ASSERT_EQUALS(dropped[0].first, 2);
+        TS_ASSERT_EQUALS(dropped[0].second, 50);
+
+        e.utime = 105; std::get<2>(st.trackers)->handle(&rbuf, "", &e);
+        TS_ASSERT_EQUALS(matched.size(), 1);
+        TS_ASSERT_EQUALS(std::get<0>(matched[0]), 100);
+        TS_ASSERT_EQUALS(std::get<1>(matched[0]), 103);
+        TS_ASSERT_EQUALS(std::get<2>(matched[0]), 105);
+
+        // Messages are still available from the underlying trackers
+        std::shared_ptr<const other_t> last = st.getTracker<1>().getShared();
+        TS_ASSERT(last != nullptr);
+        if (last) TS_ASSERT_EQUALS(last->utime, 103);
+    }
 };
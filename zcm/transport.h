@@ -207,6 +207,12 @@ struct zcm_msg_t
     const char *channel;
     size_t len;
     char *buf;
+
+    /* Only set by recvmsg() on transports that carry the publisher's header
+       (e.g. 'udpm' or 'ipc' with timestamps=true). The caller zeroes these
+       before calling recvmsg(), so other transports can ignore them */
+    uint64_t pub_utime;  /* the 'utime' the message was sent with, 0 if unknown */
+    uint32_t seqno;      /* the publisher's sequence number, valid if pub_utime != 0 */
 };
 
 struct zcm_trans_t
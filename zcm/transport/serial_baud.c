@@ -0,0 +1,19 @@
+#include "zcm/transport/serial_baud.h"
+
+#include <asm/termbits.h>
+#include <asm/ioctls.h>
+#include <sys/ioctl.h>
+
+bool serial_set_custom_baud(int fd, int baud)
+{
+    struct termios2 opts;
+    if (ioctl(fd, TCGETS2, &opts))
+        return false;
+
+    opts.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    opts.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    opts.c_ispeed = baud;
+    opts.c_ospeed = baud;
+
+    return ioctl(fd, TCSETS2, &opts) == 0;
+}
@@ -0,0 +1,21 @@
+#ifndef ZCM_SERIAL_BAUD
+#define ZCM_SERIAL_BAUD
+
+// Sets baud rates that termios has no Bxxx constant for. The kernel's termios2
+// can't be declared alongside glibc's <termios.h>, so this lives in its own
+// translation unit that only includes the kernel headers.
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns true if the input and output speed of the tty 'fd' were set to 'baud'
+bool serial_set_custom_baud(int fd, int baud);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
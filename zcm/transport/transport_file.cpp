@@ -140,7 +140,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         msg->len = le->datalen;
         msg->buf = le->data;
 
-        u64 now = TimeUtil::utime();
+        u64 now = TimeUtil::monoUtime();
 
         if (lastMsgUtime == 0)
             lastMsgUtime = msg->utime;
@@ -156,7 +156,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         if (diff > 0)
             usleep(diff);
 
-        lastDispatchUtime = TimeUtil::utime();
+        lastDispatchUtime = TimeUtil::monoUtime();
         lastMsgUtime = msg->utime;
 
         return ZCM_EOK;
@@ -3,6 +3,7 @@
 #include "zcm/transport_register.hpp"
 #include "zcm/util/lockfile.h"
 #include "zcm/util/debug.h"
+#include "zcm/transport/serial_baud.h"
 
 #include "util/TimeUtil.hpp"
 
@@ -11,9 +12,12 @@
 #include <errno.h>
 #include <termios.h>
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <linux/serial.h>
 #include <linux/usbdevice_fs.h>
 
 #include <cassert>
+#include <climits>
 #include <cstring>
 
 #include <string>
@@ -35,6 +39,20 @@ using namespace std;
 
 #define US_TO_MS(a) (a)/1e3
 
+// epoll timeouts are whole milliseconds. Rounding up keeps a sub-millisecond
+// timeout from becoming 0, which would make the wait return immediately
+static inline int usToTimeoutMs(uint64_t us)
+{
+    uint64_t ms = (us + 999) / 1000;
+    return ms > INT_MAX ? INT_MAX : (int)ms;
+}
+
+// Worst case frame: sync (2) + channel len (1) + data len (4) + fully escaped
+// channel and data + checksum (2)
+#define SEND_BUF_SIZE (2 + 1 + 4 + 2 * (ZCM_CHANNEL_MAXLEN + MTU) + 2)
+#define RECV_BUF_SIZE 4096
+
+
 using u8  = uint8_t;
 using u16 = uint16_t;
 using u32 = uint32_t;
@@ -61,13 +79,15 @@ struct Serial
     Serial(){}
     ~Serial() { close(); }
 
-    bool open(const string& port, int baud, bool hwFlowControl);
+    bool open(const string& port, int baud, bool hwFlowControl, bool lowLatency);
     bool isOpen() { return fd > 0; };
     void close();
 
+    // Writes all of 'buf', waiting on the device to drain when it can't take any more
     int write(const u8 *buf, size_t sz);
-    int read(u8 *buf, size_t sz, u64 timeoutMs);
-    // Returns 0 on invalid input baud otherwise returns termios constant baud value
+    // Returns whatever is available (up to 'sz' bytes), waiting at most 'timeoutUs' for it
+    int read(u8 *buf, size_t sz, u64 timeoutUs);
+    // Returns 0 on non-standard input baud otherwise returns termios constant baud value
     static int convertBaud(int baud);
 
     Serial(const Serial&) = delete;
@@ -76,17 +96,26 @@ struct Serial
     Serial& operator=(Serial&&) = delete;
 
   private:
+    bool setLowLatency();
+
     string port;
     int fd = -1;
+    // Note: reads and writes happen on different threads, so each gets its own epoll set
+    int rdEpoll = -1;
+    int wrEpoll = -1;
 };
 
-bool Serial::open(const string& port_, int baud, bool hwFlowControl)
+bool Serial::open(const string& port_, int baud, bool hwFlowControl, bool lowLatency)
 {
+    int speed = 0;
     if (baud == 0) {
         fprintf(stderr, "Serial baud rate not specified in url. "
                         "Proceeding without setting baud\n");
-    } else if (!(baud = convertBaud(baud))) {
+    } else if (baud < 0) {
         return false;
+    } else {
+        // Note: a speed of 0 means the baud is non-standard and is set via termios2 below
+        speed = convertBaud(baud);
     }
 
     if (!lockfile_trylock(port_.c_str())) {
@@ -96,7 +125,7 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
     }
     this->port = port_;
 
-    int flags = O_RDWR | O_NOCTTY | O_SYNC;
+    int flags = O_RDWR | O_NOCTTY | O_NONBLOCK;
     fd = ::open(port.c_str(), flags, 0);
     if(fd < 0) {
         ZCM_DEBUG("failed to open serial device (%s): %s", port.c_str(), strerror(errno));
@@ -117,9 +146,9 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
         goto fail;
     }
 
-    if (baud != 0) {
-        cfsetispeed(&opts, baud);
-        cfsetospeed(&opts, baud);
+    if (speed != 0) {
+        cfsetispeed(&opts, speed);
+        cfsetospeed(&opts, speed);
     }
     cfmakeraw(&opts);
 
@@ -127,8 +156,10 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
     opts.c_cflag |= CS8;
     opts.c_cflag &= ~PARENB;
     if (hwFlowControl) opts.c_cflag |= CRTSCTS;
-    opts.c_cc[VTIME]    = 1;
-    opts.c_cc[VMIN]     = 30;
+    // Note: the fd is nonblocking, so these only ensure that a read() with no
+    //       data available returns EAGAIN rather than 0 (which means hangup)
+    opts.c_cc[VTIME]    = 0;
+    opts.c_cc[VMIN]     = 1;
 
     // set the new termios config
     if (tcsetattr(fd, TCSANOW, &opts)) {
@@ -136,11 +167,44 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
         goto fail;
     }
 
+    if (baud > 0 && speed == 0 && !serial_set_custom_baud(fd, baud)) {
+        ZCM_DEBUG("failed to set custom baud rate %d: %s", baud, strerror(errno));
+        goto fail;
+    }
+
+    // Not all serial drivers support this, so it is only a suggestion
+    if (lowLatency && !setLowLatency())
+        ZCM_DEBUG("failed to set low latency mode on fd: %s", strerror(errno));
+
+    rdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    wrEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if (rdEpoll < 0 || wrEpoll < 0) {
+        ZCM_DEBUG("failed to create epoll instance: %s", strerror(errno));
+        goto fail;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(rdEpoll, EPOLL_CTL_ADD, fd, &ev)) {
+        ZCM_DEBUG("failed to add serial fd to read epoll: %s", strerror(errno));
+        goto fail;
+    }
+    ev.events = EPOLLOUT;
+    if (epoll_ctl(wrEpoll, EPOLL_CTL_ADD, fd, &ev)) {
+        ZCM_DEBUG("failed to add serial fd to write epoll: %s", strerror(errno));
+        goto fail;
+    }
+
     tcflush(fd, TCIOFLUSH);
 
     return true;
 
  fail:
+    if (rdEpoll >= 0) ::close(rdEpoll);
+    if (wrEpoll >= 0) ::close(wrEpoll);
+    rdEpoll = wrEpoll = -1;
     // Close the port if it was opened
     if (fd > 0) {
         const int saved_errno = errno;
@@ -160,11 +224,25 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
     return false;
 }
 
+bool Serial::setLowLatency()
+{
+    struct serial_struct ss;
+    if (ioctl(fd, TIOCGSERIAL, &ss))
+        return false;
+
+    ss.flags |= ASYNC_LOW_LATENCY;
+
+    return ioctl(fd, TIOCSSERIAL, &ss) == 0;
+}
+
 void Serial::close()
 {
     if (isOpen()) {
         ZCM_DEBUG("Closing!\n");
+        ::close(rdEpoll);
+        ::close(wrEpoll);
         ::close(fd);
+        rdEpoll = wrEpoll = -1;
         fd = 0;
     }
     if (port != "") {
@@ -176,46 +254,75 @@ void Serial::close()
 int Serial::write(const u8 *buf, size_t sz)
 {
     assert(this->isOpen());
-    int ret = ::write(fd, buf, sz);
-    if (ret == -1) {
-        ZCM_DEBUG("ERR: write failed: %s", strerror(errno));
-        return -1;
+    size_t written = 0;
+    while (written < sz) {
+        int ret = ::write(fd, buf + written, sz - written);
+        if (ret > 0) {
+            written += ret;
+            continue;
+        }
+        if (ret == -1 && errno == EINTR)
+            continue;
+        if (ret == -1 && errno != EAGAIN) {
+            ZCM_DEBUG("ERR: write failed: %s", strerror(errno));
+            return -1;
+        }
+
+        // The device's output buffer is full, wait for it to drain
+        struct epoll_event ev;
+        int status = epoll_wait(wrEpoll, &ev, 1, -1);
+        if (status < 0 && errno != EINTR) {
+            ZCM_DEBUG("ERR: serial write wait failed: %s", strerror(errno));
+            return -1;
+        }
+        if (status > 0 && (ev.events & (EPOLLERR | EPOLLHUP))) {
+            ZCM_DEBUG("ERR: serial device unplugged");
+            return -1;
+        }
     }
-    return ret;
+    return written;
 }
 
 int Serial::read(u8 *buf, size_t sz, u64 timeoutUs)
 {
     assert(this->isOpen());
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(fd, &fds);
 
     u64 tOut = max((u64)SERIAL_TIMEOUT_US, timeoutUs);
 
-    struct timeval timeout;
-    timeout.tv_sec = tOut / 1000000;
-    timeout.tv_usec = tOut % 1000000;
-    int status = ::select(fd + 1, &fds, NULL, NULL, &timeout);
-
-    if (status > 0) {
-        if (FD_ISSET(fd, &fds)) {
-            int ret = ::read(fd, buf, sz);
-            if (ret == -1) {
-                ZCM_DEBUG("ERR: serial read failed: %s", strerror(errno));
-            } else if (ret == 0) {
-                ZCM_DEBUG("ERR: serial device unplugged");
-                close();
-                return -3;
-            }
+    while (true) {
+        int ret = ::read(fd, buf, sz);
+        if (ret > 0)
             return ret;
-        } else {
-            ZCM_DEBUG("ERR: serial bytes not ready");
+        if (ret == 0) {
+            ZCM_DEBUG("ERR: serial device unplugged");
+            close();
+            return -3;
+        }
+        if (errno == EINTR)
+            continue;
+        if (errno != EAGAIN) {
+            ZCM_DEBUG("ERR: serial read failed: %s", strerror(errno));
             return -1;
         }
-    } else {
-        ZCM_DEBUG("ERR: serial read timed out");
-        return -2;
+
+        // Nothing buffered by the driver, wait for more bytes to arrive
+        struct epoll_event ev;
+        int status = epoll_wait(rdEpoll, &ev, 1, usToTimeoutMs(tOut));
+        if (status == 0) {
+            ZCM_DEBUG("ERR: serial read timed out");
+            return -2;
+        }
+        if (status < 0) {
+            if (errno == EINTR)
+                continue;
+            ZCM_DEBUG("ERR: serial read wait failed: %s", strerror(errno));
+            return -1;
+        }
+        if (ev.events & (EPOLLERR | EPOLLHUP)) {
+            ZCM_DEBUG("ERR: serial device unplugged");
+            close();
+            return -3;
+        }
     }
 }
 
@@ -236,6 +343,10 @@ int Serial::convertBaud(int baud)
             return B115200;
         case 230400:
             return B230400;
+        case 460800:
+            return B460800;
+        case 921600:
+            return B921600;
         default:
             return 0;
     }
@@ -246,6 +357,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
     Serial ser;
     int baud;
     bool hwFlowControl;
+    bool lowLatency;
     string address;
 
     unordered_map<string, string> options;
@@ -258,6 +370,17 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
     u8 recvChannelMem[33];
     u8 recvDataMem[MTU];
 
+    // Bytes read from the device but not yet consumed. This persists across calls
+    // to recvmsg() so that any bytes read past the end of one message are kept
+    // for the next one
+    u8 recvBuf[RECV_BUF_SIZE];
+    size_t recvIndex = 0;
+    size_t recvSize = 0;
+
+    // Preallocated memory for assembling a whole frame before writing it out
+    // Note: sendmsg() is only ever called from the blocking send thread
+    u8 sendMem[SEND_BUF_SIZE];
+
     string *findOption(const string& s)
     {
         auto it = options.find(s);
@@ -309,8 +432,21 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             }
         }
 
+        lowLatency = false;
+        auto *lowLatencyStr = findOption("low_latency");
+        if (lowLatencyStr) {
+            if (*lowLatencyStr == "true") {
+                lowLatency = true;
+            } else if (*lowLatencyStr == "false") {
+                lowLatency = false;
+            } else {
+                ZCM_DEBUG("expected boolean argument for 'low_latency'");
+                return;
+            }
+        }
+
         address = zcm_url_address(url);
-        ser.open(address, baud, hwFlowControl);
+        ser.open(address, baud, hwFlowControl, lowLatency);
     }
 
     ~ZCM_TRANS_CLASSNAME()
@@ -337,18 +473,14 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         if (msg.len > MTU)
             return ZCM_EINVALID;
 
-        u8 buffer[1024];
+        // Note: the whole frame is assembled in memory and written out with a
+        //       single write() to minimize syscalls and inter-byte gaps
+        u8 *buffer = sendMem;
         size_t index = 0;
         u16 sum = 0xffff;
 
         auto writeBytes = [&](const u8 *data, size_t len) {
             for (size_t i = 0; i < len; ++i) {
-                // Less than 2 bytes of buffer left? Flush it.
-                if (index >= sizeof(buffer)-1) {
-                    int ret = ser.write(buffer, index);
-                    if (ret == -1) assert(false && "Serial port has been unplugged");
-                    index = 0;
-                }
                 u8 c = data[i];
                 sum = fletcherUpdate(c, sum);
                 // Escape byte?
@@ -362,16 +494,12 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         };
 
         auto finish = [&]() {
-            if (index != 0) {
-                int ret = ser.write(buffer, index);
-                if (ret == -1) assert(false && "Serial port has been unplugged");
-                index = 0;
-            }
-            uint8_t sumHigh = (sum >> 8) & 0xff;
-            uint8_t sumLow  =  sum       & 0xff;
-            uint8_t _sum[2] = {sumHigh, sumLow};
-            int ret = ser.write(_sum, 2);
+            buffer[index++] = (sum >> 8) & 0xff;
+            buffer[index++] =  sum       & 0xff;
+            assert(index <= SEND_BUF_SIZE);
+            int ret = ser.write(buffer, index);
             if (ret == -1) assert(false && "Serial port has been unplugged");
+            index = 0;
         };
 
         // Sync bytes are Escape and 1 zero
@@ -419,40 +547,38 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         while (true) {
             if (timeout < 0) return ZCM_EAGAIN;
 
-            u64 utimeRcvStart = TimeUtil::utime();
+            u64 utimeRcvStart = TimeUtil::monoUtime();
 
-            u8 buffer[1024];
-            size_t index = 0, size = 0;
             u16 sum = 0xffff;
             bool timedOut = false;
 
             auto refillBuffer = [&]() {
-                while (index == size) {
+                while (recvIndex == recvSize) {
                     int n = 0;
                     if (!ser.isOpen()) {
                         ZCM_DEBUG("serial closed. Attempting reopen");
-                        ser.open(address, baud, hwFlowControl);
+                        ser.open(address, baud, hwFlowControl, lowLatency);
                         usleep(timeout * 1e3);
                         assert(false && "Serial port has been unplugged");
                     } else {
-                        n = ser.read(buffer, sizeof(buffer), timeout * 1e3);
+                        n = ser.read(recvBuf, sizeof(recvBuf), timeout * 1e3);
                     }
                     if (n <= 0) {
                         ZCM_DEBUG("serial recvmsg: read timed out");
-                        size = 0;
-                        index = 0;
+                        recvSize = 0;
+                        recvIndex = 0;
                         timedOut = true;
                         break;
                     } else {
-                        index = 0;
-                        size = n;
+                        recvIndex = 0;
+                        recvSize = n;
                     }
                 }
             };
             auto readByte = [&](u8& b) {
-                if (index == size) refillBuffer();
-                if (size == 0) return false;
-                b = buffer[index++];
+                if (recvIndex == recvSize) refillBuffer();
+                if (recvSize == 0) return false;
+                b = recvBuf[recvIndex++];
                 return true;
             };
             auto readU32 = [&](u32& x) {
@@ -512,7 +638,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             if (!syncStream() || !readByte(channelLen) || !readU32(dataLen))
                 return ZCM_EAGAIN;
 
-            int diff = US_TO_MS(TimeUtil::utime() - utimeRcvStart);
+            int diff = US_TO_MS(TimeUtil::monoUtime() - utimeRcvStart);
 
             // Validate the lengths received
             if (channelLen > ZCM_CHANNEL_MAXLEN) {
@@ -538,7 +664,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             // Set the null-terminator
             recvChannelMem[channelLen] = '\0';
 
-            diff = US_TO_MS(TimeUtil::utime() - utimeRcvStart);
+            diff = US_TO_MS(TimeUtil::monoUtime() - utimeRcvStart);
 
             // Check the checksum
             if (!checkFinish()) {
@@ -616,6 +742,6 @@ static zcm_trans_t *create(zcm_url_t *url)
 // Register this transport with ZCM
 const TransportRegister ZCM_TRANS_CLASSNAME::reg(
     "serial", "Transfer data via a serial connection "
-              "(e.g. 'serial:///dev/ttyUSB0?baud=115200&hw_flow_control=true')",
+              "(e.g. 'serial:///dev/ttyUSB0?baud=115200&hw_flow_control=true&low_latency=true')",
     create);
 #endif
@@ -11,6 +11,7 @@
 
 #include <unistd.h>
 #include <dirent.h>
+#include <arpa/inet.h>
 
 #include <cstdio>
 #include <cstring>
@@ -33,6 +34,17 @@ using namespace std;
 #define ZMQ_IO_THREADS 1
 #define IPC_NAME_PREFIX "zcm-channel-zmq-ipc-"
 
+// With the 'timestamps' url option, every message is preceded by a frame
+// holding this header (sent with ZMQ_SNDMORE). All fields are big-endian
+#define STAMP_MAGIC 0x5a434d31 // hex repr of ascii "ZCM1"
+struct StampFrame
+{
+    uint32_t magic;
+    uint32_t seqno;
+    uint32_t utime_hi;
+    uint32_t utime_lo;
+};
+
 enum Type { IPC, INPROC, };
 
 struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
@@ -42,6 +54,9 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 
     string subnet;
 
+    bool stamped = false;
+    uint32_t seqno = 0;
+
     unordered_map<string, void*> pubsocks;
     // socket pair contains the socket + whether it was subscribed to explicitly or not
     unordered_map<string, pair<void*, bool>> subsocks;
@@ -67,6 +82,11 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 
         ZCM_DEBUG("IPC Address: %s\n", subnet.c_str());
 
+        auto *opts = zcm_url_opts(url);
+        for (size_t i = 0; i < opts->numopts; i++)
+            if (string(opts->name[i]) == "timestamps")
+                stamped = string(opts->value[i]) == "true";
+
         recvmsgBuffer = new char[recvmsgBufferSize];
 
         ctx = zmq_init(ZMQ_IO_THREADS);
@@ -258,6 +278,18 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         void *sock = pubsockFindOrCreate(channel);
         if (sock == nullptr)
             return ZCM_ECONNECT;
+        if (stamped) {
+            uint64_t utime = msg.utime ? msg.utime : TimeUtil::utime();
+            StampFrame st;
+            st.magic = htonl(STAMP_MAGIC);
+            st.seqno = htonl(seqno++);
+            st.utime_hi = htonl((uint32_t)(utime >> 32));
+            st.utime_lo = htonl((uint32_t)utime);
+            if (zmq_send(sock, &st, sizeof(st), ZMQ_SNDMORE) != sizeof(st)) {
+                ZCM_DEBUG("zmq_send failed with: %s", zmq_strerror(errno));
+                return ZCM_EUNKNOWN;
+            }
+        }
         int rc = zmq_send(sock, msg.buf, msg.len, 0);
         if (rc == (int)msg.len)
             return ZCM_EOK;
@@ -389,6 +421,30 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
                         // TODO: implement error handling, don't just assert
                         assert(0 && "unexpected codepath");
                     }
+
+                    // A multipart message means the publisher sent a stamp frame first
+                    int more = 0;
+                    size_t moreSize = sizeof(more);
+                    zmq_getsockopt(p.socket, ZMQ_RCVMORE, &more, &moreSize);
+                    if (more) {
+                        StampFrame st;
+                        bool valid = rc == (int)sizeof(st);
+                        if (valid) {
+                            memcpy(&st, recvmsgBuffer, sizeof(st));
+                            valid = ntohl(st.magic) == STAMP_MAGIC;
+                        }
+                        rc = zmq_recv(p.socket, recvmsgBuffer, recvmsgBufferSize, 0);
+                        if (rc == -1) {
+                            ZCM_DEBUG("zmq_recv failed with: %s", zmq_strerror(errno));
+                            return ZCM_EAGAIN;
+                        }
+                        if (!valid) {
+                            ZCM_DEBUG("dropping message with a malformed stamp frame");
+                            return ZCM_EAGAIN;
+                        }
+                        msg->pub_utime = ((uint64_t)ntohl(st.utime_hi) << 32) | ntohl(st.utime_lo);
+                        msg->seqno = ntohl(st.seqno);
+                    }
                     assert(0 < rc);
                     assert(rc < MTU && "Received message that is bigger than a legally-published message could be");
                     if (rc > (int)recvmsgBufferSize) {
@@ -5,6 +5,20 @@
 
 /************************* Packet Headers *******************/
 
+// Sent after the header by publishers that enable the 'timestamps' url option
+struct MsgHeaderStamp
+{
+    // Layout
+  private:
+    u32 utime_hi;
+    u32 utime_lo;
+
+    // Converted data
+  public:
+    u64  getUtime()         { return ((u64)ntohl(utime_hi) << 32) | ntohl(utime_lo); }
+    void setUtime(u64 v)    { utime_hi = htonl((u32)(v >> 32)); utime_lo = htonl((u32)v); }
+};
+
 struct MsgHeaderShort
 {
     // Layout
@@ -23,13 +37,17 @@ struct MsgHeaderShort
 
     // Computed data
   public:
-    // Note: Channel starts after the header
-    const char *getChannelPtr() { return (char*)(this+1); }
+    bool isStamped() { return getMagic() == ZCM_MAGIC_SHORT_STAMPED; }
+    size_t getStampLen() { return isStamped() ? sizeof(MsgHeaderStamp) : 0; }
+    MsgHeaderStamp *getStamp() { return (MsgHeaderStamp*)(this+1); }
+
+    // Note: Channel starts after the header (and stamp)
+    const char *getChannelPtr() { return (char*)(this+1) + getStampLen(); }
     size_t getChannelLen() { return strlen(getChannelPtr()); }
 
     // Note: Data starts after the channel and null
     char *getDataPtr() { return (char*)getChannelPtr() + getChannelLen() + 1; }
-    size_t getDataOffset() { return sizeof(*this) + getChannelLen() + 1; }
+    size_t getDataOffset() { return sizeof(*this) + getStampLen() + getChannelLen() + 1; }
     size_t getDataLen(size_t pktsz) { return pktsz - getDataOffset(); }
 };
 
@@ -56,11 +74,15 @@ struct MsgHeaderLong
 
     // Computed data
   public:
-    u32 getFragmentSize(size_t pktsz) { return pktsz - sizeof(*this); }
-    char *getDataPtr() { return (char*)(this+1); }
+    bool isStamped() { return getMagic() == ZCM_MAGIC_LONG_STAMPED; }
+    size_t getStampLen() { return (isStamped() && getFragmentNo() == 0) ? sizeof(MsgHeaderStamp) : 0; }
+    MsgHeaderStamp *getStamp() { return (MsgHeaderStamp*)(this+1); }
+
+    u32 getFragmentSize(size_t pktsz) { return pktsz - sizeof(*this) - getStampLen(); }
+    char *getDataPtr() { return (char*)(this+1) + getStampLen(); }
 };
 
-// if fragment_no == 0, then header is immediately followed by NULL-terminated
+// if fragment_no == 0, then header (and stamp) is immediately followed by NULL-terminated
 // ASCII-encoded channel name, followed by the payload data
 // if fragment_no > 0, then header is immediately followed by the payload data
 
@@ -95,6 +117,8 @@ struct Buffer
 struct Message
 {
     i64               utime;       // timestamp of first datagram receipt
+    u64               pub_utime;   // publisher's timestamp, 0 if not stamped
+    u32               msg_seqno;
 
     const char       *channel;     // points into 'buf'
     size_t            channellen;  // length of channel
@@ -128,6 +152,7 @@ struct Packet
 struct FragBuf
 {
     i64     last_packet_utime;
+    u64     pub_utime;
     u32     msg_seqno;
     u16     fragments_remaining;
 
@@ -11,9 +11,7 @@
 
 static i32 utimeInSeconds()
 {
-    struct timeval tv;
-    gettimeofday (&tv, NULL);
-    return (i32)tv.tv_sec;
+    return (i32)(TimeUtil::monoUtime() / 1000000);
 }
 
 /**
@@ -26,6 +24,8 @@ static i32 utimeInSeconds()
  *                  don't use > 1.  that's just rude.
  * @recv_buf_size:  requested size of the kernel receive buffer, set with
  *                  SO_RCVBUF.  0 indicates to use the default settings.
+ * @stamped:        if true, each message carries the publisher's timestamp.
+ *                  Receivers without support for this will drop the messages
  *
  */
 struct Params
@@ -35,8 +35,9 @@ struct Params
     u16            port;
     u8             ttl;
     size_t         recv_buf_size;
+    bool           stamped;
 
-    Params(const string& ip, u16 port, size_t recv_buf_size, u8 ttl)
+    Params(const string& ip, u16 port, size_t recv_buf_size, u8 ttl, bool stamped)
     {
         // TODO verify that the IP and PORT are vaild
         this->ip = ip;
@@ -44,6 +45,7 @@ struct Params
         this->port = port;
         this->recv_buf_size = recv_buf_size;
         this->ttl = ttl;
+        this->stamped = stamped;
     }
 };
 
@@ -72,7 +74,7 @@ struct UDPM
     u32          msg_seqno = 0; // rolling counter of how many messages transmitted
 
     /***** Methods ******/
-    UDPM(const string& ip, u16 port, size_t recv_buf_size, u8 ttl);
+    UDPM(const string& ip, u16 port, size_t recv_buf_size, u8 ttl, bool stamped);
     bool init();
     ~UDPM();
 
@@ -97,6 +99,12 @@ Message *UDPM::recvShort(Packet *pkt, u32 sz)
 {
     MsgHeaderShort *hdr = pkt->asHeaderShort();
 
+    if (sz < sizeof(*hdr) + hdr->getStampLen()) {
+        ZCM_DEBUG("packet too short for its header");
+        udp_discarded_bad++;
+        return NULL;
+    }
+
     size_t clen = hdr->getChannelLen();
     if (clen > ZCM_CHANNEL_MAXLEN) {
         ZCM_DEBUG("bad channel name length");
@@ -108,6 +116,8 @@ Message *UDPM::recvShort(Packet *pkt, u32 sz)
 
     Message *msg = pool.allocMessageEmpty();
     msg->utime = pkt->utime;
+    msg->pub_utime = hdr->isStamped() ? hdr->getStamp()->getUtime() : 0;
+    msg->msg_seqno = hdr->getMsgSeqno();
     msg->channel = hdr->getChannelPtr();
     msg->channellen = clen;
     msg->data = hdr->getDataPtr();
@@ -120,6 +130,11 @@ Message *UDPM::recvShort(Packet *pkt, u32 sz)
 Message *UDPM::recvFragment(Packet *pkt, u32 sz)
 {
     MsgHeaderLong *hdr = pkt->asHeaderLong();
+    if (sz < sizeof(*hdr) + hdr->getStampLen()) {
+        ZCM_DEBUG("packet too short for its header");
+        udp_discarded_bad++;
+        return NULL;
+    }
 
     // any existing fragment buffer for this message source?
     FragBuf *fbuf = pool.lookupFragBuf((struct sockaddr_in*)&pkt->from);
@@ -147,7 +162,7 @@ Message *UDPM::recvFragment(Packet *pkt, u32 sz)
 
     // create a new fragment buffer if necessary
     if (!fbuf && fragment_no == 0) {
-        char *channel = (char*) (hdr + 1);
+        char *channel = data_start;
         int channel_sz = strlen(channel);
         if (channel_sz > ZCM_CHANNEL_MAXLEN) {
             ZCM_DEBUG("bad channel name length");
@@ -157,6 +172,7 @@ Message *UDPM::recvFragment(Packet *pkt, u32 sz)
 
         fbuf = pool.addFragBuf(channel_sz + 1 + data_size);
         fbuf->last_packet_utime = pkt->utime;
+        fbuf->pub_utime = hdr->isStamped() ? hdr->getStamp()->getUtime() : 0;
         fbuf->msg_seqno = msg_seqno;
         fbuf->fragments_remaining = fragments_in_msg;
         fbuf->channellen = channel_sz;
@@ -187,6 +203,8 @@ Message *UDPM::recvFragment(Packet *pkt, u32 sz)
     // we've received all the fragments, return a new Message
     Message *msg = pool.allocMessageEmpty();
     msg->utime = fbuf->last_packet_utime;
+    msg->pub_utime = fbuf->pub_utime;
+    msg->msg_seqno = fbuf->msg_seqno;
     msg->channel = fbuf->buf.data;
     msg->channellen = fbuf->channellen;
     msg->data = fbuf->buf.data + fbuf->channellen + 1;
@@ -258,9 +276,9 @@ Message *UDPM::readMessage(int timeout)
         }
 
         u32 magic = pkt->asHeaderShort()->getMagic();
-        if (magic == ZCM_MAGIC_SHORT)
+        if (magic == ZCM_MAGIC_SHORT || magic == ZCM_MAGIC_SHORT_STAMPED)
             msg = recvShort(pkt, sz);
-        else if (magic == ZCM_MAGIC_LONG)
+        else if (magic == ZCM_MAGIC_LONG || magic == ZCM_MAGIC_LONG_STAMPED)
             msg = recvFragment(pkt, sz);
         else {
             ZCM_DEBUG("ZCM: bad magic");
@@ -281,20 +299,25 @@ int UDPM::sendmsg(zcm_msg_t msg)
         return ZCM_EINVALID;
     }
 
-    int payload_size = channel_size + 1 + msg.len;
+    int stamp_size = params.stamped ? sizeof(MsgHeaderStamp) : 0;
+    u64 pub_utime = msg.utime ? msg.utime : TimeUtil::utime();
+
+    int payload_size = stamp_size + channel_size + 1 + msg.len;
     if (payload_size <= ZCM_SHORT_MESSAGE_MAX_SIZE) {
         // message is short.  send in a single packet
 
-        MsgHeaderShort hdr;
-        hdr.setMagic(ZCM_MAGIC_SHORT);
-        hdr.setMsgSeqno(msg_seqno);
+        // Note: the stamp directly follows the header in memory, so they go out as one buffer
+        struct { MsgHeaderShort hdr; MsgHeaderStamp stamp; } pre;
+        pre.hdr.setMagic(params.stamped ? ZCM_MAGIC_SHORT_STAMPED : ZCM_MAGIC_SHORT);
+        pre.hdr.setMsgSeqno(msg_seqno);
+        pre.stamp.setUtime(pub_utime);
 
         ssize_t status = sendfd.sendBuffers(destAddr,
-                              (char*)&hdr, sizeof(hdr),
+                              (char*)&pre, sizeof(pre.hdr) + stamp_size,
                               (char*)msg.channel, channel_size+1,
                               msg.buf, msg.len);
 
-        int packet_size = sizeof(hdr) + payload_size;
+        int packet_size = sizeof(pre.hdr) + payload_size;
         ZCM_DEBUG("transmitting %zu byte [%s] payload (%d byte pkt)",
                   msg.len, msg.channel, packet_size);
         msg_seqno++;
@@ -323,23 +346,25 @@ int UDPM::sendmsg(zcm_msg_t msg)
 
         u32 fragment_offset = 0;
 
-        MsgHeaderLong hdr;
-        hdr.magic = htonl(ZCM_MAGIC_LONG);
+        struct { MsgHeaderLong hdr; MsgHeaderStamp stamp; } pre;
+        MsgHeaderLong& hdr = pre.hdr;
+        hdr.magic = htonl(params.stamped ? ZCM_MAGIC_LONG_STAMPED : ZCM_MAGIC_LONG);
         hdr.msg_seqno = htonl(msg_seqno);
         hdr.msg_size = htonl(msg.len);
         hdr.fragment_offset = 0;
         hdr.fragment_no = 0;
         hdr.fragments_in_msg = htons(nfragments);
+        pre.stamp.setUtime(pub_utime);
 
-        // first fragment is special.  insert channel before data
-        size_t firstfrag_datasize = fragment_size - (channel_size + 1);
+        // first fragment is special.  insert stamp and channel before data
+        size_t firstfrag_datasize = fragment_size - (stamp_size + channel_size + 1);
         assert(firstfrag_datasize <= msg.len);
 
-        int packet_size = sizeof(hdr) + (channel_size + 1) + firstfrag_datasize;
+        int packet_size = sizeof(hdr) + stamp_size + (channel_size + 1) + firstfrag_datasize;
         fragment_offset += firstfrag_datasize;
 
         ssize_t status = sendfd.sendBuffers(destAddr,
-                                            (char*)&hdr, sizeof(hdr),
+                                            (char*)&pre, sizeof(hdr) + stamp_size,
                                             (char*)msg.channel, channel_size+1,
                                             msg.buf, firstfrag_datasize);
 
@@ -381,6 +406,8 @@ int UDPM::recvmsg(zcm_msg_t *msg, int timeout)
     msg->channel = m->channel;
     msg->len = m->datalen;
     msg->buf = m->data;
+    msg->pub_utime = m->pub_utime;
+    msg->seqno = m->msg_seqno;
 
     return ZCM_EOK;
 }
@@ -388,10 +415,12 @@ int UDPM::recvmsg(zcm_msg_t *msg, int timeout)
 UDPM::~UDPM()
 {
     ZCM_DEBUG("closing zcm context");
+    // The last message handed out by recvmsg() is only freed by the next call
+    if (m) pool.freeMessage(m);
 }
 
-UDPM::UDPM(const string& ip, u16 port, size_t recv_buf_size, u8 ttl)
-    : params(ip, port, recv_buf_size, ttl),
+UDPM::UDPM(const string& ip, u16 port, size_t recv_buf_size, u8 ttl, bool stamped)
+    : params(ip, port, recv_buf_size, ttl, stamped),
       destAddr(ip, port)
 {
 }
@@ -436,8 +465,8 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 {
     UDPM udpm;
 
-    ZCM_TRANS_CLASSNAME(const string& ip, u16 port, size_t recv_buf_size, u8 ttl)
-        : udpm(ip, port, recv_buf_size, ttl)
+    ZCM_TRANS_CLASSNAME(const string& ip, u16 port, size_t recv_buf_size, u8 ttl, bool stamped)
+        : udpm(ip, port, recv_buf_size, ttl, stamped)
     {
         trans_type = ZCM_BLOCKING;
         vtbl = &methods;
@@ -523,8 +552,11 @@ static zcm_trans_t *createUdpm(zcm_url_t *url)
         ZCM_DEBUG("No ttl specified. Using default ttl=0");
         ttl = "0";
     }
+    auto *timestamps = optFind(opts, "timestamps");
+    bool stamped = timestamps && string(timestamps) == "true";
     size_t recv_buf_size = 1024;
-    auto *trans = new ZCM_TRANS_CLASSNAME(address, atoi(port.c_str()), recv_buf_size, atoi(ttl));
+    auto *trans = new ZCM_TRANS_CLASSNAME(address, atoi(port.c_str()), recv_buf_size, atoi(ttl),
+                                          stamped);
     if (!trans->init()) {
         delete trans;
         return nullptr;
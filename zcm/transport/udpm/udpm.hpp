@@ -40,7 +40,7 @@ typedef int SOCKET;
 #endif
 
 // Misc. Compatability
-#ifdef SO_TIMESTAMP
+#if defined(SO_TIMESTAMPNS) || defined(SO_TIMESTAMP)
 # define MSG_EXT_HDR
 #endif
 
@@ -67,6 +67,7 @@ typedef int SOCKET;
 // Headers for ZCM API
 #include "zcm/transport.h"
 #include "zcm/util/debug.h"
+#include "util/TimeUtil.hpp"
 
 // Useful integer typedefs
 typedef uint8_t  u8;
@@ -88,6 +89,11 @@ typedef int64_t  i64;
 #define ZCM_MAGIC_SHORT 0x4c433032   // hex repr of ascii "LC02"
 #define ZCM_MAGIC_LONG  0x4c433033   // hex repr of ascii "LC03"
 
+// Same as above, but the header is followed by a MsgHeaderStamp
+// (only in the first fragment of a long message)
+#define ZCM_MAGIC_SHORT_STAMPED 0x5a434d31   // hex repr of ascii "ZCM1"
+#define ZCM_MAGIC_LONG_STAMPED  0x5a434d32   // hex repr of ascii "ZCM2"
+
 #ifdef __APPLE__
 # define ZCM_SHORT_MESSAGE_MAX_SIZE 1435
 # define ZCM_FRAGMENT_MAX_PAYLOAD 1423
@@ -167,11 +167,21 @@ bool UDPMSocket::setReusePort()
 
 bool UDPMSocket::enablePacketTimestamp()
 {
-    /* Enable per-packet timestamping by the kernel, if available */
-#ifdef SO_TIMESTAMP
+    /* Enable per-packet timestamping by the kernel, if available. A kernel may
+       know SO_TIMESTAMPNS at compile time and still refuse it, so fall back to
+       microsecond stamps. Without either, recvPacket() stamps packets itself */
     int opt = 1;
-    setsockopt(fd, SOL_SOCKET, SO_TIMESTAMP, &opt, sizeof(opt));
+#if defined(SO_TIMESTAMPNS)
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &opt, sizeof(opt)) == 0)
+        return true;
+    ZCM_DEBUG("setsockopt (SOL_SOCKET, SO_TIMESTAMPNS) failed: %s", strerror(errno));
+#endif
+#if defined(SO_TIMESTAMP)
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMP, &opt, sizeof(opt)) == 0)
+        return true;
+    ZCM_DEBUG("setsockopt (SOL_SOCKET, SO_TIMESTAMP) failed: %s", strerror(errno));
 #endif
+    (void)opt;
     return true;
 }
 
@@ -258,26 +268,37 @@ int UDPMSocket::recvPacket(Packet *pkt)
     pkt->fromlen = msg.msg_namelen;
 
     bool got_utime = false;
-#ifdef SO_TIMESTAMP
+#if defined(SO_TIMESTAMPNS) || defined(SO_TIMESTAMP)
     struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
     /* Get the receive timestamp out of the packet headers if possible */
-    while (!pkt->utime && cmsg) {
-        if (cmsg->cmsg_level == SOL_SOCKET &&
-            cmsg->cmsg_type == SCM_TIMESTAMP) {
-            struct timeval *t = (struct timeval*) CMSG_DATA (cmsg);
-            pkt->utime = (int64_t) t->tv_sec * 1000000 + t->tv_usec;
-            got_utime = true;
-            break;
+    while (ret >= 0 && cmsg) {
+        if (cmsg->cmsg_level == SOL_SOCKET) {
+            // Either kind of stamp, depending on what enablePacketTimestamp() got
+# if defined(SO_TIMESTAMPNS)
+            if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                struct timespec t;
+                memcpy(&t, CMSG_DATA(cmsg), sizeof(t));
+                pkt->utime = (i64)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+                got_utime = true;
+                break;
+            }
+# endif
+# if defined(SO_TIMESTAMP)
+            if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+                struct timeval t;
+                memcpy(&t, CMSG_DATA(cmsg), sizeof(t));
+                pkt->utime = (i64)t.tv_sec * 1000000 + t.tv_usec;
+                got_utime = true;
+                break;
+            }
+# endif
         }
         cmsg = CMSG_NXTHDR(&msg, cmsg);
     }
 #endif
 
-    if (!got_utime) {
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        pkt->utime = (i64)tv.tv_sec * 1000000 + tv.tv_usec;
-    }
+    if (!got_utime)
+        pkt->utime = TimeUtil::utime();
 
     return ret;
 }
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "zcm/zcm.h"
+
+// A thread-safe free-list of heap buffers. Buffers handed back to the pool keep
+// their capacity, so once the pool has warmed up to the working set of message
+// sizes, get() and put() do not touch the heap.
+// Note: at most 'maxBuffers' buffers are retained, any extras are freed
+class BufferPool
+{
+    struct Buffer
+    {
+        char  *data;
+        size_t cap;
+    };
+
+    std::mutex mut;
+    std::vector<Buffer> freeList;
+    size_t maxBuffers;
+
+  public:
+    BufferPool(size_t maxBuffers) : maxBuffers(maxBuffers)
+    {
+        freeList.reserve(maxBuffers);
+    }
+
+    ~BufferPool()
+    {
+        for (auto& b : freeList)
+            free(b.data);
+    }
+
+    // Returns a buffer of at least 'len' bytes and sets 'cap' to its true capacity
+    char *get(size_t len, size_t& cap)
+    {
+        Buffer b = {nullptr, 0};
+        {
+            std::unique_lock<std::mutex> lk(mut);
+            // Prefer a buffer that's already large enough
+            for (size_t i = freeList.size(); i > 0; --i) {
+                if (freeList[i-1].cap >= len) {
+                    b = freeList[i-1];
+                    freeList[i-1] = freeList.back();
+                    freeList.pop_back();
+                    break;
+                }
+            }
+            if (!b.data && !freeList.empty()) {
+                b = freeList.back();
+                freeList.pop_back();
+            }
+        }
+
+        if (b.cap < len) {
+            // Note: realloc would needlessly copy the old contents
+            free(b.data);
+            // Always allocate at least one byte so that we can distinguish an
+            // empty message from an allocation failure
+            b.cap = len > 0 ? len : 1;
+            b.data = (char*) malloc(b.cap);
+            ZCM_ASSERT(b.data);
+        }
+
+        cap = b.cap;
+        return b.data;
+    }
+
+    // Returns any free buffer without allocating, or NULL if there are none
+    char *take(size_t& cap)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        if (freeList.empty()) return nullptr;
+        Buffer b = freeList.back();
+        freeList.pop_back();
+        cap = b.cap;
+        return b.data;
+    }
+
+    void put(char *data, size_t cap)
+    {
+        if (!data) return;
+        {
+            std::unique_lock<std::mutex> lk(mut);
+            if (freeList.size() < maxBuffers) {
+                freeList.push_back({data, cap});
+                return;
+            }
+        }
+        free(data);
+    }
+
+  private:
+    BufferPool(const BufferPool& other) = delete;
+    BufferPool(BufferPool&& other) = delete;
+    BufferPool& operator=(const BufferPool& other) = delete;
+    BufferPool& operator=(BufferPool&& other) = delete;
+};
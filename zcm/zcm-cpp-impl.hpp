@@ -98,9 +98,39 @@ inline int ZCM::publish(const std::string& channel, const char* data, uint32_t l
     return publishRaw(channel, data, len);
 }
 
+#if __cplusplus > 199711L && !defined(ZCM_EMBEDDED)
+// Returns a per-thread scratch buffer of at least 'len' bytes and sets 'cap' to its
+// full size. The buffer only ever grows, so steady state typed publishing does not
+// touch the heap.
+// Note: the returned buffer is only valid until the next call on the same thread
+inline uint8_t* ZCM::publishScratch(uint32_t len, uint32_t& cap)
+{
+    static thread_local std::vector<uint8_t> scratch;
+    if (scratch.size() < len)
+        scratch.resize(len);
+    cap = scratch.size();
+    return scratch.data();
+}
+#endif
+
 template <class Msg>
 inline int ZCM::publish(const std::string& channel, const Msg* msg)
 {
+#if __cplusplus > 199711L && !defined(ZCM_EMBEDDED)
+    // Encode straight into the scratch buffer and only size the message (a full
+    // extra pass over it) when it does not fit, so steady state publishing walks
+    // the message once.
+    // Note: publishRaw() is required to copy the data before returning
+    uint32_t cap;
+    uint8_t* buf = publishScratch(0, cap);
+    int len = msg->encode(buf, 0, cap);
+    if (len < 0) {
+        buf = publishScratch(msg->getEncodedSize(), cap);
+        len = msg->encode(buf, 0, cap);
+        if (len < 0) return ZCM_EINVALID;
+    }
+    return publishRaw(channel, (const char*)buf, len);
+#else
     uint32_t len = msg->getEncodedSize();
     uint8_t* buf = new uint8_t[len];
     ZCM_ASSERT(buf);
@@ -108,6 +138,32 @@ inline int ZCM::publish(const std::string& channel, const Msg* msg)
     int status = publishRaw(channel, (const char*)buf, len);
     delete[] buf;
     return status;
+#endif
+}
+
+inline void* ZCM::publishReserve(const std::string& channel, uint32_t len)
+{
+    return zcm_publish_reserve(zcm, channel.c_str(), len);
+}
+
+inline int ZCM::publishCommit(void* buf)
+{
+    return zcm_publish_commit(zcm, buf);
+}
+
+inline int ZCM::publishAbort(void* buf)
+{
+    return zcm_publish_abort(zcm, buf);
+}
+
+inline int ZCM::forward(const std::string& channel, const ReceiveBuffer* rbuf)
+{
+    return zcm_forward(zcm, channel.c_str(), rbuf);
+}
+
+inline int ZCM::forward(const char* channel, const ReceiveBuffer* rbuf)
+{
+    return zcm_forward(zcm, channel, rbuf);
 }
 
 inline Subscription* ZCM::subscribe(const std::string& channel,
@@ -210,8 +266,102 @@ class TypedFunctionalSubscription : public virtual Subscription
         ((TypedFunctionalSubscription<Msg>*)usr)->typedDispatch(rbuf, channel);
     }
 };
+
+// Virtual inheritance to avoid ambiguous base class problem http://stackoverflow.com/a/139329
+template<class Msg>
+class SharedTypedSubscription : public virtual Subscription
+{
+    friend class ZCM;
+
+  protected:
+    void (*sharedCallback)(const ReceiveBuffer* rbuf, const std::string& channel,
+                           std::shared_ptr<const Msg> msg, void* usr);
+    // The pool holds one reference to each of its messages. A message is free when that is
+    // the only reference left. Reusing messages keeps their vector and string capacities warm,
+    // so steady state decoding does not allocate.
+    std::vector<std::shared_ptr<Msg>> pool;
+    size_t maxPooled;
+    size_t nextFree = 0;
+
+  public:
+    virtual ~SharedTypedSubscription() {}
+
+    inline std::shared_ptr<Msg> acquire()
+    {
+        for (size_t i = 0; i < pool.size(); ++i) {
+            size_t idx = (nextFree + i) % pool.size();
+            if (pool[idx].use_count() == 1) {
+                // The last outside reference may have been dropped on another thread.
+                // Pairs with the release done by that thread's decrement
+                std::atomic_thread_fence(std::memory_order_acquire);
+                nextFree = idx + 1;
+                return pool[idx];
+            }
+        }
+        std::shared_ptr<Msg> msg = std::make_shared<Msg>();
+        if (pool.size() < maxPooled) pool.push_back(msg);
+        return msg;
+    }
+
+    inline std::shared_ptr<const Msg> readMsg(const ReceiveBuffer* rbuf)
+    {
+        std::shared_ptr<Msg> msg = acquire();
+        int status = msg->decode(rbuf->data, 0, rbuf->data_size);
+        if (status < 0) {
+            #ifndef ZCM_EMBEDDED
+            fprintf (stderr, "error %d decoding %s!!!\n", status, Msg::getTypeName());
+            #endif
+            return nullptr;
+        }
+        return msg;
+    }
+
+    inline void sharedDispatch(const ReceiveBuffer* rbuf, const std::string& channel)
+    {
+        std::shared_ptr<const Msg> msg = readMsg(rbuf);
+        if (!msg) return;
+        (*sharedCallback)(rbuf, channel, std::move(msg), usr);
+    }
+
+    static inline void dispatch(const ReceiveBuffer* rbuf, const char* channel, void* usr)
+    {
+        ((SharedTypedSubscription<Msg>*)usr)->sharedDispatch(rbuf, channel);
+    }
+};
 #endif
 
+// Virtual inheritance to avoid ambiguous base class problem http://stackoverflow.com/a/139329
+template<class View>
+class ViewSubscription : public virtual Subscription
+{
+    friend class ZCM;
+
+  protected:
+    void (*viewCallback)(const ReceiveBuffer* rbuf, const std::string& channel, const View& view,
+                         void* usr);
+    View viewMem; // Points into the receive buffer while the callback runs
+
+  public:
+    virtual ~ViewSubscription() {}
+
+    inline void viewDispatch(const ReceiveBuffer* rbuf, const std::string& channel)
+    {
+        int status = viewMem.decode(rbuf->data, 0, rbuf->data_size);
+        if (status < 0) {
+            #ifndef ZCM_EMBEDDED
+            fprintf (stderr, "error %d decoding %s!!!\n", status, View::getTypeName());
+            #endif
+            return;
+        }
+        (*viewCallback)(rbuf, channel, viewMem, usr);
+    }
+
+    static inline void dispatch(const ReceiveBuffer* rbuf, const char* channel, void* usr)
+    {
+        ((ViewSubscription<View>*)usr)->viewDispatch(rbuf, channel);
+    }
+};
+
 // Virtual inheritance to avoid ambiguous base class problem http://stackoverflow.com/a/139329
 template <class Handler>
 class HandlerSubscription : public virtual Subscription
@@ -263,6 +413,33 @@ class TypedHandlerSubscription : public TypedSubscription<Msg>, HandlerSubscript
 
 };
 
+#if __cplusplus > 199711L
+template <class Msg, class Handler>
+class SharedTypedHandlerSubscription : public SharedTypedSubscription<Msg>, HandlerSubscription<Handler>
+{
+    friend class ZCM;
+
+  protected:
+    void (Handler::*sharedHandlerCallback)(const ReceiveBuffer* rbuf, const std::string& channel,
+                                           std::shared_ptr<const Msg> msg);
+
+  public:
+    virtual ~SharedTypedHandlerSubscription() {}
+
+    inline void sharedHandlerDispatch(const ReceiveBuffer* rbuf, const std::string& channel)
+    {
+        std::shared_ptr<const Msg> msg = this->readMsg(rbuf);
+        if (!msg) return;
+        (this->handler->*sharedHandlerCallback)(rbuf, channel, std::move(msg));
+    }
+
+    static inline void dispatch(const ReceiveBuffer* rbuf, const char* channel, void* usr)
+    {
+        ((SharedTypedHandlerSubscription<Msg, Handler>*)usr)->sharedHandlerDispatch(rbuf, channel);
+    }
+};
+#endif
+
 // TODO: lots of room to condense the implementations of the various subscribe functions
 template <class Msg, class Handler>
 inline Subscription* ZCM::subscribe(const std::string& channel,
@@ -362,8 +539,87 @@ inline Subscription* ZCM::subscribe(const std::string& channel,
     subscriptions.push_back(sub);
     return sub;
 }
+
+template <class Msg>
+inline Subscription* ZCM::subscribe(const std::string& channel,
+                                    void (*cb)(const ReceiveBuffer* rbuf,
+                                               const std::string& channel,
+                                               std::shared_ptr<const Msg> msg, void* usr),
+                                    void* usr, size_t poolSize)
+{
+    if (!zcm) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr, "ZCM instance not initialized.  Ignoring call to subscribe()\n");
+        #endif
+        return nullptr;
+    }
+
+    typedef SharedTypedSubscription<Msg> SubType;
+    SubType* sub = new SubType();
+    ZCM_ASSERT(sub);
+    sub->usr = usr;
+    sub->sharedCallback = cb;
+    sub->maxPooled = poolSize;
+    sub->pool.reserve(poolSize);
+    subscribeRaw(sub->rawSub, channel, SubType::dispatch, sub);
+
+    subscriptions.push_back(sub);
+    return sub;
+}
+
+template <class Msg, class Handler>
+inline Subscription* ZCM::subscribe(const std::string& channel,
+                                    void (Handler::*cb)(const ReceiveBuffer* rbuf,
+                                                        const std::string& channel,
+                                                        std::shared_ptr<const Msg> msg),
+                                    Handler* handler, size_t poolSize)
+{
+    if (!zcm) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr, "ZCM instance not initialized. Ignoring call to subscribe()\n");
+        #endif
+        return nullptr;
+    }
+
+    typedef SharedTypedHandlerSubscription<Msg, Handler> SubType;
+    SubType* sub = new SubType();
+    ZCM_ASSERT(sub);
+    sub->handler = handler;
+    sub->sharedHandlerCallback = cb;
+    sub->maxPooled = poolSize;
+    sub->pool.reserve(poolSize);
+    subscribeRaw(sub->rawSub, channel, SubType::dispatch, sub);
+
+    subscriptions.push_back(sub);
+    return sub;
+}
 #endif
 
+template <class View>
+inline Subscription* ZCM::subscribe(const std::string& channel,
+                                    void (*cb)(const ReceiveBuffer* rbuf,
+                                               const std::string& channel,
+                                               const View& view, void* usr),
+                                    void* usr)
+{
+    if (!zcm) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr, "ZCM instance not initialized.  Ignoring call to subscribe()\n");
+        #endif
+        return nullptr;
+    }
+
+    typedef ViewSubscription<View> SubType;
+    SubType* sub = new SubType();
+    ZCM_ASSERT(sub);
+    sub->usr = usr;
+    sub->viewCallback = cb;
+    subscribeRaw(sub->rawSub, channel, SubType::dispatch, sub);
+
+    subscriptions.push_back(sub);
+    return sub;
+}
+
 inline void ZCM::unsubscribe(Subscription* sub)
 {
     std::vector<Subscription*>::iterator end = subscriptions.end(),
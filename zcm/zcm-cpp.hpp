@@ -11,7 +11,9 @@
 #endif
 
 #if __cplusplus > 199711L
+#include <atomic>
 #include <functional>
+#include <memory>
 #endif
 
 namespace zcm {
@@ -51,6 +53,19 @@ class ZCM
     template <class Msg>
     inline int publish(const std::string& channel, const Msg* msg);
 
+    // Loaned-buffer publishing: serialize directly into a buffer owned by zcm.
+    // See zcm_publish_reserve() for details.
+    // Note: these bypass publishRaw()
+    inline void* publishReserve(const std::string& channel, uint32_t len);
+    inline int publishCommit(void* buf);
+    inline int publishAbort(void* buf);
+
+    // Republish a received message, handing its buffer over instead of copying it
+    // when possible. See zcm_forward() for details.
+    // Note: this bypasses publishRaw()
+    inline int forward(const std::string& channel, const ReceiveBuffer* rbuf);
+    inline int forward(const char* channel, const ReceiveBuffer* rbuf);
+
     inline Subscription* subscribe(const std::string& channel,
                                    void (*cb)(const ReceiveBuffer* rbuf,
                                               const std::string& channel,
@@ -83,8 +98,35 @@ class ZCM
                                    std::function<void (const ReceiveBuffer* rbuf,
                                                        const std::string& channel,
                                                        const Msg* msg)> cb);
+
+    // Shared subscriptions: messages are decoded into a pool of refcounted instances, so the
+    // callback may keep the message (or hand it to another thread) without copying it. A pooled
+    // message is reused once every reference to it is gone. At most 'poolSize' messages are
+    // pooled; if all of them are still referenced, a new unpooled message is allocated.
+    template <class Msg>
+    inline Subscription* subscribe(const std::string& channel,
+                                   void (*cb)(const ReceiveBuffer* rbuf,
+                                              const std::string& channel,
+                                              std::shared_ptr<const Msg> msg, void* usr),
+                                   void* usr, size_t poolSize = 16);
+
+    template <class Msg, class Handler>
+    inline Subscription* subscribe(const std::string& channel,
+                                   void (Handler::*cb)(const ReceiveBuffer* rbuf,
+                                                       const std::string& channel,
+                                                       std::shared_ptr<const Msg> msg),
+                                   Handler* handler, size_t poolSize = 16);
     #endif
 
+    // Zero-copy subscription: View is a <type>View class generated by `zcm-gen --cpp-view`.
+    // The view reads straight out of the receive buffer, so it is only valid during the callback
+    template <class View>
+    inline Subscription* subscribe(const std::string& channel,
+                                   void (*cb)(const ReceiveBuffer* rbuf,
+                                              const std::string& channel,
+                                              const View& view, void* usr),
+                                   void* usr);
+
     inline void unsubscribe(Subscription* sub);
 
     virtual inline zcm_t* getUnderlyingZCM();
@@ -102,6 +144,10 @@ class ZCM
     virtual inline void unsubscribeRaw(void*& rawSub);
 
   private:
+    #if __cplusplus > 199711L && !defined(ZCM_EMBEDDED)
+    static inline uint8_t* publishScratch(uint32_t len, uint32_t& cap);
+    #endif
+
     zcm_t* zcm;
     std::vector<Subscription*> subscriptions;
 };
@@ -192,6 +192,80 @@ int zcm_publish(zcm_t *zcm, const char *channel, const void *data, uint32_t len)
     assert(0 && "unreachable");
 }
 
+void *zcm_publish_reserve(zcm_t *zcm, const char *channel, uint32_t len)
+{
+    char *buf = NULL;
+#ifndef ZCM_EMBEDDED
+    switch (zcm->type) {
+        case ZCM_BLOCKING: {
+            zcm->err = zcm_blocking_publish_reserve(zcm->impl, channel, len, &buf);
+        } break;
+        case ZCM_NONBLOCKING: {
+            zcm->err = zcm_nonblocking_publish_reserve(zcm->impl, channel, len, &buf);
+        } break;
+    }
+#else
+    assert(zcm->type == ZCM_NONBLOCKING);
+    zcm->err = zcm_nonblocking_publish_reserve(zcm->impl, channel, len, &buf);
+#endif
+    return zcm->err == ZCM_EOK ? buf : NULL;
+}
+
+int zcm_publish_commit(zcm_t *zcm, void *buf)
+{
+#ifndef ZCM_EMBEDDED
+    switch (zcm->type) {
+        case ZCM_BLOCKING: {
+            zcm->err = zcm_blocking_publish_commit(zcm->impl, buf);
+        } break;
+        case ZCM_NONBLOCKING: {
+            zcm->err = zcm_nonblocking_publish_commit(zcm->impl, buf);
+        } break;
+    }
+#else
+    assert(zcm->type == ZCM_NONBLOCKING);
+    zcm->err = zcm_nonblocking_publish_commit(zcm->impl, buf);
+#endif
+    return zcm->err == ZCM_EOK ? 0 : -1;
+}
+
+int zcm_publish_abort(zcm_t *zcm, void *buf)
+{
+#ifndef ZCM_EMBEDDED
+    switch (zcm->type) {
+        case ZCM_BLOCKING: {
+            zcm->err = zcm_blocking_publish_abort(zcm->impl, buf);
+        } break;
+        case ZCM_NONBLOCKING: {
+            zcm->err = zcm_nonblocking_publish_abort(zcm->impl, buf);
+        } break;
+    }
+#else
+    assert(zcm->type == ZCM_NONBLOCKING);
+    zcm->err = zcm_nonblocking_publish_abort(zcm->impl, buf);
+#endif
+    return zcm->err == ZCM_EOK ? 0 : -1;
+}
+
+int zcm_forward(zcm_t *zcm, const char *channel, const zcm_recv_buf_t *rbuf)
+{
+#ifndef ZCM_EMBEDDED
+    switch (zcm->type) {
+        case ZCM_BLOCKING: {
+            zcm->err = zcm_blocking_forward(zcm->impl, channel, rbuf);
+            return zcm->err == 0 ? 0 : -1;
+        } break;
+        case ZCM_NONBLOCKING: {
+            return zcm_nonblocking_publish(zcm->impl, channel, rbuf->data, rbuf->data_size);
+        } break;
+    }
+#else
+    assert(zcm->type == ZCM_NONBLOCKING);
+    return zcm_nonblocking_publish(zcm->impl, channel, rbuf->data, rbuf->data_size);
+#endif
+    assert(0 && "unreachable");
+}
+
 void zcm_flush(zcm_t *zcm)
 {
 #ifndef ZCM_EMBEDDED
@@ -319,3 +393,15 @@ int zcm_handle_nonblock(zcm_t *zcm)
 #endif
     assert(0 && "unreachable");
 }
+
+#ifndef ZCM_EMBEDDED
+int zcm_get_stats(zcm_t *zcm, zcm_channel_stats_t *stats, int max)
+{
+    switch (zcm->type) {
+        case ZCM_BLOCKING:    return zcm_blocking_get_stats   (zcm->impl, stats, max); break;
+        case ZCM_NONBLOCKING: return zcm_nonblocking_get_stats(zcm->impl, stats, max); break;
+    }
+    assert(0 && "unreachable");
+    return -1;
+}
+#endif
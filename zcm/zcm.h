@@ -58,6 +58,11 @@ struct zcm_recv_buf_t
     zcm_t *zcm;
     char *data;           /* NOTE: do not free, the library manages this memory */
     uint32_t data_size;
+
+    /* The publisher's timestamp and sequence number, if the transport carried
+       them (see the 'timestamps' url option of udpm and ipc). pub_utime is 0 otherwise */
+    int64_t pub_utime;
+    uint32_t seqno;
 };
 
 /* Standard create/destroy functions. These will malloc() and free() the zcm_t object.
@@ -117,6 +122,40 @@ int zcm_try_unsubscribe(zcm_t *zcm, zcm_sub_t *sub);
    Sets zcm errno on failure */
 int  zcm_publish(zcm_t *zcm, const char *channel, const void *data, uint32_t len);
 
+/* Reserve a buffer of 'len' bytes that a message for 'channel' can be serialized
+   directly into. The message is published by passing the buffer to
+   zcm_publish_commit(), or discarded by passing it to zcm_publish_abort().
+   In blocking mode the buffer becomes the send queue entry itself, so no copy of
+   the message is made. Otherwise, commit falls back to a zcm_publish() of the buffer.
+   Note: the non-blocking api only supports one outstanding reservation at a time,
+         of at most ZCM_NONBLOCK_RESERVE_MAX bytes (256 unless defined at build time)
+   Returns the buffer on success, and NULL on failure
+   Sets zcm errno on failure */
+void *zcm_publish_reserve(zcm_t *zcm, const char *channel, uint32_t len);
+
+/* Publish a message previously serialized into a buffer from zcm_publish_reserve().
+   On success, the buffer is owned by zcm again and must not be touched. If this
+   returns -1 with zcm errno set to ZCM_EAGAIN, the reservation is kept and the
+   commit may be retried (or the reservation aborted).
+   Returns 0 on success, and -1 on failure
+   Sets zcm errno on failure */
+int  zcm_publish_commit(zcm_t *zcm, void *buf);
+
+/* Release a buffer from zcm_publish_reserve() without publishing it
+   Returns 0 on success, and -1 on failure
+   Sets zcm errno on failure */
+int  zcm_publish_abort(zcm_t *zcm, void *buf);
+
+/* Publish a message received from any zcm instance on 'zcm' under 'channel'.
+   Must be called from the callback that received 'rbuf'. When both instances are
+   in blocking mode and this is the last callback the message is dispatched to,
+   the received buffer itself is moved into the send queue of 'zcm' instead of
+   being copied, so 'rbuf->data' must not be used after a successful forward.
+   Otherwise this is the same as zcm_publish(zcm, channel, rbuf->data, rbuf->data_size)
+   Returns 0 on success, and -1 on failure
+   Sets zcm errno on failure */
+int  zcm_forward(zcm_t *zcm, const char *channel, const zcm_recv_buf_t *rbuf);
+
 /* Blocking until all published messages have been sent even if the underlying
    transport is nonblocking. This should not be called concurrently with
    zcm_publish(). This function may cause all calls to zcm_publish() to block
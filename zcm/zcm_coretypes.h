@@ -20,6 +20,52 @@ static inline void zcm_free(void* mem)
     free(mem);
 }
 
+/**
+ * DECODE ARENA
+ *
+ * A bump allocator over caller-supplied memory. The _decode_arena() functions
+ * emitted by `zcm-gen --c-arena` carve all of a message's strings and
+ * variable-length arrays out of an arena instead of calling zcm_malloc() for
+ * each of them. Nothing is freed individually: once the decoded message is no
+ * longer needed, zcm_arena_reset() releases everything at once.
+ */
+#define ZCM_ARENA_ALIGN 8
+
+typedef struct _zcm_arena_t zcm_arena_t;
+struct _zcm_arena_t
+{
+    uint8_t *mem;
+    size_t   size;
+    size_t   used;
+};
+
+static inline void zcm_arena_init(zcm_arena_t *arena, void *mem, size_t size)
+{
+    arena->mem = (uint8_t*) mem;
+    arena->size = size;
+    arena->used = 0;
+}
+
+static inline void zcm_arena_reset(zcm_arena_t *arena)
+{
+    arena->used = 0;
+}
+
+// Returns NULL if sz is 0 (like zcm_malloc) or if the arena is exhausted
+static inline void *zcm_arena_alloc(zcm_arena_t *arena, size_t sz)
+{
+    size_t pad = (ZCM_ARENA_ALIGN - (uintptr_t)(arena->mem + arena->used) % ZCM_ARENA_ALIGN)
+                 % ZCM_ARENA_ALIGN;
+    uint8_t *ret;
+
+    if (sz == 0) return NULL;
+    if (pad > arena->size - arena->used || sz > arena->size - arena->used - pad) return NULL;
+
+    ret = arena->mem + arena->used + pad;
+    arena->used += pad + sz;
+    return ret;
+}
+
 typedef struct ___zcm_hash_ptr __zcm_hash_ptr;
 struct ___zcm_hash_ptr
 {
@@ -27,6 +73,162 @@ struct ___zcm_hash_ptr
     void *v;
 };
 
+/**
+ * BULK BYTE ORDER CONVERSION
+ *
+ * All multi-byte primitive arrays are converted to and from the wire format by
+ * the kernels below. When the host byte order is known at compile time, the
+ * conversion is either a straight memcpy or a bulk byte reversal. Define
+ * ZCM_SIMD (and link libzcm) to do large reversals with the SIMD kernels in
+ * zcm/coretypes_simd.c: NEON is selected at compile time, on x86 the AVX2 /
+ * SSSE3 kernels are selected once at runtime so that no special compiler flags
+ * are needed. Without it only the portable loops are used. Configuring with
+ * --use-simd defines it for the zcm build and in the flags from zcm.pc.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define __ZCM_LITTLE_ENDIAN_HOST
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define __ZCM_BIG_ENDIAN_HOST
+#elif defined(_MSC_VER)
+#define __ZCM_LITTLE_ENDIAN_HOST
+#endif
+
+#ifdef ZCM_SIMD
+// Implemented in zcm/coretypes_simd.c. Reverses the bytes of as many whole vectors
+// of 'width' byte elements as possible and returns the number of bytes processed
+int __zcm_swap_simd(uint8_t *dst, const uint8_t *src, int nbytes, int width);
+#endif
+
+// Copies 'elements' elements of 'width' bytes each from src to dst, reversing the
+// byte order of every element. dst and src must not overlap
+static inline void __zcm_copy_swap(void *_dst, const void *_src, int elements, int width)
+{
+    uint8_t *dst = (uint8_t*) _dst;
+    const uint8_t *src = (const uint8_t*) _src;
+    int nbytes = elements * width;
+    int i = 0, j;
+
+#ifdef ZCM_SIMD
+    // Small arrays (including all scalars) aren't worth the call
+    if (nbytes >= 64)
+        i = __zcm_swap_simd(dst, src, nbytes, width);
+#endif
+
+#if defined(__GNUC__)
+    // Whole element swaps, which the compiler is free to vectorize on its own
+    if (width == 8) {
+        uint64_t v;
+        for (; i < nbytes; i += 8) {
+            memcpy(&v, src + i, 8); v = __builtin_bswap64(v); memcpy(dst + i, &v, 8);
+        }
+    } else if (width == 4) {
+        uint32_t v;
+        for (; i < nbytes; i += 4) {
+            memcpy(&v, src + i, 4); v = __builtin_bswap32(v); memcpy(dst + i, &v, 4);
+        }
+    }
+#endif
+    for (; i < nbytes; i += width)
+        for (j = 0; j < width; j++)
+            dst[i + j] = src[i + width - 1 - j];
+}
+
+#if !defined(__ZCM_LITTLE_ENDIAN_HOST) && !defined(__ZCM_BIG_ENDIAN_HOST)
+// Portable fallbacks for when the host byte order is unknown
+static inline uint64_t __zcm_load_host(const uint8_t *p, int width)
+{
+    uint16_t u16; uint32_t u32; uint64_t u64;
+    switch (width) {
+        case 2:  memcpy(&u16, p, 2); return u16;
+        case 4:  memcpy(&u32, p, 4); return u32;
+        default: memcpy(&u64, p, 8); return u64;
+    }
+}
+
+static inline void __zcm_store_host(uint8_t *p, uint64_t v, int width)
+{
+    uint16_t u16 = (uint16_t)v; uint32_t u32 = (uint32_t)v;
+    switch (width) {
+        case 2:  memcpy(p, &u16, 2); break;
+        case 4:  memcpy(p, &u32, 4); break;
+        default: memcpy(p, &v, 8); break;
+    }
+}
+
+static inline void __zcm_encode_portable(uint8_t *dst, const void *_src, int elements,
+                                         int width, int littleEndian)
+{
+    const uint8_t *src = (const uint8_t*) _src;
+    int element, j;
+    for (element = 0; element < elements; element++) {
+        uint64_t v = __zcm_load_host(src + element * width, width);
+        for (j = 0; j < width; j++)
+            dst[element * width + j] = (v >> (8 * (littleEndian ? j : width - 1 - j))) & 0xff;
+    }
+}
+
+static inline void __zcm_decode_portable(void *_dst, const uint8_t *src, int elements,
+                                         int width, int littleEndian)
+{
+    uint8_t *dst = (uint8_t*) _dst;
+    int element, j;
+    for (element = 0; element < elements; element++) {
+        uint64_t v = 0;
+        for (j = 0; j < width; j++)
+            v |= ((uint64_t)src[element * width + j]) << (8 * (littleEndian ? j : width - 1 - j));
+        __zcm_store_host(dst + element * width, v, width);
+    }
+}
+#endif
+
+// Host array -> big endian wire format
+static inline void __zcm_encode_be(uint8_t *dst, const void *src, int elements, int width)
+{
+#if defined(__ZCM_LITTLE_ENDIAN_HOST)
+    __zcm_copy_swap(dst, src, elements, width);
+#elif defined(__ZCM_BIG_ENDIAN_HOST)
+    memcpy(dst, src, elements * width);
+#else
+    __zcm_encode_portable(dst, src, elements, width, 0);
+#endif
+}
+
+// Big endian wire format -> host array
+static inline void __zcm_decode_be(void *dst, const uint8_t *src, int elements, int width)
+{
+#if defined(__ZCM_LITTLE_ENDIAN_HOST)
+    __zcm_copy_swap(dst, src, elements, width);
+#elif defined(__ZCM_BIG_ENDIAN_HOST)
+    memcpy(dst, src, elements * width);
+#else
+    __zcm_decode_portable(dst, src, elements, width, 0);
+#endif
+}
+
+// Host array -> little endian wire format
+static inline void __zcm_encode_le(uint8_t *dst, const void *src, int elements, int width)
+{
+#if defined(__ZCM_LITTLE_ENDIAN_HOST)
+    memcpy(dst, src, elements * width);
+#elif defined(__ZCM_BIG_ENDIAN_HOST)
+    __zcm_copy_swap(dst, src, elements, width);
+#else
+    __zcm_encode_portable(dst, src, elements, width, 1);
+#endif
+}
+
+// Little endian wire format -> host array
+static inline void __zcm_decode_le(void *dst, const uint8_t *src, int elements, int width)
+{
+#if defined(__ZCM_LITTLE_ENDIAN_HOST)
+    memcpy(dst, src, elements * width);
+#elif defined(__ZCM_BIG_ENDIAN_HOST)
+    __zcm_copy_swap(dst, src, elements, width);
+#else
+    __zcm_decode_portable(dst, src, elements, width, 1);
+#endif
+}
+
 /**
  * BOOLEAN
  */
@@ -156,18 +358,11 @@ static inline int __int16_t_encode_array(void *_buf, int offset, int maxlen, con
 {
     int total_size = sizeof(int16_t) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
 
     if (maxlen < total_size)
         return -1;
 
-    const uint16_t *unsigned_p = (uint16_t*)p;
-    for (element = 0; element < elements; element++) {
-        uint16_t v = unsigned_p[element];
-        buf[pos++] = (v>>8) & 0xff;
-        buf[pos++] = (v & 0xff);
-    }
+    __zcm_encode_be(&buf[offset], p, elements, sizeof(int16_t));
 
     return total_size;
 }
@@ -175,17 +370,12 @@ static inline int __int16_t_encode_array(void *_buf, int offset, int maxlen, con
 static inline int __int16_t_decode_array(const void *_buf, int offset, int maxlen, int16_t *p, int elements)
 {
     int total_size = sizeof(int16_t) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; element++) {
-        p[element] = (buf[pos]<<8) + buf[pos+1];
-        pos+=2;
-    }
+    __zcm_decode_be(p, &buf[offset], elements, sizeof(int16_t));
 
     return total_size;
 }
@@ -194,18 +384,11 @@ static inline int __int16_t_encode_little_endian_array(void *_buf, int offset, i
 {
     int total_size = sizeof(int16_t) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
 
     if (maxlen < total_size)
         return -1;
 
-    const uint16_t *unsigned_p = (uint16_t*)p;
-    for (element = 0; element < elements; element++) {
-        uint16_t v = unsigned_p[element];
-        buf[pos++] = (v & 0xff);
-        buf[pos++] = (v>>8) & 0xff;
-    }
+    __zcm_encode_le(&buf[offset], p, elements, sizeof(int16_t));
 
     return total_size;
 }
@@ -213,17 +396,12 @@ static inline int __int16_t_encode_little_endian_array(void *_buf, int offset, i
 static inline int __int16_t_decode_little_endian_array(const void *_buf, int offset, int maxlen, int16_t *p, int elements)
 {
     int total_size = sizeof(int16_t) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; element++) {
-        p[element] = (buf[pos+1]<<8) + buf[pos];
-        pos+=2;
-    }
+    __zcm_decode_le(p, &buf[offset], elements, sizeof(int16_t));
 
     return total_size;
 }
@@ -251,20 +429,11 @@ static inline int __int32_t_encode_array(void *_buf, int offset, int maxlen, con
 {
     int total_size = sizeof(int32_t) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
 
     if (maxlen < total_size)
         return -1;
 
-    const uint32_t* unsigned_p = (uint32_t*)p;
-    for (element = 0; element < elements; element++) {
-        uint32_t v = unsigned_p[element];
-        buf[pos++] = (v>>24)&0xff;
-        buf[pos++] = (v>>16)&0xff;
-        buf[pos++] = (v>>8)&0xff;
-        buf[pos++] = (v & 0xff);
-    }
+    __zcm_encode_be(&buf[offset], p, elements, sizeof(int32_t));
 
     return total_size;
 }
@@ -272,20 +441,12 @@ static inline int __int32_t_encode_array(void *_buf, int offset, int maxlen, con
 static inline int __int32_t_decode_array(const void *_buf, int offset, int maxlen, int32_t *p, int elements)
 {
     int total_size = sizeof(int32_t) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; element++) {
-        p[element] = (((uint32_t)buf[pos+0])<<24) +
-                     (((uint32_t)buf[pos+1])<<16) +
-                     (((uint32_t)buf[pos+2])<<8) +
-                      ((uint32_t)buf[pos+3]);
-        pos+=4;
-    }
+    __zcm_decode_be(p, &buf[offset], elements, sizeof(int32_t));
 
     return total_size;
 }
@@ -294,20 +455,11 @@ static inline int __int32_t_encode_little_endian_array(void *_buf, int offset, i
 {
     int total_size = sizeof(int32_t) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
 
     if (maxlen < total_size)
         return -1;
 
-    const uint32_t* unsigned_p = (uint32_t*)p;
-    for (element = 0; element < elements; element++) {
-        uint32_t v = unsigned_p[element];
-        buf[pos++] = (v & 0xff);
-        buf[pos++] = (v>>8)&0xff;
-        buf[pos++] = (v>>16)&0xff;
-        buf[pos++] = (v>>24)&0xff;
-    }
+    __zcm_encode_le(&buf[offset], p, elements, sizeof(int32_t));
 
     return total_size;
 }
@@ -315,20 +467,12 @@ static inline int __int32_t_encode_little_endian_array(void *_buf, int offset, i
 static inline int __int32_t_decode_little_endian_array(const void *_buf, int offset, int maxlen, int32_t *p, int elements)
 {
     int total_size = sizeof(int32_t) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; element++) {
-        p[element] = (((uint32_t)buf[pos+3])<<24) +
-                      (((uint32_t)buf[pos+2])<<16) +
-                      (((uint32_t)buf[pos+1])<<8) +
-                       ((uint32_t)buf[pos+0]);
-        pos+=4;
-    }
+    __zcm_decode_le(p, &buf[offset], elements, sizeof(int32_t));
 
     return total_size;
 }
@@ -356,24 +500,11 @@ static inline int __int64_t_encode_array(void *_buf, int offset, int maxlen, con
 {
     int total_size = sizeof(int64_t) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
 
     if (maxlen < total_size)
         return -1;
 
-    const uint64_t* unsigned_p = (uint64_t*)p;
-    for (element = 0; element < elements; element++) {
-        uint64_t v = unsigned_p[element];
-        buf[pos++] = (v>>56)&0xff;
-        buf[pos++] = (v>>48)&0xff;
-        buf[pos++] = (v>>40)&0xff;
-        buf[pos++] = (v>>32)&0xff;
-        buf[pos++] = (v>>24)&0xff;
-        buf[pos++] = (v>>16)&0xff;
-        buf[pos++] = (v>>8)&0xff;
-        buf[pos++] = (v & 0xff);
-    }
+    __zcm_encode_be(&buf[offset], p, elements, sizeof(int64_t));
 
     return total_size;
 }
@@ -381,26 +512,12 @@ static inline int __int64_t_encode_array(void *_buf, int offset, int maxlen, con
 static inline int __int64_t_decode_array(const void *_buf, int offset, int maxlen, int64_t *p, int elements)
 {
     int total_size = sizeof(int64_t) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; element++) {
-        uint64_t a = (((uint32_t)buf[pos+0])<<24) +
-                     (((uint32_t)buf[pos+1])<<16) +
-                     (((uint32_t)buf[pos+2])<<8) +
-                      ((uint32_t)buf[pos+3]);
-        pos+=4;
-        uint64_t b = (((uint32_t)buf[pos+0])<<24) +
-                     (((uint32_t)buf[pos+1])<<16) +
-                     (((uint32_t)buf[pos+2])<<8) +
-                      ((uint32_t)buf[pos+3]);
-        pos+=4;
-        p[element] = (a<<32) + (b&0xffffffff);
-    }
+    __zcm_decode_be(p, &buf[offset], elements, sizeof(int64_t));
 
     return total_size;
 }
@@ -409,24 +526,11 @@ static inline int __int64_t_encode_little_endian_array(void *_buf, int offset, i
 {
     int total_size = sizeof(int64_t) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
 
     if (maxlen < total_size)
         return -1;
 
-    const uint64_t* unsigned_p = (uint64_t*)p;
-    for (element = 0; element < elements; element++) {
-        uint64_t v = unsigned_p[element];
-        buf[pos++] = (v & 0xff);
-        buf[pos++] = (v>>8)&0xff;
-        buf[pos++] = (v>>16)&0xff;
-        buf[pos++] = (v>>24)&0xff;
-        buf[pos++] = (v>>32)&0xff;
-        buf[pos++] = (v>>40)&0xff;
-        buf[pos++] = (v>>48)&0xff;
-        buf[pos++] = (v>>56)&0xff;
-    }
+    __zcm_encode_le(&buf[offset], p, elements, sizeof(int64_t));
 
     return total_size;
 }
@@ -434,26 +538,12 @@ static inline int __int64_t_encode_little_endian_array(void *_buf, int offset, i
 static inline int __int64_t_decode_little_endian_array(const void *_buf, int offset, int maxlen, int64_t *p, int elements)
 {
     int total_size = sizeof(int64_t) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; element++) {
-        uint64_t b = (((uint32_t)buf[pos+3])<<24) +
-                     (((uint32_t)buf[pos+2])<<16) +
-                     (((uint32_t)buf[pos+1])<<8) +
-                      ((uint32_t)buf[pos+0]);
-        pos+=4;
-        uint64_t a = (((uint32_t)buf[pos+3])<<24) +
-                     (((uint32_t)buf[pos+2])<<16) +
-                     (((uint32_t)buf[pos+1])<<8) +
-                      ((uint32_t)buf[pos+0]);
-        pos+=4;
-        p[element] = (a<<32) + (b&0xffffffff);
-    }
+    __zcm_decode_le(p, &buf[offset], elements, sizeof(int64_t));
 
     return total_size;
 }
@@ -486,20 +576,11 @@ static inline int __float_encode_array(void *_buf, int offset, int maxlen, const
 {
     int total_size = sizeof(float) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__float_uint32_t tmp;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        tmp.flt = p[element];
-        buf[pos++] = (tmp.uint >> 24) & 0xff;
-        buf[pos++] = (tmp.uint >> 16) & 0xff;
-        buf[pos++] = (tmp.uint >>  8) & 0xff;
-        buf[pos++] = (tmp.uint      ) & 0xff;
-    }
+    __zcm_encode_be(&buf[offset], p, elements, sizeof(float));
 
     return total_size;
 }
@@ -507,22 +588,12 @@ static inline int __float_encode_array(void *_buf, int offset, int maxlen, const
 static inline int __float_decode_array(const void *_buf, int offset, int maxlen, float *p, int elements)
 {
     int total_size = sizeof(float) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__float_uint32_t tmp;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        tmp.uint = (((uint32_t)buf[pos + 0]) << 24) |
-                   (((uint32_t)buf[pos + 1]) << 16) |
-                   (((uint32_t)buf[pos + 2]) <<  8) |
-                    ((uint32_t)buf[pos + 3]);
-        p[element] = tmp.flt;
-        pos += 4;
-    }
+    __zcm_decode_be(p, &buf[offset], elements, sizeof(float));
 
     return total_size;
 }
@@ -531,20 +602,11 @@ static inline int __float_encode_little_endian_array(void *_buf, int offset, int
 {
     int total_size = sizeof(float) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__float_uint32_t tmp;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        tmp.flt = p[element];
-        buf[pos++] = (tmp.uint      ) & 0xff;
-        buf[pos++] = (tmp.uint >>  8) & 0xff;
-        buf[pos++] = (tmp.uint >> 16) & 0xff;
-        buf[pos++] = (tmp.uint >> 24) & 0xff;
-    }
+    __zcm_encode_le(&buf[offset], p, elements, sizeof(float));
 
     return total_size;
 }
@@ -552,22 +614,12 @@ static inline int __float_encode_little_endian_array(void *_buf, int offset, int
 static inline int __float_decode_little_endian_array(const void *_buf, int offset, int maxlen, float *p, int elements)
 {
     int total_size = sizeof(float) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__float_uint32_t tmp;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        tmp.uint = (((uint32_t)buf[pos + 3]) << 24) |
-                   (((uint32_t)buf[pos + 2]) << 16) |
-                   (((uint32_t)buf[pos + 1]) <<  8) |
-                    ((uint32_t)buf[pos + 0]);
-        p[element] = tmp.flt;
-        pos += 4;
-    }
+    __zcm_decode_le(p, &buf[offset], elements, sizeof(float));
 
     return total_size;
 }
@@ -600,24 +652,11 @@ static inline int __double_encode_array(void *_buf, int offset, int maxlen, cons
 {
     int total_size = sizeof(double) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__double_uint64_t tmp;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        tmp.dbl = p[element];
-        buf[pos++] = (tmp.uint >> 56) & 0xff;
-        buf[pos++] = (tmp.uint >> 48) & 0xff;
-        buf[pos++] = (tmp.uint >> 40) & 0xff;
-        buf[pos++] = (tmp.uint >> 32) & 0xff;
-        buf[pos++] = (tmp.uint >> 24) & 0xff;
-        buf[pos++] = (tmp.uint >> 16) & 0xff;
-        buf[pos++] = (tmp.uint >>  8) & 0xff;
-        buf[pos++] = (tmp.uint      ) & 0xff;
-    }
+    __zcm_encode_be(&buf[offset], p, elements, sizeof(double));
 
     return total_size;
 }
@@ -625,28 +664,12 @@ static inline int __double_encode_array(void *_buf, int offset, int maxlen, cons
 static inline int __double_decode_array(const void *_buf, int offset, int maxlen, double *p, int elements)
 {
     int total_size = sizeof(double) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__double_uint64_t tmp;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        uint64_t a = (((uint32_t) buf[pos + 0]) << 24) +
-                     (((uint32_t) buf[pos + 1]) << 16) +
-                     (((uint32_t) buf[pos + 2]) <<  8) +
-                      ((uint32_t) buf[pos + 3]);
-        pos += 4;
-        uint64_t b = (((uint32_t) buf[pos + 0]) << 24) +
-                     (((uint32_t) buf[pos + 1]) << 16) +
-                     (((uint32_t) buf[pos + 2]) <<  8) +
-                      ((uint32_t) buf[pos + 3]);
-        pos += 4;
-        tmp.uint = (a << 32) + (b & 0xffffffff);
-        p[element] = tmp.dbl;
-    }
+    __zcm_decode_be(p, &buf[offset], elements, sizeof(double));
 
     return total_size;
 }
@@ -655,24 +678,11 @@ static inline int __double_encode_little_endian_array(void *_buf, int offset, in
 {
     int total_size = sizeof(double) * elements;
     uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__double_uint64_t tmp;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        tmp.dbl = p[element];
-        buf[pos++] = (tmp.uint      ) & 0xff;
-        buf[pos++] = (tmp.uint >>  8) & 0xff;
-        buf[pos++] = (tmp.uint >> 16) & 0xff;
-        buf[pos++] = (tmp.uint >> 24) & 0xff;
-        buf[pos++] = (tmp.uint >> 32) & 0xff;
-        buf[pos++] = (tmp.uint >> 40) & 0xff;
-        buf[pos++] = (tmp.uint >> 48) & 0xff;
-        buf[pos++] = (tmp.uint >> 56) & 0xff;
-    }
+    __zcm_encode_le(&buf[offset], p, elements, sizeof(double));
 
     return total_size;
 }
@@ -680,28 +690,12 @@ static inline int __double_encode_little_endian_array(void *_buf, int offset, in
 static inline int __double_decode_little_endian_array(const void *_buf, int offset, int maxlen, double *p, int elements)
 {
     int total_size = sizeof(double) * elements;
-    uint8_t *buf = (uint8_t*) _buf;
-    int pos = offset;
-    int element;
-    __zcm__double_uint64_t tmp;
+    const uint8_t *buf = (const uint8_t*) _buf;
 
     if (maxlen < total_size)
         return -1;
 
-    for (element = 0; element < elements; ++element) {
-        uint64_t b = (((uint32_t)buf[pos + 3]) << 24) +
-                     (((uint32_t)buf[pos + 2]) << 16) +
-                     (((uint32_t)buf[pos + 1]) <<  8) +
-                      ((uint32_t)buf[pos + 0]);
-        pos += 4;
-        uint64_t a = (((uint32_t)buf[pos + 3]) << 24) +
-                     (((uint32_t)buf[pos + 2]) << 16) +
-                     (((uint32_t)buf[pos + 1]) <<  8) +
-                      ((uint32_t)buf[pos + 0]);
-        pos += 4;
-        tmp.uint = (a << 32) + (b & 0xffffffff);
-        p[element] = tmp.dbl;
-    }
+    __zcm_decode_le(p, &buf[offset], elements, sizeof(double));
 
     return total_size;
 }
@@ -815,6 +809,50 @@ static inline int __string_decode_little_endian_array(const void *_buf, int offs
     return pos;
 }
 
+static inline int __string_decode_array_arena(const void *_buf, int offset, int maxlen, char **p, int elements, zcm_arena_t *arena)
+{
+    int pos = 0, thislen;
+    int element;
+
+    for (element = 0; element < elements; element++) {
+        int32_t length;
+
+        // read length including \0
+        thislen = __int32_t_decode_array(_buf, offset + pos, maxlen - pos, &length, 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+        if (length <= 0) return -1;
+
+        p[element] = (char*) zcm_arena_alloc(arena, length);
+        if (!p[element]) return -1;
+        thislen = __int8_t_decode_array(_buf, offset + pos, maxlen - pos, (int8_t*) p[element], length);
+        if (thislen < 0) return thislen; else pos += thislen;
+    }
+
+    return pos;
+}
+
+static inline int __string_decode_little_endian_array_arena(const void *_buf, int offset, int maxlen, char **p, int elements, zcm_arena_t *arena)
+{
+    int pos = 0, thislen;
+    int element;
+
+    for (element = 0; element < elements; element++) {
+        int32_t length;
+
+        // read length including \0
+        thislen = __int32_t_decode_little_endian_array(_buf, offset + pos, maxlen - pos, &length, 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+        if (length <= 0) return -1;
+
+        p[element] = (char*) zcm_arena_alloc(arena, length);
+        if (!p[element]) return -1;
+        thislen = __int8_t_decode_little_endian_array(_buf, offset + pos, maxlen - pos, (int8_t*) p[element], length);
+        if (thislen < 0) return thislen; else pos += thislen;
+    }
+
+    return pos;
+}
+
 // TODO: Figure out why "const char * const * p" doesn't work
 static inline int __string_clone_array(char * const *p, char **q, int elements)
 {
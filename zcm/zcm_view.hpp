@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "zcm/zcm_coretypes.h"
+
+// Support types for the zero-copy "view" classes emitted by `zcm-gen --cpp-view`.
+// A view never owns memory: it points into a received (encoded) buffer and is
+// only valid for as long as that buffer is.
+
+namespace zcm {
+
+// Overloads mapping each primitive zcmtype onto its coretypes decoder so that
+// ArrayView<T> can decode a single element without knowing the zcmtype name.
+// Note: boolean is stored as int8_t and shares its decoder
+#define __ZCM_VIEW_DECODER(T, name) \
+    static inline void __zcm_view_decode(const uint8_t *p, T *v, int n, bool littleEndian) \
+    { \
+        if (littleEndian) __##name##_decode_little_endian_array(p, 0, (int)sizeof(T) * n, v, n); \
+        else              __##name##_decode_array(p, 0, (int)sizeof(T) * n, v, n); \
+    }
+__ZCM_VIEW_DECODER(uint8_t, byte)
+__ZCM_VIEW_DECODER(int8_t,  int8_t)
+__ZCM_VIEW_DECODER(int16_t, int16_t)
+__ZCM_VIEW_DECODER(int32_t, int32_t)
+__ZCM_VIEW_DECODER(int64_t, int64_t)
+__ZCM_VIEW_DECODER(float,   float)
+__ZCM_VIEW_DECODER(double,  double)
+#undef __ZCM_VIEW_DECODER
+
+// A read-only span over a primitive array that is still in its encoded form.
+// Multidimensional arrays are flattened in row-major order.
+template <class T, bool LittleEndian = false>
+class ArrayView
+{
+    const uint8_t *ptr;
+    int            len;
+
+  public:
+    ArrayView() : ptr(NULL), len(0) {}
+    ArrayView(const uint8_t *ptr, int len) : ptr(ptr), len(len) {}
+
+    // Number of elements in the array
+    inline int size() const { return len; }
+    inline bool empty() const { return len == 0; }
+
+    // The encoded bytes backing this array (size() * sizeof(T) of them)
+    inline const uint8_t* data() const { return ptr; }
+
+    // Decodes a single element. No bounds checking is performed
+    inline T operator[](int i) const
+    {
+        T v;
+        __zcm_view_decode(ptr + i * sizeof(T), &v, 1, LittleEndian);
+        return v;
+    }
+
+    // Decodes elements [start, start + n) into 'out'.
+    // Returns the number of elements decoded, or <0 if out of range
+    inline int copyTo(T *out, int start, int n) const
+    {
+        if (start < 0 || n < 0 || start > len || n > len - start) return -1;
+        __zcm_view_decode(ptr + start * sizeof(T), out, n, LittleEndian);
+        return n;
+    }
+
+    inline int copyTo(T *out) const { return copyTo(out, 0, len); }
+};
+
+}